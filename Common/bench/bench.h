@@ -0,0 +1,69 @@
+/******************************************************************************
+	BENCHMARK MARKERS HEADER FILE
+
+	This file contains the instrumentation markers of the cycle benchmarks.
+	The firmware is run by tools/benchsim in simavr, which watches the
+	marker register (GPIOR0) and takes the CPU cycle count of each marker:
+
+		BENCH_BEGIN(BENCH_ROBOT_LOOP);
+		...
+		BENCH_END(BENCH_ROBOT_LOOP);
+
+	A marker is one write to GPIOR0, an ldi and an out instruction, so it
+	adds two cycles to the measured code. Markers of different hot paths
+	may nest, e.g. a function inside a loop iteration, a hot path must not
+	nest in itself.
+
+	The markers are compiled only when BENCH_MARKERS is defined (the
+	*_fw_bench targets of CMakeLists.txt), otherwise they are empty and
+	the firmware is not changed by them. Without BENCH_MARKERS the file
+	can be included by host tools for the hot path table.
+
+	A new hot path is added to BENCH_HOT_PATHS, with an id below
+	BENCH_END_FLAG.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Set in the marker value at the end of a hot path
+#define BENCH_END_FLAG 0x80
+
+//Data space address of GPIOR0, where tools/benchsim watches the markers
+#define BENCH_MARKER_ADDRESS 0x3E
+
+//Tracked hot paths: name, id, name in the benchmark results
+#define BENCH_HOT_PATHS(X) \
+	X(BENCH_OUTPUT_BYTE_CREATOR_CREATE,	1, "output_byte_creator_create") \
+	X(BENCH_PRINTOUT_LCD_POS_PUTS,		2, "printout_lcd_pos_puts") \
+	X(BENCH_REMOTE_LOOP,				3, "remote_loop") \
+	X(BENCH_IS_COLLISION_DETECTED,		4, "is_collision_detected") \
+	X(BENCH_ROBOT_LOOP,					5, "robot_loop")
+
+#define BENCH_HOT_PATH_ID(name, id, string) name = id,
+
+enum {
+	BENCH_HOT_PATHS(BENCH_HOT_PATH_ID)
+};
+
+#ifdef BENCH_MARKERS
+#include "../hal/hal.h"
+
+#define BENCH_BEGIN(id)	hal_bench_marker(id)
+#define BENCH_END(id)	hal_bench_marker((id) | BENCH_END_FLAG)
+#else
+#define BENCH_BEGIN(id)
+#define BENCH_END(id)
+#endif
+
+
+
+#endif /* BENCH_H_ */
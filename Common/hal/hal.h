@@ -0,0 +1,163 @@
+/******************************************************************************
+	HARDWARE ABSTRACTION LAYER HEADER FILE
+
+	This file contains the interface between the modules of both firmwares
+	and the ATmega328P peripherals: GPIO, external and pin change
+	interrupts, timers, ADC, USART, TWI, delays and critical sections.
+	Modules include this file instead of the avr-libc headers and do not
+	touch the I/O registers themselves.
+
+	Backends:
+		hal_avr.h	default. Every operation is a macro or a static inline
+					function doing the register access the modules did
+					before, so the firmware compiles to the same code.
+		hal_host.h	when HAL_HOST is defined. The peripherals are simulated
+					in memory by hal_host.c with a simulated clock, so the
+					control logic of both firmwares builds and runs as a
+					native Linux executable.
+
+	Ports are given as the letters B, C and D, pins as bit masks and timers
+	as the numbers 0, 1 and 2, e.g.
+
+		hal_gpio_output(D, (1 << PIND2) | (1 << PIND4));
+		hal_gpio_high(D, 1 << PIND2);
+		hal_timer_set_clock(1, HAL_TIMER_CLOCK_64);
+
+	GPIO
+		hal_gpio_output(port, mask)			pins are outputs
+		hal_gpio_input(port, mask)			pins are inputs
+		hal_gpio_high(port, mask)			output high (pull-up for inputs)
+		hal_gpio_low(port, mask)			output low
+		hal_gpio_read(port, mask)			level of the pins, non zero if
+											any pin is high
+		hal_gpio_latch(port, mask)			output latch (PORTx) of the pins
+
+	Interrupts
+		ISR(vector)							interrupt service routine, the
+											avr-libc vector names
+		hal_interrupts_enable()				sei()
+		hal_interrupts_disable()			cli()
+		hal_interrupts_enabled()			non zero if globally enabled
+		HAL_CRITICAL_SECTION { }			interrupts disabled in the
+											block, the state is restored
+		hal_int1_enable(sense)				INT1 @ PD3, HAL_INT_xxx
+		hal_pcint0_enable(mask)				pin change interrupt for pins
+											of PORTB, the request pending
+											before is cleared
+
+	Timers (n = 0, 1 or 2)
+		hal_timer_set_clock(n, clock)		HAL_TIMER_xxx, stops or starts
+		hal_timer_normal_mode(n)			counts to MAX, outputs off
+		hal_timer0_fast_pwm()				timer 0 fast PWM, non-inverting
+											on OC0A and OC0B
+		hal_timer_count(n)					counting register TCNTn
+		hal_timer_set_count(n, value)
+		hal_timer_set_compare(n, ch, value)	OCRnA or OCRnB, ch = A or B
+		hal_timer_compare(n, ch)
+		hal_timer_overflow_interrupt(n)		enables the overflow interrupt
+		hal_timer_overflow_pending(n)		non zero if TOVn is set
+		hal_timer_clear_overflow(n)
+		hal_timer_compare_interrupt(n, ch)	enables the compare match
+											interrupt TIMERn_COMPch_vect, the
+											request pending before is
+											cleared (simulated for timer 2
+											on the host)
+
+	ADC
+		hal_adc_init()						AVcc reference, prescaler 128,
+											single conversions, no interrupt
+		hal_adc_select(channel)				input channel 0..7
+		hal_adc_left_adjust(on)				1 = 8 bit result in ADCH
+		hal_adc_start()
+		hal_adc_busy()						non zero until the conversion
+											is complete
+		hal_adc_result_8bit()				ADCH
+		hal_adc_result_10bit()				ADC
+
+	USART0, 8 data bits, no parity, 1 stop bit
+		hal_usart_init(ubrr)				transmitter and receiver on
+		hal_usart_rx_interrupt_enable()		USART_RX_vect
+		hal_usart_udre_interrupt(on)		USART_UDRE_vect
+		hal_usart_ready()					non zero if UDR0 is empty
+		hal_usart_received()				non zero if a byte is waiting
+		hal_usart_write(c)
+		hal_usart_read()
+
+	TWI
+		hal_twi_init(twbr)					prescaler 1, bit rate register
+		hal_twi_set_bit_rate(twbr)
+		hal_twi_bit_rate()
+		hal_twi_set_control(bits)			TWCR, e.g. (1 << TWINT) |
+											(1 << TWSTA) | (1 << TWEN)
+		hal_twi_control()					TWCR, to poll TWINT and TWSTO
+		hal_twi_status()					TW_STATUS, the TW_xxx codes
+		hal_twi_write(data)					TWDR
+		hal_twi_read()
+
+	Delays (compile time constants on the AVR, like avr-libc)
+		hal_delay_ms(ms)
+		hal_delay_us(us)
+
+	Benchmark marker (see Common/bench/bench.h)
+		hal_bench_marker(value)				GPIOR0 = value, a single out
+											instruction, ignored on the host
+
+	SRAM (see Common/sram/sram.h)
+		hal_sram_data_start()				first byte of .data
+		hal_sram_heap_start()				first byte after .data and .bss,
+											the stack grows down towards it
+		hal_stack_pointer()					SP, the next byte the stack uses
+
+	Flash (PROGMEM, pgm_read_byte(), memcpy_P(), ...) is used through
+	<avr/pgmspace.h>, the host build puts host/avr/pgmspace.h first in the
+	include path.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef HAL_H_
+#define HAL_H_
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+#include <stdint.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Clock select of timers 0 and 1 (CSn2:0)
+#define HAL_TIMER_STOP			0
+#define HAL_TIMER_CLOCK_1		1
+#define HAL_TIMER_CLOCK_8		2
+#define HAL_TIMER_CLOCK_64		3
+#define HAL_TIMER_CLOCK_256		4
+#define HAL_TIMER_CLOCK_1024	5
+
+//Clock select of timer 2, which has more prescalers (CS22:0)
+#define HAL_TIMER2_CLOCK_64		4
+
+//Sense of INT1 (ISC11:0)
+#define HAL_INT_LOW_LEVEL		0
+#define HAL_INT_ANY_CHANGE		1
+#define HAL_INT_FALLING_EDGE	2
+#define HAL_INT_RISING_EDGE		3
+
+
+
+/******************************************************************************
+	BACKEND
+******************************************************************************/
+#ifdef HAL_HOST
+#include "hal_host.h"
+#else
+#include "hal_avr.h"
+#endif
+
+
+
+#endif /* HAL_H_ */
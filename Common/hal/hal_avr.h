@@ -0,0 +1,217 @@
+/******************************************************************************
+	HARDWARE ABSTRACTION LAYER, AVR BACKEND
+
+	This file contains the ATmega328P implementation of the interface in
+	hal.h. Every operation is the register access it stands for, as a macro
+	(ports and timers are pasted into the register names) or a static inline
+	function, so no code or call is added to the firmware.
+
+	Do not include this file, include hal.h.
+
+	For more information regarding the registers, please refer to
+	Atmel-8271J-AVR- ATmega-Datasheet_11/2015.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef HAL_AVR_H_
+#define HAL_AVR_H_
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <compat/twi.h>
+#include <util/atomic.h>
+#include <util/delay.h>
+
+
+
+/******************************************************************************
+	GPIO
+******************************************************************************/
+#define hal_gpio_output(port, mask)	(DDR##port |= (mask))
+#define hal_gpio_input(port, mask)	(DDR##port &= ~(mask))
+#define hal_gpio_high(port, mask)	(PORT##port |= (mask))
+#define hal_gpio_low(port, mask)	(PORT##port &= ~(mask))
+#define hal_gpio_read(port, mask)	(PIN##port & (mask))
+#define hal_gpio_latch(port, mask)	(PORT##port & (mask))
+
+
+
+/******************************************************************************
+	INTERRUPTS
+******************************************************************************/
+#define hal_interrupts_enable()		sei()
+#define hal_interrupts_disable()	cli()
+#define hal_interrupts_enabled()	(SREG & (1 << SREG_I))
+
+#define HAL_CRITICAL_SECTION		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+
+/******************************************************************************
+	EICRA - External Interrupt Control Register A
+		bit    7	  6      5      4      3      2      1      0
+			[  -  ][  -  ][  -  ][  -  ][ISC11][ISC10][ISC01][ISC00]
+******************************************************************************/
+static inline void hal_int1_enable(uint8_t sense) {
+	EICRA = (EICRA & ~((1 << ISC11) | (1 << ISC10))) | (sense << ISC10);
+	EIMSK |= (1 << INT1);
+}
+
+static inline void hal_pcint0_enable(uint8_t mask) {
+	PCMSK0 |= mask;
+	PCIFR |= (1 << PCIF0);
+	PCICR |= (1 << PCIE0);
+}
+
+
+
+/******************************************************************************
+	TIMERS
+******************************************************************************/
+#define hal_timer_set_clock(n, clock) \
+	(TCCR##n##B = (TCCR##n##B & ~((1 << CS##n##2) | (1 << CS##n##1) | (1 << CS##n##0))) | (clock))
+#define hal_timer_normal_mode(n)			(TCCR##n##A = 0)
+#define hal_timer_count(n)					(TCNT##n)
+#define hal_timer_set_count(n, value)		(TCNT##n = (value))
+#define hal_timer_set_compare(n, ch, value)	(OCR##n##ch = (value))
+#define hal_timer_compare(n, ch)			(OCR##n##ch)
+#define hal_timer_overflow_interrupt(n)		(TIMSK##n |= (1 << TOIE##n))
+#define hal_timer_overflow_pending(n)		(TIFR##n & (1 << TOV##n))
+#define hal_timer_clear_overflow(n)			(TIFR##n |= (1 << TOV##n))
+#define hal_timer_compare_interrupt(n, ch) \
+	(TIFR##n = (1 << OCF##n##ch), TIMSK##n |= (1 << OCIE##n##ch))
+
+static inline void hal_timer0_fast_pwm(void) {
+	//Clear OC0A/OC0B on Compare Match, set at BOTTOM, (non-inverting mode)
+	TCCR0A |= (1 << COM0A1);
+	TCCR0A &= ~(1 << COM0A0);
+	TCCR0A |= (1 << COM0B1);
+	TCCR0A &= ~(1 << COM0B0);
+
+	//Fast PWM, TOP = 0xFF, update of OCRx at BOTTOM, TOV Flag Set on MAX
+	TCCR0B &= ~(1 << WGM02);
+	TCCR0A |= (1 << WGM01);
+	TCCR0A |= (1 << WGM00);
+}
+
+
+
+/******************************************************************************
+	ADC
+	ADMUX - ADC Multiplexer Selection Register
+		bit    7      6      5      4      3      2      1      0
+			[REFS1][REFS0][ADLAR][  -  ][MUX3 ][MUX2 ][MUX1 ][MUX0 ]
+	ADCSRA - ADC Control and Status Register A
+		bit    7      6      5      4      3      2      1      0
+			[ADEN ][ADSC ][ADATE][ADIF ][ADIE ][ADPS2][ADPS1][ADPS0]
+******************************************************************************/
+static inline void hal_adc_init(void) {
+	ADMUX &= ~(1 << REFS1);
+	ADMUX |= (1 << REFS0);
+
+	ADCSRA |= (1 << ADEN);
+	ADCSRA &= ~(1 << ADSC);
+	ADCSRA &= ~(1 << ADATE);
+	ADCSRA &= ~(1 << ADIF);
+	ADCSRA &= ~(1 << ADIE);
+	ADCSRA |= (1 << ADPS2);
+	ADCSRA |= (1 << ADPS1);
+	ADCSRA |= (1 << ADPS0);
+}
+
+static inline void hal_adc_select(uint8_t channel) {
+	ADMUX = (ADMUX & ~((1 << MUX3) | (1 << MUX2) | (1 << MUX1) | (1 << MUX0))) | (channel & 0x07);
+}
+
+static inline void hal_adc_left_adjust(uint8_t on) {
+	if (on) {
+		ADMUX |= (1 << ADLAR);
+	} else {
+		ADMUX &= ~(1 << ADLAR);
+	}
+}
+
+#define hal_adc_start()			(ADCSRA |= (1 << ADSC))
+#define hal_adc_busy()			(ADCSRA & (1 << ADSC))
+#define hal_adc_result_8bit()	(ADCH)
+#define hal_adc_result_10bit()	(ADC)
+
+
+
+/******************************************************************************
+	USART0
+******************************************************************************/
+static inline void hal_usart_init(uint16_t ubrr) {
+	UBRR0H = (ubrr >> 8);
+	UBRR0L = ubrr;
+
+	UCSR0B |= (1 << TXEN0) | (1 << RXEN0);
+
+	UCSR0C |= (1 << UCSZ01) | (1 << UCSZ00);
+	UCSR0C &= ~(1 << UMSEL00) & ~(1 << UPM00) & ~(1 << USBS0);
+}
+
+static inline void hal_usart_udre_interrupt(uint8_t on) {
+	if (on) {
+		UCSR0B |= (1 << UDRIE0);
+	} else {
+		UCSR0B &= ~(1 << UDRIE0);
+	}
+}
+
+#define hal_usart_rx_interrupt_enable()	(UCSR0B |= (1 << RXCIE0))
+#define hal_usart_ready()				(UCSR0A & (1 << UDRE0))
+#define hal_usart_received()			(UCSR0A & (1 << RXC0))
+#define hal_usart_write(c)				(UDR0 = (c))
+#define hal_usart_read()				(UDR0)
+
+
+
+/******************************************************************************
+	TWI
+******************************************************************************/
+static inline void hal_twi_init(uint8_t twbr) {
+	TWSR = 0;
+	TWBR = twbr;
+}
+
+#define hal_twi_set_bit_rate(twbr)	(TWBR = (twbr))
+#define hal_twi_bit_rate()			(TWBR)
+#define hal_twi_set_control(bits)	(TWCR = (bits))
+#define hal_twi_control()			(TWCR)
+#define hal_twi_status()			(TW_STATUS)
+#define hal_twi_write(data)			(TWDR = (data))
+#define hal_twi_read()				(TWDR)
+
+
+
+/******************************************************************************
+	DELAYS
+******************************************************************************/
+#define hal_delay_ms(ms)	_delay_ms(ms)
+#define hal_delay_us(us)	_delay_us(us)
+
+
+
+/******************************************************************************
+	BENCHMARK MARKER
+	GPIOR0 - General Purpose I/O Register 0, not used by the firmwares
+******************************************************************************/
+#define hal_bench_marker(value)	(GPIOR0 = (value))
+
+
+
+/******************************************************************************
+	SRAM
+	Symbols of the avr-libc linker scripts, SP - Stack Pointer
+******************************************************************************/
+extern uint8_t __data_start;
+extern uint8_t __heap_start;
+
+#define hal_sram_data_start()	(&__data_start)
+#define hal_sram_heap_start()	(&__heap_start)
+#define hal_stack_pointer()		((uint8_t *)SP)
+
+
+
+#endif /* HAL_AVR_H_ */
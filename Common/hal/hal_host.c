@@ -0,0 +1,1192 @@
+/******************************************************************************
+	HARDWARE ABSTRACTION LAYER, HOST BACKEND IMPLEMENTATION FILE
+
+	This file contains the simulation of the ATmega328P peripherals behind
+	the host backend of hal.h. See hal_host.h for a description.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "hal.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Simulated cycles of an ADC conversion, 13 ADC clocks at prescaler 128
+#define ADC_CONVERSION_CYCLES (13 * 128)
+
+//Bytes queued for the USART receiver
+#define RX_QUEUE_SIZE 256
+
+//Receive buffer of the AVR, UDR0 and its FIFO, for bytes from the line
+//(lockstep), more are lost (data overrun)
+#define RX_HARDWARE_BUFFER 2
+
+//stdin is read once per simulated millisecond
+#define STDIN_PERIOD_CYCLES (F_CPU / 1000)
+
+//INT1 pin, PD3
+#define INT1_PIN (1 << PD3)
+
+//TWI phases after START
+#define TWI_IDLE	0
+#define TWI_ADDRESS	1
+#define TWI_WRITE	2
+#define TWI_READ	3
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	uint8_t ddr;
+	uint8_t latch;
+	uint8_t input;				//external level of the pins
+} port_t;
+
+typedef struct {
+	uint8_t clock;				//clock select
+	uint8_t fast_pwm;
+	uint16_t count;
+	uint16_t prescale_count;	//cycles towards the next count
+	uint8_t compare[2];
+	uint8_t overflow_interrupt;
+	uint8_t overflow;
+	uint8_t compare_interrupt[2];
+	uint8_t compare_match[2];	//OCFnx
+} host_timer_t;
+
+
+
+/******************************************************************************
+	INTERRUPT VECTORS
+	Defined by the firmware with ISR(), NULL if it does not.
+******************************************************************************/
+void INT1_vect(void) __attribute__((weak));
+void PCINT0_vect(void) __attribute__((weak));
+void TIMER2_COMPB_vect(void) __attribute__((weak));
+void TIMER2_OVF_vect(void) __attribute__((weak));
+void TIMER1_OVF_vect(void) __attribute__((weak));
+void TIMER0_OVF_vect(void) __attribute__((weak));
+void USART_RX_vect(void) __attribute__((weak));
+void USART_UDRE_vect(void) __attribute__((weak));
+void TWI_vect(void) __attribute__((weak));
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+uint8_t hal_host_sram[HAL_HOST_SRAM_FREE];
+
+static uint64_t cycles = 0;
+static uint64_t run_limit = 0;				//0 = no limit
+static uint64_t stdin_polled_at = 0;
+static uint8_t usart_stdio = 0;
+static uint8_t lockstep = 0;
+static uint64_t slice_end = 0;
+static uint8_t syncing = 0;					//in lockstep_sync(), no ISR
+
+static uint8_t interrupts_on = 0;
+static uint8_t in_isr = 0;
+
+static port_t ports[HAL_HOST_PORTS] = {
+	{ 0, 0, 0xFF }, { 0, 0, 0xFF }, { 0, 0, 0xFF }
+};
+static void (*gpio_hook)(uint8_t port) = NULL;
+
+static struct {
+	uint64_t at;
+	void (*event)(void);
+} events[HAL_HOST_EVENTS];
+static uint8_t event_count = 0;
+
+static struct {
+	uint8_t sense;
+	uint8_t enabled;
+	uint8_t requested;
+} int1;
+
+static struct {
+	uint8_t mask;
+	uint8_t enabled;
+	uint8_t requested;
+} pcint0;
+
+static host_timer_t timers[3];
+static uint8_t reported_duty[3][2];			//last 'P' record, lockstep
+static const uint16_t PRESCALERS[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+static const uint16_t PRESCALERS_TIMER2[8] = { 0, 1, 8, 32, 64, 128, 256, 1024 };
+
+static struct {
+	uint8_t channel;
+	uint8_t left_adjust;
+	uint16_t result;
+	uint64_t busy_until;
+	uint16_t input[8];
+} adc = { 0, 0, 0, 0, { 512, 512, 512, 512, 512, 512, 512, 512 } };
+
+static struct {
+	uint8_t enabled;
+	uint8_t rx_interrupt;
+	uint8_t udre_interrupt;
+	uint8_t data;				//last byte read
+	uint8_t queue[RX_QUEUE_SIZE];
+	uint16_t head;
+	uint16_t count;
+	uint32_t transmitted;
+	uint32_t byte_cycles;		//10 bits at the baud rate
+	uint64_t shifting_until;	//transmit shift register busy
+	uint64_t udr_full_until;	//byte waiting in UDR0
+	void (*hook)(uint8_t c);
+} usart;
+
+static struct {
+	uint8_t bit_rate;
+	uint8_t enabled;
+	uint8_t interrupt;
+	uint8_t ack;
+	uint8_t flag;				//TWINT
+	uint8_t status;
+	uint8_t data;
+	uint8_t owned;				//START sent, no STOP yet
+	uint8_t phase;
+	const hal_host_twi_device_t *device;
+	const hal_host_twi_device_t *devices[HAL_HOST_TWI_DEVICES];
+	uint8_t device_count;
+	uint32_t bytes;
+} twi = { .status = TW_NO_INFO };
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static void operation(void);
+static void dispatch(void);
+static void (*take_request(void))(void);
+static void count_timers(uint64_t n);
+static uint64_t cycles_to_overflow(uint8_t timer);
+static uint64_t cycles_to_compare(uint8_t timer, uint8_t channel);
+static uint32_t counts_to_compare(uint8_t timer, uint8_t channel);
+static uint16_t timer_top(uint8_t timer);
+static uint8_t pin_levels(uint8_t port);
+static void pins_changed(uint8_t port, uint8_t before);
+static void poll_stdin(void);
+static void run_events(void);
+static void lockstep_sync(void);
+static void lockstep_record(uint8_t type, const uint8_t *data, uint8_t length);
+static void report_duty(uint8_t timer);
+static void twi_stop(void);
+static const hal_host_twi_device_t *twi_find(uint8_t address);
+static void start(void) __attribute__((constructor));
+static void finish(void);
+
+
+
+/******************************************************************************
+	SIMULATION
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	hal_host_cycles()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+******************************************************************************/
+uint64_t hal_host_cycles(void) {
+	return cycles;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	hal_host_advance()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+
+	Time passes in steps that end at the next timer overflow or compare
+	match with an enabled interrupt or the next event, so every overflow
+	and match is served and every event is called at its time.
+******************************************************************************/
+void hal_host_advance(uint64_t n) {
+	uint64_t step;
+	uint64_t c;
+
+	while (n) {
+		step = n;
+		for (uint8_t i = 0; i < 3; i++) {
+			c = cycles_to_overflow(i);
+			if (c && c < step) {
+				step = c;
+			}
+			for (uint8_t ch = 0; ch < 2; ch++) {
+				c = cycles_to_compare(i, ch);
+				if (c && c < step) {
+					step = c;
+				}
+			}
+		}
+		if (usart_stdio && STDIN_PERIOD_CYCLES < step) {
+			step = STDIN_PERIOD_CYCLES;
+		}
+		for (uint8_t i = 0; i < event_count; i++) {
+			c = events[i].at > cycles ? events[i].at - cycles : 0;
+			if (c < step) {
+				step = c;
+			}
+		}
+		if (usart.udre_interrupt && usart.udr_full_until > cycles &&
+			usart.udr_full_until - cycles < step) {
+			step = usart.udr_full_until - cycles;
+		}
+		if (lockstep && slice_end - cycles < step) {
+			step = slice_end - cycles;
+		}
+
+		count_timers(step);
+		cycles += step;
+		n -= step;
+
+		if (run_limit && cycles >= run_limit) {
+			exit(0);
+		}
+		if (usart_stdio && cycles - stdin_polled_at >= STDIN_PERIOD_CYCLES) {
+			stdin_polled_at = cycles;
+			poll_stdin();
+		}
+		if (lockstep && cycles >= slice_end) {
+			lockstep_sync();
+		}
+		run_events();
+		dispatch();
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	hal_host_gpio_drive()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+******************************************************************************/
+void hal_host_gpio_drive(uint8_t port, uint8_t mask, uint8_t high) {
+	uint8_t before = pin_levels(port);
+
+	if (high) {
+		ports[port].input |= mask;
+	} else {
+		ports[port].input &= ~mask;
+	}
+	pins_changed(port, before);
+	dispatch();
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	hal_host_gpio_set_hook()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+******************************************************************************/
+void hal_host_gpio_set_hook(void (*hook)(uint8_t port)) {
+	gpio_hook = hook;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	hal_host_gpio_levels()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+******************************************************************************/
+uint8_t hal_host_gpio_levels(uint8_t port) {
+	return pin_levels(port);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	hal_host_timer_duty()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+******************************************************************************/
+uint8_t hal_host_timer_duty(uint8_t timer, uint8_t channel) {
+	if (!timers[timer].fast_pwm || !timers[timer].clock) {
+		return 0;
+	}
+	return timers[timer].compare[channel];
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	hal_host_schedule()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+******************************************************************************/
+uint8_t hal_host_schedule(uint64_t n, void (*event)(void)) {
+	if (event_count == HAL_HOST_EVENTS) {
+		return 0;
+	}
+	events[event_count].at = cycles + n;
+	events[event_count].event = event;
+	event_count++;
+	return 1;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	hal_host_adc_set()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+******************************************************************************/
+void hal_host_adc_set(uint8_t channel, uint16_t value) {
+	adc.input[channel & 0x07] = value & 0x3FF;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	hal_host_usart_receive()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+******************************************************************************/
+uint8_t hal_host_usart_receive(uint8_t c) {
+	if (usart.count == RX_QUEUE_SIZE) {
+		return 0;
+	}
+	usart.queue[(usart.head + usart.count) % RX_QUEUE_SIZE] = c;
+	usart.count++;
+	dispatch();
+	return 1;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	hal_host_usart_set_hook()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+******************************************************************************/
+void hal_host_usart_set_hook(void (*hook)(uint8_t c)) {
+	usart.hook = hook;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	hal_host_twi_attach()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+******************************************************************************/
+uint8_t hal_host_twi_attach(const hal_host_twi_device_t *device) {
+	for (uint8_t i = 0; i < twi.device_count; i++) {
+		if (twi.devices[i]->address == device->address) {
+			twi.devices[i] = device;
+			return 1;
+		}
+	}
+	if (twi.device_count == HAL_HOST_TWI_DEVICES) {
+		return 0;
+	}
+	twi.devices[twi.device_count++] = device;
+	return 1;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	GPIO
+******************************************************************************/
+void hal_host_gpio_direction(uint8_t port, uint8_t mask, uint8_t output) {
+	uint8_t before = pin_levels(port);
+
+	if (output) {
+		ports[port].ddr |= mask;
+	} else {
+		ports[port].ddr &= ~mask;
+	}
+	pins_changed(port, before);
+	operation();
+}
+
+void hal_host_gpio_write(uint8_t port, uint8_t mask, uint8_t high) {
+	uint8_t before = pin_levels(port);
+
+	if (high) {
+		ports[port].latch |= mask;
+	} else {
+		ports[port].latch &= ~mask;
+	}
+	pins_changed(port, before);
+	operation();
+}
+
+uint8_t hal_host_gpio_read(uint8_t port) {
+	operation();
+	return pin_levels(port);
+}
+
+uint8_t hal_host_gpio_latch(uint8_t port) {
+	operation();
+	return ports[port].latch;
+}
+
+
+
+/******************************************************************************
+	INTERRUPTS
+******************************************************************************/
+void hal_host_interrupts(uint8_t enable) {
+	interrupts_on = enable;
+	operation();
+}
+
+uint8_t hal_host_interrupts_enabled(void) {
+	operation(); //reading SREG, loops polling it end
+	return interrupts_on;
+}
+
+uint8_t hal_host_disable_interrupts(void) {
+	uint8_t state = interrupts_on;
+
+	interrupts_on = 0;
+	return state;
+}
+
+void hal_host_restore_interrupts(const uint8_t *state) {
+	interrupts_on = *state;
+	dispatch();
+}
+
+void hal_int1_enable(uint8_t sense) {
+	int1.sense = sense;
+	int1.enabled = 1;
+	operation();
+}
+
+void hal_pcint0_enable(uint8_t mask) {
+	pcint0.mask |= mask;
+	pcint0.requested = 0;
+	pcint0.enabled = 1;
+	operation();
+}
+
+
+
+/******************************************************************************
+	TIMERS
+******************************************************************************/
+void hal_host_timer_set_clock(uint8_t timer, uint8_t clock) {
+	timers[timer].clock = clock & 0x07;
+	report_duty(timer);
+	operation();
+}
+
+void hal_host_timer_set_pwm(uint8_t timer, uint8_t fast_pwm) {
+	timers[timer].fast_pwm = fast_pwm;
+	report_duty(timer);
+	operation();
+}
+
+uint16_t hal_host_timer_count(uint8_t timer) {
+	operation();
+	return timers[timer].count;
+}
+
+void hal_host_timer_set_count(uint8_t timer, uint16_t value) {
+	timers[timer].count = value & timer_top(timer);
+	timers[timer].prescale_count = 0;
+	operation();
+}
+
+void hal_host_timer_set_compare(uint8_t timer, uint8_t channel, uint8_t value) {
+	timers[timer].compare[channel] = value;
+	report_duty(timer);
+	operation();
+}
+
+uint8_t hal_host_timer_compare(uint8_t timer, uint8_t channel) {
+	operation();
+	return timers[timer].compare[channel];
+}
+
+void hal_host_timer_overflow_interrupt(uint8_t timer) {
+	timers[timer].overflow_interrupt = 1;
+	operation();
+}
+
+uint8_t hal_host_timer_overflow_pending(uint8_t timer) {
+	operation();
+	return timers[timer].overflow;
+}
+
+void hal_host_timer_clear_overflow(uint8_t timer) {
+	timers[timer].overflow = 0;
+	operation();
+}
+
+void hal_host_timer_compare_interrupt(uint8_t timer, uint8_t channel) {
+	timers[timer].compare_match[channel] = 0;
+	timers[timer].compare_interrupt[channel] = 1;
+	operation();
+}
+
+
+
+/******************************************************************************
+	ADC
+******************************************************************************/
+void hal_adc_init(void) {
+	operation();
+}
+
+void hal_adc_select(uint8_t channel) {
+	adc.channel = channel & 0x07;
+	operation();
+}
+
+void hal_adc_left_adjust(uint8_t on) {
+	adc.left_adjust = on;
+	operation();
+}
+
+void hal_adc_start(void) {
+	adc.result = adc.input[adc.channel];
+	adc.busy_until = cycles + ADC_CONVERSION_CYCLES;
+	operation();
+}
+
+uint8_t hal_adc_busy(void) {
+	operation();
+	return cycles < adc.busy_until;
+}
+
+uint8_t hal_adc_result_8bit(void) {
+	operation();
+	return adc.left_adjust ? adc.result >> 2 : adc.result >> 8;
+}
+
+uint16_t hal_adc_result_10bit(void) {
+	operation();
+	return adc.left_adjust ? adc.result << 6 : adc.result;
+}
+
+
+
+/******************************************************************************
+	USART0
+******************************************************************************/
+void hal_usart_init(uint16_t ubrr) {
+	usart.byte_cycles = 10 * 16 * ((uint32_t)ubrr + 1);
+	usart.enabled = 1;
+	operation();
+}
+
+void hal_usart_rx_interrupt_enable(void) {
+	usart.rx_interrupt = 1;
+	operation();
+}
+
+void hal_usart_udre_interrupt(uint8_t on) {
+	usart.udre_interrupt = on;
+	operation();
+}
+
+uint8_t hal_usart_ready(void) {
+	operation();
+	return cycles >= usart.udr_full_until;
+}
+
+uint8_t hal_usart_received(void) {
+	operation();
+	return usart.count != 0;
+}
+
+/******************************************************************************
+	The byte moves from UDR0 to the shift register when that is free.
+******************************************************************************/
+void hal_usart_write(uint8_t c) {
+	if (usart.enabled) {
+		usart.udr_full_until = cycles > usart.shifting_until ? cycles : usart.shifting_until;
+		usart.shifting_until = usart.udr_full_until + usart.byte_cycles;
+		usart.transmitted++;
+		if (usart.hook) {
+			usart.hook(c);
+		} else if (lockstep) {
+			lockstep_record(HAL_HOST_LOCKSTEP_USART, &c, 1);
+		} else if (usart_stdio) {
+			if (write(STDOUT_FILENO, &c, 1) != 1) {
+				usart_stdio = 0;
+			}
+		}
+	}
+	operation();
+}
+
+uint8_t hal_usart_read(void) {
+	if (usart.count) {
+		usart.data = usart.queue[usart.head];
+		usart.head = (usart.head + 1) % RX_QUEUE_SIZE;
+		usart.count--;
+	}
+	operation();
+	return usart.data;
+}
+
+
+
+/******************************************************************************
+	TWI
+	Every operation started by writing TWINT completes at once, the status
+	is the one the AVR has after the operation.
+******************************************************************************/
+void hal_twi_init(uint8_t twbr) {
+	twi.bit_rate = twbr;
+	operation();
+}
+
+void hal_twi_set_bit_rate(uint8_t twbr) {
+	twi.bit_rate = twbr;
+	operation();
+}
+
+uint8_t hal_twi_bit_rate(void) {
+	operation();
+	return twi.bit_rate;
+}
+
+void hal_twi_set_control(uint8_t bits) {
+	const hal_host_twi_device_t *device;
+	uint8_t reading;
+
+	twi.enabled = (bits >> TWEN) & 1;
+	twi.interrupt = (bits >> TWIE) & 1;
+	twi.ack = (bits >> TWEA) & 1;
+
+	if (!twi.enabled) {
+		twi_stop();
+		twi.flag = 0;
+		twi.status = TW_NO_INFO;
+	} else if (bits & (1 << TWINT)) {
+		twi.flag = 0;
+		if (bits & (1 << TWSTO)) {
+			twi_stop();
+			twi.status = TW_NO_INFO;
+		}
+		if (bits & (1 << TWSTA)) {
+			if (twi.device && twi.device->stop) {
+				twi.device->stop();
+			}
+			twi.device = NULL;
+			twi.status = twi.owned ? TW_REP_START : TW_START;
+			twi.owned = 1;
+			twi.phase = TWI_ADDRESS;
+			twi.flag = 1;
+		} else if (!(bits & (1 << TWSTO))) {
+			switch (twi.phase) {
+				case TWI_ADDRESS:
+					reading = twi.data & TW_READ;
+					device = twi_find(twi.data >> 1);
+					if (device) {
+						twi.device = device;
+						twi.phase = reading ? TWI_READ : TWI_WRITE;
+						if (device->start) {
+							device->start(reading);
+						}
+						twi.status = reading ? TW_MR_SLA_ACK : TW_MT_SLA_ACK;
+					} else {
+						twi.phase = TWI_IDLE;
+						twi.status = reading ? TW_MR_SLA_NACK : TW_MT_SLA_NACK;
+					}
+					break;
+				case TWI_WRITE:
+					twi.bytes++;
+					twi.status = twi.device->write(twi.data) ? TW_MT_DATA_ACK : TW_MT_DATA_NACK;
+					break;
+				case TWI_READ:
+					twi.bytes++;
+					twi.data = twi.device->read ? twi.device->read() : 0xFF;
+					twi.status = twi.ack ? TW_MR_DATA_ACK : TW_MR_DATA_NACK;
+					break;
+				default:
+					twi.status = TW_BUS_ERROR;
+					break;
+			}
+			twi.flag = 1;
+		}
+	}
+	operation();
+}
+
+uint8_t hal_twi_control(void) {
+	operation();
+	return (twi.flag << TWINT) | (twi.ack << TWEA) | (twi.enabled << TWEN) | (twi.interrupt << TWIE);
+}
+
+uint8_t hal_twi_status(void) {
+	operation();
+	return twi.status;
+}
+
+void hal_twi_write(uint8_t data) {
+	twi.data = data;
+	operation();
+}
+
+uint8_t hal_twi_read(void) {
+	operation();
+	return twi.data;
+}
+
+
+
+/******************************************************************************
+	DELAYS
+******************************************************************************/
+void hal_host_delay_us(double us) {
+	hal_host_advance((uint64_t)(us * (F_CPU / 1000000.0) + 0.5));
+}
+
+
+
+/******************************************************************************
+	STANDARD LIBRARY, the avr-libc extensions declared in host/stdlib.h
+******************************************************************************/
+char *ultoa(unsigned long value, char *s, int radix) {
+	char digits[8 * sizeof(long) + 1];
+	uint8_t n = 0;
+	uint8_t i = 0;
+
+	do {
+		uint8_t digit = value % radix;
+		digits[n++] = digit < 10 ? '0' + digit : 'a' + digit - 10;
+		value /= radix;
+	} while (value);
+
+	while (n) {
+		s[i++] = digits[--n];
+	}
+	s[i] = '\0';
+	return s;
+}
+
+char *ltoa(long value, char *s, int radix) {
+	if (value < 0 && radix == 10) {
+		s[0] = '-';
+		ultoa(-(unsigned long)value, s + 1, radix);
+		return s;
+	}
+	return ultoa((unsigned long)value, s, radix);
+}
+
+char *utoa(unsigned int value, char *s, int radix) {
+	return ultoa(value, s, radix);
+}
+
+char *itoa(int value, char *s, int radix) {
+	if (radix != 10) {
+		return ultoa((unsigned int)value, s, radix);
+	}
+	return ltoa(value, s, radix);
+}
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	The cost of one HAL operation.
+******************************************************************************/
+static void operation(void) {
+	hal_host_advance(HAL_HOST_ACCESS_CYCLES);
+}
+
+/******************************************************************************
+	Serves the pending interrupt requests with interrupts disabled, until
+	none is left. Nothing is done inside an interrupt service routine.
+******************************************************************************/
+static void dispatch(void) {
+	void (*vector)(void);
+
+	if (in_isr || syncing) {
+		return;
+	}
+	while (interrupts_on && (vector = take_request()) != NULL) {
+		interrupts_on = 0;
+		in_isr = 1;
+		vector();
+		in_isr = 0;
+		interrupts_on = 1;
+	}
+}
+
+/******************************************************************************
+	Returns the vector of the pending request with the highest priority and
+	clears the flags the AVR clears when the vector is executed. A request
+	without a vector is disabled, the AVR would restart.
+******************************************************************************/
+static void (*take_request(void))(void) {
+	void (*vector)(void) = NULL;
+	uint8_t *disable = NULL;
+
+	if (int1.enabled && (int1.requested ||
+		(int1.sense == HAL_INT_LOW_LEVEL && !(pin_levels(HAL_HOST_PORT_D) & INT1_PIN)))) {
+		int1.requested = 0;
+		vector = INT1_vect;
+		disable = &int1.enabled;
+	} else if (pcint0.enabled && pcint0.requested) {
+		pcint0.requested = 0;
+		vector = PCINT0_vect;
+		disable = &pcint0.enabled;
+	} else if (timers[2].compare_interrupt[HAL_HOST_CHANNEL_B] &&
+			   timers[2].compare_match[HAL_HOST_CHANNEL_B]) {
+		timers[2].compare_match[HAL_HOST_CHANNEL_B] = 0;
+		vector = TIMER2_COMPB_vect;
+		disable = &timers[2].compare_interrupt[HAL_HOST_CHANNEL_B];
+	} else if (timers[2].overflow_interrupt && timers[2].overflow) {
+		timers[2].overflow = 0;
+		vector = TIMER2_OVF_vect;
+		disable = &timers[2].overflow_interrupt;
+	} else if (timers[1].overflow_interrupt && timers[1].overflow) {
+		timers[1].overflow = 0;
+		vector = TIMER1_OVF_vect;
+		disable = &timers[1].overflow_interrupt;
+	} else if (timers[0].overflow_interrupt && timers[0].overflow) {
+		timers[0].overflow = 0;
+		vector = TIMER0_OVF_vect;
+		disable = &timers[0].overflow_interrupt;
+	} else if (usart.rx_interrupt && usart.count) {
+		vector = USART_RX_vect;
+		disable = &usart.rx_interrupt;
+	} else if (usart.udre_interrupt && cycles >= usart.udr_full_until) {
+		vector = USART_UDRE_vect;
+		disable = &usart.udre_interrupt;
+	} else if (twi.enabled && twi.interrupt && twi.flag) {
+		vector = TWI_vect;
+		disable = &twi.interrupt;
+	} else {
+		return NULL;
+	}
+
+	if (!vector) {
+		fprintf(stderr, "hal_host: interrupt without ISR() disabled\n");
+		*disable = 0;
+		return take_request();
+	}
+	return vector;
+}
+
+/******************************************************************************
+	Counts the running timers n cycles on.
+******************************************************************************/
+static void count_timers(uint64_t n) {
+	uint16_t prescaler;
+	uint64_t counts;
+	uint32_t top;
+
+	for (uint8_t i = 0; i < 3; i++) {
+		prescaler = (i == 2 ? PRESCALERS_TIMER2 : PRESCALERS)[timers[i].clock];
+		if (!prescaler) {
+			continue;
+		}
+		counts = (timers[i].prescale_count + n) / prescaler;
+		timers[i].prescale_count = (timers[i].prescale_count + n) % prescaler;
+		top = timer_top(i);
+		if (timers[i].count + counts > top) {
+			timers[i].overflow = 1;
+		}
+		for (uint8_t ch = 0; ch < 2; ch++) {
+			if (counts >= counts_to_compare(i, ch)) {
+				timers[i].compare_match[ch] = 1;
+			}
+		}
+		timers[i].count = (timers[i].count + counts) % (top + 1);
+	}
+}
+
+/******************************************************************************
+	Returns the cycles until a timer with the overflow interrupt enabled
+	overflows, 0 if it does not run or its request is pending.
+******************************************************************************/
+static uint64_t cycles_to_overflow(uint8_t timer) {
+	uint16_t prescaler = (timer == 2 ? PRESCALERS_TIMER2 : PRESCALERS)[timers[timer].clock];
+
+	if (!prescaler || !timers[timer].overflow_interrupt || timers[timer].overflow) {
+		return 0;
+	}
+	return (uint64_t)(timer_top(timer) + 1 - timers[timer].count) * prescaler
+		   - timers[timer].prescale_count;
+}
+
+/******************************************************************************
+	Returns the cycles until a timer with the compare match interrupt
+	enabled matches, 0 if it does not run or its request is pending.
+******************************************************************************/
+static uint64_t cycles_to_compare(uint8_t timer, uint8_t channel) {
+	uint16_t prescaler = (timer == 2 ? PRESCALERS_TIMER2 : PRESCALERS)[timers[timer].clock];
+
+	if (!prescaler || !timers[timer].compare_interrupt[channel] ||
+		timers[timer].compare_match[channel]) {
+		return 0;
+	}
+	return (uint64_t)counts_to_compare(timer, channel) * prescaler - timers[timer].prescale_count;
+}
+
+/******************************************************************************
+	Returns the counts until the counter reaches the compare value, a
+	whole turn if it is there.
+******************************************************************************/
+static uint32_t counts_to_compare(uint8_t timer, uint8_t channel) {
+	uint32_t turn = (uint32_t)timer_top(timer) + 1;
+
+	return (timers[timer].compare[channel] + turn - timers[timer].count - 1) % turn + 1;
+}
+
+static uint16_t timer_top(uint8_t timer) {
+	return timer == 1 ? 0xFFFF : 0xFF;
+}
+
+/******************************************************************************
+	Level of the pins of a port: the latch for outputs, the external level
+	for inputs.
+******************************************************************************/
+static uint8_t pin_levels(uint8_t port) {
+	return (ports[port].ddr & ports[port].latch) | (~ports[port].ddr & ports[port].input);
+}
+
+/******************************************************************************
+	Requests INT1 and PCINT0 for the pins that changed and calls the GPIO
+	hook.
+******************************************************************************/
+static void pins_changed(uint8_t port, uint8_t before) {
+	uint8_t after = pin_levels(port);
+	uint8_t changed = before ^ after;
+
+	if (port == HAL_HOST_PORT_D && int1.enabled && (changed & INT1_PIN)) {
+		switch (int1.sense) {
+			case HAL_INT_ANY_CHANGE:
+				int1.requested = 1;
+				break;
+			case HAL_INT_FALLING_EDGE:
+				int1.requested |= !(after & INT1_PIN);
+				break;
+			case HAL_INT_RISING_EDGE:
+				int1.requested |= (after & INT1_PIN) != 0;
+				break;
+		}
+	}
+	if (port == HAL_HOST_PORT_B && (changed & pcint0.mask)) {
+		pcint0.requested = 1;
+	}
+	if (gpio_hook) {
+		gpio_hook(port);
+	}
+}
+
+/******************************************************************************
+	Queues the bytes waiting on stdin for the USART receiver.
+******************************************************************************/
+static void poll_stdin(void) {
+	uint8_t buffer[64];
+	ssize_t n;
+	uint16_t space = RX_QUEUE_SIZE - usart.count;
+
+	if (!space) {
+		return;
+	}
+	n = read(STDIN_FILENO, buffer, space < sizeof(buffer) ? space : sizeof(buffer));
+	for (ssize_t i = 0; i < n; i++) {
+		hal_host_usart_receive(buffer[i]);
+	}
+}
+
+/******************************************************************************
+	Calls the events that are due, the earliest first. An event is removed
+	before it is called, so it can schedule itself again.
+******************************************************************************/
+static void run_events(void) {
+	void (*event)(void);
+	uint8_t first;
+
+	while (event_count) {
+		first = 0;
+		for (uint8_t i = 1; i < event_count; i++) {
+			if (events[i].at < events[first].at) {
+				first = i;
+			}
+		}
+		if (events[first].at > cycles) {
+			return;
+		}
+		event = events[first].event;
+		events[first] = events[--event_count];
+		event();
+	}
+}
+
+/******************************************************************************
+	End of a lockstep slice: reports it and takes the records up to the
+	next slice. The first call, at the first operation, waits for the
+	first slice. The interrupts the records request are served after the
+	next slice is set: an ISR takes time, which would end the old slice
+	again within this one and take the records of the next.
+******************************************************************************/
+static void lockstep_sync(void) {
+	int type;
+	uint8_t data[4];
+
+	syncing = 1;
+	putchar(HAL_HOST_LOCKSTEP_DONE);
+	fflush(stdout);
+
+	while ((type = getchar()) != EOF) {
+		switch (type) {
+			case HAL_HOST_LOCKSTEP_RUN:
+				if (fread(data, 1, 4, stdin) != 4) {
+					exit(0);
+				}
+				slice_end = cycles + (data[0] | (data[1] << 8) | ((uint32_t)data[2] << 16) |
+									  ((uint32_t)data[3] << 24));
+				syncing = 0;				//the caller dispatches
+				return;
+			case HAL_HOST_LOCKSTEP_USART:
+				if (fread(data, 1, 1, stdin) == 1 && usart.count < RX_HARDWARE_BUFFER) {
+					hal_host_usart_receive(data[0]);
+				}
+				break;
+			case HAL_HOST_LOCKSTEP_ADC:
+				if (fread(data, 1, 3, stdin) == 3) {
+					hal_host_adc_set(data[0], data[1] | (data[2] << 8));
+				}
+				break;
+			case HAL_HOST_LOCKSTEP_GPIO:
+				if (fread(data, 1, 3, stdin) == 3 && data[0] < HAL_HOST_PORTS) {
+					hal_host_gpio_drive(data[0], data[1], data[2]);
+				}
+				break;
+			default:
+				fprintf(stderr, "hal_host: unknown lockstep record 0x%02X\n", type);
+				break;
+		}
+	}
+	exit(0);
+}
+
+/******************************************************************************
+	Writes a record with the current cycles to stdout, sent with the next
+	'D'.
+******************************************************************************/
+static void lockstep_record(uint8_t type, const uint8_t *data, uint8_t length) {
+	putchar(type);
+	for (uint8_t i = 0; i < 8; i++) {
+		putchar((cycles >> (8 * i)) & 0xFF);
+	}
+	fwrite(data, 1, length, stdout);
+}
+
+/******************************************************************************
+	Reports the PWM channels of a timer whose duty changed, lockstep only.
+******************************************************************************/
+static void report_duty(uint8_t timer) {
+	uint8_t data[3];
+
+	if (!lockstep) {
+		return;
+	}
+	for (uint8_t channel = 0; channel < 2; channel++) {
+		data[2] = hal_host_timer_duty(timer, channel);
+		if (data[2] != reported_duty[timer][channel]) {
+			reported_duty[timer][channel] = data[2];
+			data[0] = timer;
+			data[1] = channel;
+			lockstep_record(HAL_HOST_LOCKSTEP_PWM, data, 3);
+		}
+	}
+}
+
+/******************************************************************************
+	STOP condition, the addressed device is told and the bus is free.
+******************************************************************************/
+static void twi_stop(void) {
+	if (twi.device && twi.device->stop) {
+		twi.device->stop();
+	}
+	twi.device = NULL;
+	twi.owned = 0;
+	twi.phase = TWI_IDLE;
+}
+
+static const hal_host_twi_device_t *twi_find(uint8_t address) {
+	for (uint8_t i = 0; i < twi.device_count; i++) {
+		if (twi.devices[i]->address == address) {
+			return twi.devices[i];
+		}
+	}
+	return NULL;
+}
+
+/******************************************************************************
+	Runs before the firmware's main(): reads the settings from the
+	environment and attaches the device models.
+******************************************************************************/
+static void start(void) {
+	const char *setting;
+
+	setting = getenv("HAL_HOST_RUN_MS");
+	if (setting) {
+		run_limit = strtoull(setting, NULL, 10) * (F_CPU / 1000);
+		atexit(finish);
+	}
+	if (getenv("HAL_HOST_LOCKSTEP")) {
+		lockstep = 1;
+	} else if (getenv("HAL_HOST_USART_STDIO")) {
+		usart_stdio = 1;
+		fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+	}
+	hal_host_devices_attach();
+}
+
+/******************************************************************************
+	Prints what the run did when it ends at HAL_HOST_RUN_MS.
+******************************************************************************/
+static void finish(void) {
+	fflush(stdout);							//what the firmware printed first
+	fprintf(stderr, "hal_host: %llu ms simulated, %lu USART bytes sent, %lu TWI bytes\n",
+			(unsigned long long)(cycles / (F_CPU / 1000)),
+			(unsigned long)usart.transmitted, (unsigned long)twi.bytes);
+}
+/*****************************************************************************/
@@ -0,0 +1,455 @@
+/******************************************************************************
+	HARDWARE ABSTRACTION LAYER, HOST BACKEND
+
+	This file contains the host implementation of the interface in hal.h
+	and the interface of the simulation behind it, hal_host.c.
+
+	The peripherals are simulated in memory and driven by a simulated CPU
+	clock of F_CPU. The clock advances by HAL_HOST_ACCESS_CYCLES on every
+	HAL operation and by the requested time in the delays, so polling loops
+	and timeouts end as on the AVR. Timers count with the clock and set
+	their overflow and compare match flags. Interrupt service routines are called in the
+	priority order of the vector table whenever a request is pending and
+	interrupts are enabled, never nested.
+
+	Simplifications:
+		- TWI transfers take no simulated time, a TWI operation completes
+		  (TWINT) in the call that starts it.
+		- The USART transmitter is busy for 10 bit times of the baud rate
+		  of hal_usart_init() per byte, UDRE follows the data register
+		  like on the AVR. A byte written is handed to the transmit hook
+		  at once.
+		- Bytes for the USART receiver are given by
+		  hal_host_usart_receive(), or read from stdin when
+		  HAL_HOST_USART_STDIO is set in the environment. The transmitted
+		  bytes then go to stdout.
+		- With HAL_HOST_LOCKSTEP set in the environment the simulation is
+		  run in slices by another program over stdin and stdout, see
+		  LOCKSTEP below and tools/linkemu.
+		- The TWI bus has the devices attached with hal_host_twi_attach()
+		  and the models in hal_host_devices.c, an SH1106 OLED at 0x3C and
+		  an MPU6050 at 0x68. Other addresses are not acknowledged.
+		- Pins that are inputs read the level given by hal_host_gpio_drive(),
+		  high by default (pull-ups). Output pins read their latch.
+		- The simulation ends the process after HAL_HOST_RUN_MS simulated
+		  milliseconds when that is set in the environment.
+		- Hardware around the board (sensors, motors) is modelled by the
+		  program with the hooks below and events at simulated times,
+		  hal_host_schedule(), see tools/robotsim.
+		- The SRAM between .bss and the stack is an array of
+		  HAL_HOST_SRAM_FREE bytes that nothing uses, the firmware runs on
+		  the host stack. .data and .bss are empty.
+
+	Do not include this file, include hal.h.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef HAL_HOST_H_
+#define HAL_HOST_H_
+
+#include <stdint.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Simulated CPU cycles of one HAL operation
+#define HAL_HOST_ACCESS_CYCLES 2
+
+//Bytes between .bss and the stack
+#define HAL_HOST_SRAM_FREE 1024
+
+//Ports and timer channels
+#define HAL_HOST_PORT_B		0
+#define HAL_HOST_PORT_C		1
+#define HAL_HOST_PORT_D		2
+#define HAL_HOST_PORTS		3
+
+#define HAL_HOST_CHANNEL_A	0
+#define HAL_HOST_CHANNEL_B	1
+
+//Pin numbers of avr/io.h used by the modules
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PC6 6
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+#define PORTB0 0
+#define PORTB1 1
+#define PORTB2 2
+#define PORTB3 3
+#define PORTB4 4
+#define PORTB5 5
+#define PORTB6 6
+#define PORTB7 7
+#define PORTC0 0
+#define PORTC1 1
+#define PORTC2 2
+#define PORTC3 3
+#define PORTC4 4
+#define PORTC5 5
+#define PORTC6 6
+#define PORTD0 0
+#define PORTD1 1
+#define PORTD2 2
+#define PORTD3 3
+#define PORTD4 4
+#define PORTD5 5
+#define PORTD6 6
+#define PORTD7 7
+#define PINB0 0
+#define PINB1 1
+#define PINB2 2
+#define PINB3 3
+#define PINB4 4
+#define PINB5 5
+#define PINB6 6
+#define PINB7 7
+#define PINC0 0
+#define PINC1 1
+#define PINC2 2
+#define PINC3 3
+#define PINC4 4
+#define PINC5 5
+#define PINC6 6
+#define PIND0 0
+#define PIND1 1
+#define PIND2 2
+#define PIND3 3
+#define PIND4 4
+#define PIND5 5
+#define PIND6 6
+#define PIND7 7
+
+//TWCR bits
+#define TWINT	7
+#define TWEA	6
+#define TWSTA	5
+#define TWSTO	4
+#define TWWC	3
+#define TWEN	2
+#define TWIE	0
+
+//TWI status codes of compat/twi.h
+#define TW_START			0x08
+#define TW_REP_START		0x10
+#define TW_MT_SLA_ACK		0x18
+#define TW_MT_SLA_NACK		0x20
+#define TW_MT_DATA_ACK		0x28
+#define TW_MT_DATA_NACK		0x30
+#define TW_MT_ARB_LOST		0x38
+#define TW_MR_ARB_LOST		0x38
+#define TW_MR_SLA_ACK		0x40
+#define TW_MR_SLA_NACK		0x48
+#define TW_MR_DATA_ACK		0x50
+#define TW_MR_DATA_NACK		0x58
+#define TW_NO_INFO			0xF8
+#define TW_BUS_ERROR		0x00
+#define TW_STATUS_MASK		0xF8
+#define TW_READ				1
+#define TW_WRITE			0
+
+//Interrupt service routines are plain functions, called by the simulation
+#define ISR(vector) void vector(void)
+
+
+
+/******************************************************************************
+	LOCKSTEP
+	Records on stdin and stdout with HAL_HOST_LOCKSTEP, multi-byte values
+	are little-endian:
+
+	To the simulation:
+		'T', cycles (4)				run a slice of cycles, then send 'D'
+		'U', byte					byte for the USART receiver, lost if
+									the receive buffer of the AVR (2
+									bytes) is full
+		'A', channel, value (2)		ADC input, like hal_host_adc_set()
+		'G', port, mask, level		input pins, like hal_host_gpio_drive()
+	The simulation ends at the end of stdin.
+
+	From the simulation:
+		'D'							slice done, waiting for the next
+		'U', cycles (8), byte		byte transmitted by the USART
+		'P', cycles (8), timer, channel, duty
+									PWM duty changed, see
+									hal_host_timer_duty()
+	The simulation sends 'D' at its first HAL operation, before the first
+	slice.
+******************************************************************************/
+#define HAL_HOST_LOCKSTEP_RUN		'T'
+#define HAL_HOST_LOCKSTEP_USART		'U'
+#define HAL_HOST_LOCKSTEP_ADC		'A'
+#define HAL_HOST_LOCKSTEP_GPIO		'G'
+#define HAL_HOST_LOCKSTEP_DONE		'D'
+#define HAL_HOST_LOCKSTEP_PWM		'P'
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+//TWI device on the simulated bus. start() is called when the device is
+//addressed, write() returns 1 to acknowledge a byte, read() is called for
+//every byte the master reads and stop() at a STOP or repeated START.
+typedef struct {
+	uint8_t address;
+	void (*start)(uint8_t reading);
+	uint8_t (*write)(uint8_t data);
+	uint8_t (*read)(void);
+	void (*stop)(void);
+} hal_host_twi_device_t;
+
+
+
+/******************************************************************************
+	HAL OPERATIONS
+******************************************************************************/
+#define hal_gpio_output(port, mask)	hal_host_gpio_direction(HAL_HOST_PORT_##port, (mask), 1)
+#define hal_gpio_input(port, mask)	hal_host_gpio_direction(HAL_HOST_PORT_##port, (mask), 0)
+#define hal_gpio_high(port, mask)	hal_host_gpio_write(HAL_HOST_PORT_##port, (mask), 1)
+#define hal_gpio_low(port, mask)	hal_host_gpio_write(HAL_HOST_PORT_##port, (mask), 0)
+#define hal_gpio_read(port, mask)	(hal_host_gpio_read(HAL_HOST_PORT_##port) & (mask))
+#define hal_gpio_latch(port, mask)	(hal_host_gpio_latch(HAL_HOST_PORT_##port) & (mask))
+
+#define hal_interrupts_enable()		hal_host_interrupts(1)
+#define hal_interrupts_disable()	hal_host_interrupts(0)
+#define hal_interrupts_enabled()	hal_host_interrupts_enabled()
+
+#define HAL_CRITICAL_SECTION \
+	for (uint8_t hal_host_state __attribute__((__cleanup__(hal_host_restore_interrupts))) = \
+		 hal_host_disable_interrupts(), hal_host_once = 1; hal_host_once; hal_host_once = 0)
+
+#define hal_timer_set_clock(n, clock)		hal_host_timer_set_clock((n), (clock))
+#define hal_timer_normal_mode(n)			hal_host_timer_set_pwm((n), 0)
+#define hal_timer0_fast_pwm()				hal_host_timer_set_pwm(0, 1)
+#define hal_timer_count(n)					hal_host_timer_count(n)
+#define hal_timer_set_count(n, value)		hal_host_timer_set_count((n), (value))
+#define hal_timer_set_compare(n, ch, value)	hal_host_timer_set_compare((n), HAL_HOST_CHANNEL_##ch, (value))
+#define hal_timer_compare(n, ch)			hal_host_timer_compare((n), HAL_HOST_CHANNEL_##ch)
+#define hal_timer_overflow_interrupt(n)		hal_host_timer_overflow_interrupt(n)
+#define hal_timer_overflow_pending(n)		hal_host_timer_overflow_pending(n)
+#define hal_timer_clear_overflow(n)			hal_host_timer_clear_overflow(n)
+#define hal_timer_compare_interrupt(n, ch)	hal_host_timer_compare_interrupt((n), HAL_HOST_CHANNEL_##ch)
+
+#define hal_delay_ms(ms)	hal_host_delay_us((ms) * 1000.0)
+#define hal_delay_us(us)	hal_host_delay_us(us)
+
+#define hal_bench_marker(value)	((void)(value))
+
+#define hal_sram_data_start()	hal_host_sram
+#define hal_sram_heap_start()	hal_host_sram
+#define hal_stack_pointer()		(hal_host_sram + HAL_HOST_SRAM_FREE)
+
+void hal_host_gpio_direction(uint8_t port, uint8_t mask, uint8_t output);
+void hal_host_gpio_write(uint8_t port, uint8_t mask, uint8_t high);
+uint8_t hal_host_gpio_read(uint8_t port);
+uint8_t hal_host_gpio_latch(uint8_t port);
+
+void hal_host_interrupts(uint8_t enable);
+uint8_t hal_host_interrupts_enabled(void);
+uint8_t hal_host_disable_interrupts(void);
+void hal_host_restore_interrupts(const uint8_t *state);
+void hal_int1_enable(uint8_t sense);
+void hal_pcint0_enable(uint8_t mask);
+
+void hal_host_timer_set_clock(uint8_t timer, uint8_t clock);
+void hal_host_timer_set_pwm(uint8_t timer, uint8_t fast_pwm);
+uint16_t hal_host_timer_count(uint8_t timer);
+void hal_host_timer_set_count(uint8_t timer, uint16_t value);
+void hal_host_timer_set_compare(uint8_t timer, uint8_t channel, uint8_t value);
+uint8_t hal_host_timer_compare(uint8_t timer, uint8_t channel);
+void hal_host_timer_overflow_interrupt(uint8_t timer);
+uint8_t hal_host_timer_overflow_pending(uint8_t timer);
+void hal_host_timer_clear_overflow(uint8_t timer);
+void hal_host_timer_compare_interrupt(uint8_t timer, uint8_t channel);
+
+void hal_adc_init(void);
+void hal_adc_select(uint8_t channel);
+void hal_adc_left_adjust(uint8_t on);
+void hal_adc_start(void);
+uint8_t hal_adc_busy(void);
+uint8_t hal_adc_result_8bit(void);
+uint16_t hal_adc_result_10bit(void);
+
+void hal_usart_init(uint16_t ubrr);
+void hal_usart_rx_interrupt_enable(void);
+void hal_usart_udre_interrupt(uint8_t on);
+uint8_t hal_usart_ready(void);
+uint8_t hal_usart_received(void);
+void hal_usart_write(uint8_t c);
+uint8_t hal_usart_read(void);
+
+void hal_twi_init(uint8_t twbr);
+void hal_twi_set_bit_rate(uint8_t twbr);
+uint8_t hal_twi_bit_rate(void);
+void hal_twi_set_control(uint8_t bits);
+uint8_t hal_twi_control(void);
+uint8_t hal_twi_status(void);
+void hal_twi_write(uint8_t data);
+uint8_t hal_twi_read(void);
+
+void hal_host_delay_us(double us);
+
+extern uint8_t hal_host_sram[HAL_HOST_SRAM_FREE];
+
+
+
+/******************************************************************************
+	SIMULATION
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	hal_host_cycles()
+
+	Returns the simulated CPU cycles since the start.
+******************************************************************************/
+uint64_t hal_host_cycles(void);
+
+/******************************************************************************
+	Function name:	hal_host_advance()
+
+	Lets simulated time pass, as if the CPU executed cycles cycles. Timer
+	overflows are counted and interrupts are served on the way.
+******************************************************************************/
+void hal_host_advance(uint64_t cycles);
+
+/******************************************************************************
+	Function name:	hal_host_gpio_drive()
+
+	Sets the external level of input pins, e.g. a button or an echo signal.
+	Pin changes request INT1 and PCINT0 as set up.
+
+	Inputs:		uint8_t port, HAL_HOST_PORT_x
+				uint8_t mask
+				uint8_t high, 1 = high, 0 = low
+******************************************************************************/
+void hal_host_gpio_drive(uint8_t port, uint8_t mask, uint8_t high);
+
+/******************************************************************************
+	Function name:	hal_host_gpio_set_hook()
+
+	Sets a function called after the firmware has changed the direction or
+	latch of pins of a port, e.g. to model the HC-SR04 trigger or a motor
+	driver. NULL removes it.
+******************************************************************************/
+void hal_host_gpio_set_hook(void (*hook)(uint8_t port));
+
+/******************************************************************************
+	Function name:	hal_host_gpio_levels()
+
+	Returns the levels of the pins of a port, like PINx, without simulated
+	time passing. For models, the firmware uses hal_gpio_read().
+******************************************************************************/
+uint8_t hal_host_gpio_levels(uint8_t port);
+
+/******************************************************************************
+	Function name:	hal_host_timer_duty()
+
+	Returns the duty cycle of a PWM output, 0..255, without simulated time
+	passing: the compare value while the timer runs in fast PWM mode, else
+	0.
+
+	Inputs:		uint8_t timer
+				uint8_t channel, HAL_HOST_CHANNEL_x
+******************************************************************************/
+uint8_t hal_host_timer_duty(uint8_t timer, uint8_t channel);
+
+/******************************************************************************
+	Function name:	hal_host_schedule()
+
+	Calls event once after cycles simulated cycles. Events are called in
+	the order of their time, before the interrupts due at the same time,
+	and may drive pins, queue USART bytes and schedule events.
+
+	Outputs:	uint8_t, 0 if HAL_HOST_EVENTS are scheduled already
+******************************************************************************/
+#define HAL_HOST_EVENTS 16
+uint8_t hal_host_schedule(uint64_t cycles, void (*event)(void));
+
+/******************************************************************************
+	Function name:	hal_host_adc_set()
+
+	Sets the 10 bit value converted for an ADC channel, 512 by default.
+******************************************************************************/
+void hal_host_adc_set(uint8_t channel, uint16_t value);
+
+/******************************************************************************
+	Function name:	hal_host_usart_receive()
+
+	Queues a byte for the USART receiver. It is in UDR0 as soon as the
+	bytes before it have been read.
+
+	Outputs:	uint8_t, 0 if the queue is full
+******************************************************************************/
+uint8_t hal_host_usart_receive(uint8_t c);
+
+/******************************************************************************
+	Function name:	hal_host_usart_set_hook()
+
+	Sets a function called with every byte the firmware transmits. NULL
+	removes it.
+******************************************************************************/
+void hal_host_usart_set_hook(void (*hook)(uint8_t c));
+
+/******************************************************************************
+	Function name:	hal_host_twi_attach()
+
+	Attaches a device to the simulated TWI bus, replacing a device with the
+	same address.
+
+	Outputs:	uint8_t, 0 if HAL_HOST_TWI_DEVICES are attached already
+******************************************************************************/
+#define HAL_HOST_TWI_DEVICES 4
+uint8_t hal_host_twi_attach(const hal_host_twi_device_t *device);
+
+/******************************************************************************
+	Function name:	hal_host_oled_ram()
+
+	Returns the display RAM of the simulated SH1106 OLED,
+	HAL_HOST_OLED_PAGES x HAL_HOST_OLED_COLUMNS bytes, a byte is a column
+	of 8 pixels of a page with the top pixel in bit 0.
+******************************************************************************/
+#define HAL_HOST_OLED_PAGES 8
+#define HAL_HOST_OLED_COLUMNS 132
+uint8_t (*hal_host_oled_ram(void))[HAL_HOST_OLED_COLUMNS];
+
+/******************************************************************************
+	Function name:	hal_host_mpu6050_registers()
+
+	Returns the 128 registers of the simulated MPU6050, e.g. to set the
+	accelerometer output at 0x3B..0x40 (big-endian).
+******************************************************************************/
+uint8_t *hal_host_mpu6050_registers(void);
+
+/******************************************************************************
+	Function name:	hal_host_devices_attach()
+
+	Attaches the OLED and MPU6050 models. Called by the simulation at start.
+******************************************************************************/
+void hal_host_devices_attach(void);
+
+
+
+#endif /* HAL_HOST_H_ */
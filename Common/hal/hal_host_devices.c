@@ -0,0 +1,205 @@
+/******************************************************************************
+	HOST TWI DEVICE MODELS IMPLEMENTATION FILE
+
+	This file contains the devices on the simulated TWI bus of the host
+	backend (hal_host.c):
+
+		- SH1106 OLED at 0x3C. Commands and data are taken with the control
+		  byte (Co, D/C) of the datasheet, the data is written to the
+		  display RAM at the page and column set by the commands.
+		  Commands with parameters are skipped with their parameters.
+		- MPU6050 at 0x68. A register file of 128 bytes, the first byte
+		  written selects the register, further bytes are written to it
+		  and reads continue from it, both with auto increment.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "hal.h"
+#include <stddef.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define OLED_ADDRESS	0x3C
+#define MPU6050_ADDRESS	0x68
+
+#define MPU6050_REGISTERS	128
+#define MPU6050_PWR_MGMT_1	0x6B
+#define MPU6050_WHO_AM_I	0x75
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static void oled_start(uint8_t reading);
+static uint8_t oled_write(uint8_t data);
+static void oled_command(uint8_t command);
+static void mpu6050_start(uint8_t reading);
+static uint8_t mpu6050_write(uint8_t data);
+static uint8_t mpu6050_read(void);
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static const hal_host_twi_device_t oled_device = {
+	OLED_ADDRESS, oled_start, oled_write, NULL, NULL
+};
+
+static struct {
+	uint8_t ram[HAL_HOST_OLED_PAGES][HAL_HOST_OLED_COLUMNS];
+	uint8_t page;
+	uint8_t column;
+	uint8_t control;			//next byte is a control byte
+	uint8_t single;				//Co set, one byte per control byte
+	uint8_t data;				//D/C set, the bytes are data
+	uint8_t parameters;			//parameters of a command to skip
+} oled;
+
+static const hal_host_twi_device_t mpu6050_device = {
+	MPU6050_ADDRESS, mpu6050_start, mpu6050_write, mpu6050_read, NULL
+};
+
+static struct {
+	uint8_t registers[MPU6050_REGISTERS];
+	uint8_t selected;
+	uint8_t selecting;			//next byte written selects the register
+} mpu6050 = {
+	.registers = { [MPU6050_PWR_MGMT_1] = 0x40, [MPU6050_WHO_AM_I] = MPU6050_ADDRESS }
+};
+
+
+
+/******************************************************************************
+	Function name:	hal_host_devices_attach()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+******************************************************************************/
+void hal_host_devices_attach(void) {
+	hal_host_twi_attach(&oled_device);
+	hal_host_twi_attach(&mpu6050_device);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	hal_host_oled_ram()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+******************************************************************************/
+uint8_t (*hal_host_oled_ram(void))[HAL_HOST_OLED_COLUMNS] {
+	return oled.ram;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	hal_host_mpu6050_registers()
+
+	This is a public function and is described in the header file,
+	hal_host.h.
+******************************************************************************/
+uint8_t *hal_host_mpu6050_registers(void) {
+	return mpu6050.registers;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+static void oled_start(uint8_t reading) {
+	(void)reading;
+	oled.control = 1;
+}
+
+static uint8_t oled_write(uint8_t data) {
+	if (oled.control) {
+		oled.single = (data & 0x80) != 0;
+		oled.data = (data & 0x40) != 0;
+		oled.control = 0;
+		return 1;
+	}
+
+	if (oled.data) {
+		if (oled.page < HAL_HOST_OLED_PAGES && oled.column < HAL_HOST_OLED_COLUMNS) {
+			oled.ram[oled.page][oled.column++] = data;
+		}
+	} else if (oled.parameters) {
+		oled.parameters--;
+	} else {
+		oled_command(data);
+	}
+
+	oled.control = oled.single;
+	return 1;
+}
+
+/******************************************************************************
+	Commands of the SH1106 and the SSD1306 used by lcd.c, only the page
+	addressing is modelled.
+******************************************************************************/
+static void oled_command(uint8_t command) {
+	if (command <= 0x0F) {
+		oled.column = (oled.column & 0xF0) | command;
+	} else if (command <= 0x1F) {
+		oled.column = (oled.column & 0x0F) | ((command & 0x0F) << 4);
+	} else if (command >= 0xB0 && command <= 0xB7) {
+		oled.page = command & 0x07;
+	} else {
+		switch (command) {
+			case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xAD:
+			case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+				oled.parameters = 1;
+				break;
+			case 0x21: case 0x22: case 0xA3:
+				oled.parameters = 2;
+				break;
+			case 0x29: case 0x2A:
+				oled.parameters = 5;
+				break;
+			case 0x26: case 0x27:
+				oled.parameters = 6;
+				break;
+			case 0x2C: case 0x2D:
+				oled.parameters = 7;
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+static void mpu6050_start(uint8_t reading) {
+	mpu6050.selecting = !reading;
+}
+
+static uint8_t mpu6050_write(uint8_t data) {
+	if (mpu6050.selecting) {
+		mpu6050.selected = data % MPU6050_REGISTERS;
+		mpu6050.selecting = 0;
+	} else {
+		mpu6050.registers[mpu6050.selected] = data;
+		mpu6050.selected = (mpu6050.selected + 1) % MPU6050_REGISTERS;
+	}
+	return 1;
+}
+
+static uint8_t mpu6050_read(void) {
+	uint8_t data = mpu6050.registers[mpu6050.selected];
+
+	mpu6050.selected = (mpu6050.selected + 1) % MPU6050_REGISTERS;
+	return data;
+}
+/*****************************************************************************/
@@ -0,0 +1,30 @@
+/******************************************************************************
+	FLASH ACCESS, HOST BUILD
+
+	This file takes the place of avr-libc's <avr/pgmspace.h> in the host
+	build (HAL_HOST), where this directory is first in the include path.
+	Flash is ordinary memory on the host, so the data stays where it is and
+	the pgm_read functions read it directly. Only what the firmwares use is
+	provided.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef HAL_HOST_PGMSPACE_H_
+#define HAL_HOST_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+
+#define pgm_read_byte(address)	(*(const uint8_t *)(address))
+#define pgm_read_word(address)	(*(const uint16_t *)(address))
+#define pgm_read_ptr(address)	(*(void * const *)(address))
+
+#define memcpy_P(destination, source, n)	memcpy((destination), (source), (n))
+#define strlen_P(s)							strlen(s)
+
+#endif /* HAL_HOST_PGMSPACE_H_ */
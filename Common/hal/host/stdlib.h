@@ -0,0 +1,24 @@
+/******************************************************************************
+	STANDARD LIBRARY, HOST BUILD
+
+	This file adds the avr-libc extensions of <stdlib.h> used by the
+	firmwares to the C library of the host build (HAL_HOST), where this
+	directory is first in the include path. The functions are implemented
+	in hal_host.c and work like avr-libc's: the number is written to the
+	string in the radix 2..36 and the string is returned.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef HAL_HOST_STDLIB_H_
+#define HAL_HOST_STDLIB_H_
+
+#include_next <stdlib.h>
+
+char *itoa(int value, char *s, int radix);
+char *utoa(unsigned int value, char *s, int radix);
+char *ltoa(long value, char *s, int radix);
+char *ultoa(unsigned long value, char *s, int radix);
+
+#endif /* HAL_HOST_STDLIB_H_ */
@@ -0,0 +1,292 @@
+/******************************************************************************
+	I2C BUS MANAGER IMPLEMENTATION FILE
+
+	This file contains the implementation of the I2C bus manager. See
+	i2c_bus.h for a description of the interface.
+
+	For more information regarding the TWI bit rate, please refer to
+	Atmel-8271J-AVR- ATmega-Datasheet_11/2015, chapter 22.5.2. For the bus
+	recovery procedure, please refer to NXP UM10204 I2C-bus specification,
+	chapter 3.1.16.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "i2c_bus.h"
+#include "twi.h"
+#include "../timer2/timer2.h"
+#include "../hal/hal.h"
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//TWI pins, SDA = PC4, SCL = PC5
+#define I2C_BUS_SDA PC4
+#define I2C_BUS_SCL PC5
+
+//Half SCL period of the recovery clock, 100 kHz
+#define I2C_BUS_RECOVERY_HALF_PERIOD_US 5
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+//Registered devices
+static i2c_bus_device_t *devices[I2C_BUS_MAX_DEVICES];
+static uint8_t device_count = 0;
+
+//Profile and counters of all devices that are not registered
+static i2c_bus_device_t default_device = I2C_BUS_DEVICE(0, I2C_BUS_CLOCK_DEFAULT);
+
+//Device addressed by the running or last transaction
+static i2c_bus_device_t *selected = &default_device;
+
+static uint16_t recoveries = 0;
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTION PROTOTYPES
+******************************************************************************/
+static uint16_t transaction_bytes(twi_transaction_t *t);
+
+
+
+/******************************************************************************
+	Function name:	i2c_bus_init()
+
+	This is a public function and is described in the header file, i2c_bus.h.
+******************************************************************************/
+void i2c_bus_init(void) {
+	hal_twi_init(selected->twbr);				//no prescaler
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	i2c_bus_register()
+
+	This is a public function and is described in the header file, i2c_bus.h.
+******************************************************************************/
+uint8_t i2c_bus_register(i2c_bus_device_t *device) {
+	if (i2c_bus_lookup(device->address) == device) {
+		return 1;								//already registered
+	}
+
+	if (device_count >= I2C_BUS_MAX_DEVICES) {
+		return 0;
+	}
+
+	devices[device_count++] = device;
+
+	return 1;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	i2c_bus_lookup()
+
+	This is a public function and is described in the header file, i2c_bus.h.
+******************************************************************************/
+i2c_bus_device_t *i2c_bus_lookup(uint8_t address) {
+	uint8_t i;
+
+	for (i = 0; i < device_count; i++) {
+		if (devices[i]->address == address) {
+			return devices[i];
+		}
+	}
+
+	return &default_device;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	i2c_bus_select()
+
+	This is a public function and is described in the header file, i2c_bus.h.
+******************************************************************************/
+i2c_bus_device_t *i2c_bus_select(uint8_t address) {
+	selected = i2c_bus_lookup(address);
+
+	if (hal_twi_bit_rate() != selected->twbr) {
+		hal_twi_set_bit_rate(selected->twbr);
+	}
+
+	return selected;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	i2c_bus_byte_timeout()
+
+	This is a public function and is described in the header file, i2c_bus.h.
+******************************************************************************/
+uint16_t i2c_bus_byte_timeout(void) {
+	return selected->byte_timeout_us;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	i2c_bus_count()
+
+	This is a public function and is described in the header file, i2c_bus.h.
+******************************************************************************/
+void i2c_bus_count(uint16_t bytes, int8_t status) {
+	i2c_bus_stats_t *stats = &selected->stats;
+
+	stats->transactions++;
+	stats->bytes += bytes;
+
+	switch (status) {
+		case TWI_STATUS_NACK:
+			stats->nacks++;
+			break;
+
+		case TWI_STATUS_BUS_ERROR:
+			stats->bus_errors++;
+			break;
+
+		case TWI_STATUS_TIMEOUT:
+			stats->timeouts++;
+			break;
+
+		default:
+			break;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	i2c_bus_recover()
+
+	This is a public function and is described in the header file, i2c_bus.h.
+
+	SDA and SCL are driven as open drain outputs: the pin is pulled low by
+	setting the DDR bit with PORT = 0, and released by clearing the DDR bit.
+******************************************************************************/
+uint8_t i2c_bus_recover(void) {
+	uint8_t i;
+	uint8_t released;
+
+	recoveries++;
+
+	hal_twi_set_control(0);						//disconnect TWI from the pins
+	hal_gpio_input(C, (1 << I2C_BUS_SDA) | (1 << I2C_BUS_SCL));
+	hal_gpio_low(C, (1 << I2C_BUS_SDA) | (1 << I2C_BUS_SCL));
+
+	//clock SCL until the device lets go of SDA, at most one byte and ACK
+	for (i = 0; i < 9 && !hal_gpio_read(C, 1 << I2C_BUS_SDA); i++) {
+		hal_gpio_output(C, 1 << I2C_BUS_SCL);	//SCL low
+		hal_delay_us(I2C_BUS_RECOVERY_HALF_PERIOD_US);
+		hal_gpio_input(C, 1 << I2C_BUS_SCL);	//SCL released
+		hal_delay_us(I2C_BUS_RECOVERY_HALF_PERIOD_US);
+	}
+
+	//STOP condition, SDA goes high while SCL is high
+	hal_gpio_output(C, 1 << I2C_BUS_SCL);
+	hal_gpio_output(C, 1 << I2C_BUS_SDA);
+	hal_delay_us(I2C_BUS_RECOVERY_HALF_PERIOD_US);
+	hal_gpio_input(C, 1 << I2C_BUS_SCL);
+	hal_delay_us(I2C_BUS_RECOVERY_HALF_PERIOD_US);
+	hal_gpio_input(C, 1 << I2C_BUS_SDA);
+	hal_delay_us(I2C_BUS_RECOVERY_HALF_PERIOD_US);
+
+	released = hal_gpio_read(C, 1 << I2C_BUS_SDA) != 0;
+
+	hal_twi_set_bit_rate(selected->twbr);
+	hal_twi_set_control(1 << TWEN);				//TWI takes the pins back
+
+	return released;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	i2c_bus_recoveries()
+
+	This is a public function and is described in the header file, i2c_bus.h.
+******************************************************************************/
+uint16_t i2c_bus_recoveries(void) {
+	return recoveries;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	i2c_bus_benchmark()
+
+	This is a public function and is described in the header file, i2c_bus.h.
+******************************************************************************/
+void i2c_bus_benchmark(twi_transaction_t *transaction, uint16_t iterations,
+					   i2c_bus_benchmark_t *result) {
+	uint16_t bytes = transaction_bytes(transaction);
+	uint32_t start;
+	uint16_t i;
+
+	result->iterations = iterations;
+	result->errors = 0;
+	result->bytes = 0;
+
+	start = timer2_get_micros();
+
+	for (i = 0; i < iterations; i++) {
+		if (!twi_submit(transaction)) {
+			result->errors++;				//queue full
+		} else if (twi_wait(transaction) == TWI_STATUS_OK) {
+			result->bytes += bytes;
+		} else {
+			result->errors++;
+		}
+	}
+
+	result->micros = timer2_get_micros() - start;
+
+	if (result->micros >= 1000) {
+		result->bytes_per_second = (result->bytes * 1000UL) / (result->micros / 1000UL);
+	} else {
+		result->bytes_per_second = 0;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Returns the number of bytes a transaction puts on the bus, address bytes
+	included.
+******************************************************************************/
+static uint16_t transaction_bytes(twi_transaction_t *t) {
+	uint16_t bytes = 1 + t->write_length;
+
+	if (t->flags & TWI_FLAG_PREFIX) {
+		bytes++;
+	}
+
+	if (t->read_length) {
+		bytes += 1 + t->read_length;
+	}
+
+	return bytes;
+}
@@ -0,0 +1,190 @@
+/******************************************************************************
+	I2C BUS MANAGER HEADER FILE
+
+	This file contains the interface to the I2C bus manager, which sits
+	below both the blocking i2c_xxx() functions (i2cmaster.c) and the
+	transaction engine (twi.c).
+
+	The bus manager keeps:
+		- a clock profile per device. Each device is registered with its
+		  SCL clock and the bit rate is switched when another device is
+		  addressed.
+		- the bounded wait time for one byte on the bus, derived from the
+		  clock profile. A wait that runs out is reported as a timeout and
+		  the bus is recovered.
+		- the bus recovery procedure: up to 9 SCL clocks until the device
+		  holding SDA low lets go, followed by a STOP condition.
+		- error and throughput counters per device.
+
+	Example:
+		static i2c_bus_device_t sensor = I2C_BUS_DEVICE(0x68, I2C_BUS_CLOCK_400K);
+		i2c_bus_register(&sensor);
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef I2C_BUS_H_
+#define I2C_BUS_H_
+
+#include <stdint.h>
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Clock profiles
+#define I2C_BUS_CLOCK_100K 100000UL
+#define I2C_BUS_CLOCK_400K 400000UL
+
+//Clock used for devices that are not registered
+#define I2C_BUS_CLOCK_DEFAULT I2C_BUS_CLOCK_100K
+
+//Maximum number of registered devices
+#define I2C_BUS_MAX_DEVICES 4
+
+//TWBR value for an SCL clock, TWPS = 0 => prescaler = 1
+#define I2C_BUS_TWBR(clock) ((uint8_t)(((F_CPU / (clock)) - 16) / 2))
+
+//Bounded wait for one byte (9 SCL clocks): 10 byte times plus 100 micros
+//margin for clock stretching
+#define I2C_BUS_BYTE_TIMEOUT_US(clock) ((uint16_t)(90000000UL / (clock) + 100))
+
+//Device description with clock profile and counters
+#define I2C_BUS_DEVICE(address, clock) \
+	{ (address), I2C_BUS_TWBR(clock), I2C_BUS_BYTE_TIMEOUT_US(clock), { 0 } }
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	uint16_t transactions;		//completed transactions (START to STOP)
+	uint16_t nacks;				//address or data not acknowledged
+	uint16_t bus_errors;		//bus error or arbitration lost
+	uint16_t timeouts;			//bounded wait ran out
+	uint32_t bytes;				//bytes on the bus, address bytes included
+} i2c_bus_stats_t;
+
+typedef struct {
+	uint8_t address;			//7-bit address
+	uint8_t twbr;				//bit rate register value of clock profile
+	uint16_t byte_timeout_us;	//bounded wait for one byte
+	i2c_bus_stats_t stats;
+} i2c_bus_device_t;
+
+typedef struct {
+	uint16_t iterations;		//transactions run
+	uint16_t errors;			//transactions that failed
+	uint32_t bytes;				//bytes on the bus
+	uint32_t micros;			//total time
+	uint32_t bytes_per_second;	//throughput
+} i2c_bus_benchmark_t;
+
+struct twi_transaction;
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	i2c_bus_init()
+
+	Sets the TWI prescaler to 1 and the default bit rate. Called by
+	i2c_init().
+******************************************************************************/
+void i2c_bus_init(void);
+
+/******************************************************************************
+	Function name:	i2c_bus_register()
+
+	Registers a device and its clock profile. The device struct must be
+	static, it holds the counters of the device.
+
+	Outputs:	uint8_t, 1 if registered, 0 if the device table is full
+******************************************************************************/
+uint8_t i2c_bus_register(i2c_bus_device_t *device);
+
+/******************************************************************************
+	Function name:	i2c_bus_lookup()
+
+	Finds the device registered for an address, without selecting it.
+
+	Inputs:		uint8_t address, 7-bit address
+	Outputs:	i2c_bus_device_t *, the device or the default device
+******************************************************************************/
+i2c_bus_device_t *i2c_bus_lookup(uint8_t address);
+
+/******************************************************************************
+	Function name:	i2c_bus_select()
+
+	Selects the device to address next and switches to its bit rate.
+	Unregistered addresses get the default profile and share one set of
+	counters.
+
+	Inputs:		uint8_t address, 7-bit address
+	Outputs:	i2c_bus_device_t *, the selected device
+******************************************************************************/
+i2c_bus_device_t *i2c_bus_select(uint8_t address);
+
+/******************************************************************************
+	Function name:	i2c_bus_byte_timeout()
+
+	Outputs:	uint16_t, the bounded wait for one byte, in micros, of the
+				selected device.
+******************************************************************************/
+uint16_t i2c_bus_byte_timeout(void);
+
+/******************************************************************************
+	Function name:	i2c_bus_count()
+
+	Counts bytes and the result of a completed transaction on the selected
+	device.
+
+	Inputs:		uint16_t bytes, bytes on the bus
+				int8_t status, TWI_STATUS_xxx (twi.h)
+******************************************************************************/
+void i2c_bus_count(uint16_t bytes, int8_t status);
+
+/******************************************************************************
+	Function name:	i2c_bus_recover()
+
+	Releases a bus held by a device. The TWI is disabled, SCL is clocked
+	up to 9 times until SDA is released and a STOP condition is generated.
+	The TWI is re-enabled with the bit rate of the selected device.
+
+	Outputs:	uint8_t, 1 if SDA is released (bus free), 0 if still held
+******************************************************************************/
+uint8_t i2c_bus_recover(void);
+
+/******************************************************************************
+	Function name:	i2c_bus_recoveries()
+
+	Outputs:	uint16_t, number of times the bus has been recovered
+******************************************************************************/
+uint16_t i2c_bus_recoveries(void);
+
+/******************************************************************************
+	Function name:	i2c_bus_benchmark()
+
+	Runs a transaction a number of times through the transaction engine and
+	measures the throughput, using the system clock (timer2.c).
+
+	Inputs:		struct twi_transaction *transaction
+				uint16_t iterations
+	Outputs:	i2c_bus_benchmark_t *result
+******************************************************************************/
+void i2c_bus_benchmark(struct twi_transaction *transaction, uint16_t iterations,
+					   i2c_bus_benchmark_t *result);
+
+
+
+#endif /* I2C_BUS_H_ */
@@ -0,0 +1,271 @@
+
+#include <inttypes.h>
+#include "../hal/hal.h"
+#include "i2cmaster.h"
+#include "i2c_bus.h"
+#include "twi.h"
+
+
+/* define CPU frequency in Mhz here if not defined in Makefile */
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+/* I2C clock in Hz, devices registered with i2c_bus_register() get their own */
+#define SCL_CLOCK  I2C_BUS_CLOCK_DEFAULT
+
+
+/* first error of the running session, bytes on the bus in the session */
+static uint8_t session_error;
+static uint16_t session_bytes;
+
+
+/*************************************************************************
+ Initialization of the I2C bus interface. Need to be called only once
+*************************************************************************/
+void i2c_init(void){
+  /* initialize TWI clock: 100 kHz clock, TWPS = 0 => prescaler = 1 */
+  i2c_bus_init();								/* no prescaler, default clock */
+
+}/* i2c_init */
+
+
+/*************************************************************************
+ Waits for TWINT, at most one byte timeout of the addressed device.
+ On timeout the bus is recovered.
+ Return:  1 done, 0 timeout
+*************************************************************************/
+uint8_t i2c_sync(void){
+	uint16_t timeout = i2c_bus_byte_timeout();
+	while(!(hal_twi_control() & (1<<TWINT)) && timeout) {
+		hal_delay_us(1);
+		timeout--;
+	}
+	if(timeout == 0) {
+		if(!session_error) session_error = I2C_ERR_TIMEOUT;
+		i2c_bus_recover();
+		return 0;
+	}
+	session_bytes++;
+	return 1;
+}
+
+uint8_t i2c_waitStop(void){
+	uint16_t timeout = i2c_bus_byte_timeout();
+	while((hal_twi_control() & (1<<TWSTO)) && timeout) {
+		hal_delay_us(1);
+		timeout--;
+	}
+	return timeout != 0;
+}
+
+
+/*************************************************************************
+ Sends a (repeated) start condition and the address, the bus is claimed
+ Return:  I2C_OK or error code
+*************************************************************************/
+static uint8_t i2c_address(unsigned char address){
+    uint8_t   twst;
+
+	if(session_error) return session_error;
+
+	// send START condition
+	hal_twi_set_control((1<<TWINT) | (1<<TWSTA) | (1<<TWEN));
+
+	// wait until transmission completed
+	if(!i2c_sync()) return I2C_ERR_TIMEOUT;
+	session_bytes--;	// START is not a byte
+
+	// check value of TWI Status Register. Mask prescaler bits.
+	twst = hal_twi_status() & 0xF8;
+	if ( (twst != TW_START) && (twst != TW_REP_START)) return session_error = I2C_ERR_BUS;
+
+	// send device address
+	hal_twi_write(address);
+	hal_twi_set_control((1<<TWINT) | (1<<TWEN));
+
+	// wail until transmission completed and ACK/NACK has been received
+	if(!i2c_sync()) return I2C_ERR_TIMEOUT;
+
+	// check value of TWI Status Register. Mask prescaler bits.
+	twst = hal_twi_status() & 0xF8;
+	if ( (twst != TW_MT_SLA_ACK) && (twst != TW_MR_SLA_ACK) ) return session_error = I2C_ERR_NACK;
+
+	return I2C_OK;
+}
+
+
+/*************************************************************************
+  Issues a start condition and sends address and transfer direction.
+  return 0 = device accessible, else error code I2C_ERR_xxx
+*************************************************************************/
+unsigned char i2c_start(unsigned char address){
+	// claim the bus from the transaction engine (twi.c)
+	twi_acquire();
+
+	// clock profile of the device (i2c_bus.c), new session
+	i2c_bus_select(address >> 1);
+	session_error = I2C_OK;
+	session_bytes = 0;
+
+	return i2c_address(address);
+
+}/* i2c_start */
+
+
+/*************************************************************************
+ Issues a start condition and sends address and transfer direction.
+ If device is busy, use ack polling to wait until device is ready
+
+ Input:   address and transfer direction of I2C device
+ Return:  1 device accessible, 0 failed (i2c_error() tells why)
+*************************************************************************/
+uint8_t i2c_start_wait(unsigned char address){
+    uint8_t   twst;
+
+    int retry = 2000;
+
+    // claim the bus from the transaction engine (twi.c)
+    twi_acquire();
+    i2c_bus_select(address >> 1);
+    session_error = I2C_OK;
+    session_bytes = 0;
+    while ( 1 ){
+	    // send START condition
+	    hal_twi_set_control((1<<TWINT) | (1<<TWSTA) | (1<<TWEN));
+
+    	// wait until transmission completed
+    	if(!i2c_sync()) break;
+    	session_bytes--;
+
+    	// check value of TWI Status Register. Mask prescaler bits.
+    	twst = hal_twi_status() & 0xF8;
+    	if ( (twst != TW_START) && (twst != TW_REP_START)) continue;
+
+    	// send device address
+    	hal_twi_write(address);
+    	hal_twi_set_control((1<<TWINT) | (1<<TWEN));
+
+    	// wail until transmission completed
+    	if(!i2c_sync()) break;
+
+    	// check value of TWI Status Register. Mask prescaler bits.
+    	twst = hal_twi_status() & 0xF8;
+    	if ( (twst == TW_MT_SLA_NACK )||(twst ==TW_MR_DATA_NACK) ) {
+    	    /* device busy, send stop condition to terminate write operation */
+	        hal_twi_set_control((1<<TWINT) | (1<<TWEN) | (1<<TWSTO));
+
+	        // wait until stop condition is executed and bus released
+	        if(!i2c_waitStop()) continue;
+
+	        if(!(retry --)) {
+	            session_error = I2C_ERR_NACK;
+	            break;
+	        }
+    	    continue;
+    	}
+    	return 1;
+    	//if( twst != TW_MT_SLA_ACK) return 1;
+    	break;
+     }
+	return 0;
+}/* i2c_start_wait */
+
+
+/*************************************************************************
+ Issues a repeated start condition and sends address and transfer direction
+
+ Input:   address and transfer direction of I2C device
+
+ Return:  0 device accessible
+          else error code I2C_ERR_xxx
+*************************************************************************/
+unsigned char i2c_rep_start(unsigned char address){
+    return i2c_address( address );
+
+}/* i2c_rep_start */
+
+
+/*************************************************************************
+ Terminates the data transfer and releases the I2C bus
+*************************************************************************/
+void i2c_stop(void){
+	// after a timeout the bus has been recovered, which ends with a STOP
+	if(session_error != I2C_ERR_TIMEOUT) {
+	    /* send stop condition */
+		hal_twi_set_control((1<<TWINT) | (1<<TWEN) | (1<<TWSTO));
+
+		// wait until stop condition is executed and bus released
+		i2c_waitStop();
+	}
+
+	// count the session on the device (i2c_bus.c)
+	i2c_bus_count(session_bytes, -(int8_t)session_error);
+
+	// hand the bus back to the transaction engine (twi.c)
+	twi_release();
+
+}/* i2c_stop */
+
+
+/*************************************************************************
+  Send one byte to I2C device
+
+  Input:    byte to be transfered
+  Return:   0 write successful
+            else error code I2C_ERR_xxx
+*************************************************************************/
+unsigned char i2c_write( unsigned char data ){
+    uint8_t   twst;
+
+	if(session_error) return session_error;
+
+	// send data to the previously addressed device
+	hal_twi_write(data);
+	hal_twi_set_control((1<<TWINT) | (1<<TWEN));
+
+	// wait until transmission completed
+	if(!i2c_sync()) return I2C_ERR_TIMEOUT;
+
+	// check value of TWI Status Register. Mask prescaler bits
+	twst = hal_twi_status() & 0xF8;
+	if( twst != TW_MT_DATA_ACK) return session_error = I2C_ERR_NACK;
+	return I2C_OK;
+
+}/* i2c_write */
+
+
+/*************************************************************************
+ Read one byte from the I2C device, request more data from device
+
+ Return:  byte read from I2C device, 0 after an error
+*************************************************************************/
+unsigned char i2c_readAck(void){
+	if(session_error) return 0;
+	hal_twi_set_control((1<<TWINT) | (1<<TWEN) | (1<<TWEA));
+	if(!i2c_sync()) return 0;
+	return hal_twi_read();
+}/* i2c_readAck */
+
+
+/*************************************************************************
+ Read one byte from the I2C device, read is followed by a stop condition
+
+ Return:  byte read from I2C device, 0 after an error
+*************************************************************************/
+unsigned char i2c_readNak(void){
+	if(session_error) return 0;
+	hal_twi_set_control((1<<TWINT) | (1<<TWEN));
+	if(!i2c_sync()) return 0;
+	return hal_twi_read();
+}/* i2c_readNak */
+
+
+/*************************************************************************
+ First error since i2c_start()
+
+ Return:  I2C_OK or error code I2C_ERR_xxx
+*************************************************************************/
+uint8_t i2c_error(void){
+	return session_error;
+}/* i2c_error */
@@ -0,0 +1,393 @@
+/******************************************************************************
+	TWI TRANSACTION ENGINE IMPLEMENTATION FILE
+
+	This file contains the implementation of the interrupt driven TWI (I2C)
+	transaction engine. See twi.h for a description of the interface.
+
+	For more information regarding the TWI status codes, please refer to
+	Atmel-8271J-AVR- ATmega-Datasheet_11/2015, chapter 22.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "twi.h"
+#include "i2c_bus.h"
+#include "../hal/hal.h"
+#include <avr/pgmspace.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//TWCR values used by the state machine
+#define TWCR_START		((1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE))
+#define TWCR_NEXT		((1 << TWINT) | (1 << TWEN) | (1 << TWIE))
+#define TWCR_NEXT_ACK	((1 << TWINT) | (1 << TWEA) | (1 << TWEN) | (1 << TWIE))
+#define TWCR_STOP		((1 << TWINT) | (1 << TWSTO) | (1 << TWEN))
+#define TWCR_STOP_START	((1 << TWINT) | (1 << TWSTO) | (1 << TWSTA) | \
+						 (1 << TWEN) | (1 << TWIE))
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+//Queue of transactions, queue[queue_head] is the running one
+static twi_transaction_t *volatile queue[TWI_QUEUE_SIZE];
+static volatile uint8_t queue_head;
+static volatile uint8_t queue_count;
+
+static volatile uint8_t running;		//a transaction is on the bus
+static volatile uint8_t locked;			//bus claimed by twi_acquire()
+static volatile uint8_t reading;		//running transaction is in read phase
+static volatile uint16_t byte_index;	//byte position in current phase
+static volatile uint16_t bus_bytes;		//bytes on the bus, running transaction
+static volatile uint8_t progress;		//bus events, for the bounded waits
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTION PROTOTYPES
+******************************************************************************/
+static void start_next(void);
+static uint8_t write_next_byte(twi_transaction_t *t);
+static void complete(int8_t status);
+static void finish(int8_t status);
+static void abort_running(uint8_t seen);
+static void watchdog(uint8_t *seen, uint16_t *idle_us);
+
+
+
+/******************************************************************************
+	INTERRUPT SERVICE ROUTINE
+
+	Runs the transaction at the head of the queue one bus event at a time.
+******************************************************************************/
+ISR(TWI_vect) {
+	twi_transaction_t *t = queue[queue_head];
+	uint8_t status = hal_twi_status();
+
+	progress++;
+	if (status != TW_START && status != TW_REP_START) {
+		bus_bytes++;						//address or data byte done
+	}
+
+	switch (status) {
+		case TW_START:
+		case TW_REP_START:
+			hal_twi_write((t->address << 1) | (reading ? TW_READ : TW_WRITE));
+			hal_twi_set_control(TWCR_NEXT);
+			break;
+
+		case TW_MT_SLA_ACK:
+		case TW_MT_DATA_ACK:
+			if (write_next_byte(t)) {
+				break;
+			}
+
+			if (t->read_length) {			//repeated start for read phase
+				reading = 1;
+				byte_index = 0;
+				hal_twi_set_control(TWCR_START);
+			} else {
+				finish(TWI_STATUS_OK);
+			}
+			break;
+
+		case TW_MR_DATA_ACK:
+			t->read_buffer[byte_index++] = hal_twi_read();
+			//fall through
+		case TW_MR_SLA_ACK:
+			if (byte_index + 1 < t->read_length) {
+				hal_twi_set_control(TWCR_NEXT_ACK);		//more bytes to come
+			} else {
+				hal_twi_set_control(TWCR_NEXT);			//NACK the last byte
+			}
+			break;
+
+		case TW_MR_DATA_NACK:
+			t->read_buffer[byte_index] = hal_twi_read();
+			finish(TWI_STATUS_OK);
+			break;
+
+		case TW_MT_SLA_NACK:
+		case TW_MR_SLA_NACK:
+		case TW_MT_DATA_NACK:
+			finish(TWI_STATUS_NACK);
+			break;
+
+		default:							//arbitration lost, bus error
+			finish(TWI_STATUS_BUS_ERROR);
+			break;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	twi_submit()
+
+	This is a public function and is described in the header file, twi.h.
+******************************************************************************/
+uint8_t twi_submit(twi_transaction_t *transaction) {
+	uint8_t queued = 0;
+
+	HAL_CRITICAL_SECTION {
+		if (queue_count < TWI_QUEUE_SIZE) {
+			transaction->status = TWI_STATUS_PENDING;
+			queue[(queue_head + queue_count) % TWI_QUEUE_SIZE] = transaction;
+			queue_count++;
+			queued = 1;
+
+			if (!running && !locked) {
+				start_next();
+			}
+		}
+	}
+
+	return queued;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	twi_wait()
+
+	This is a public function and is described in the header file, twi.h.
+******************************************************************************/
+int8_t twi_wait(twi_transaction_t *transaction) {
+	uint8_t seen = progress;
+	uint16_t idle_us = 0;
+
+	while (transaction->status == TWI_STATUS_PENDING) {
+		watchdog(&seen, &idle_us);
+	}
+
+	return transaction->status;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	twi_is_busy()
+
+	This is a public function and is described in the header file, twi.h.
+******************************************************************************/
+uint8_t twi_is_busy(void) {
+	return queue_count != 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	twi_acquire()
+
+	This is a public function and is described in the header file, twi.h.
+******************************************************************************/
+void twi_acquire(void) {
+	uint8_t seen = progress;
+	uint16_t idle_us = 0;
+
+	while (1) {
+		HAL_CRITICAL_SECTION {
+			if (!running) {
+				locked = 1;
+			}
+		}
+
+		if (locked) {
+			return;
+		}
+
+		watchdog(&seen, &idle_us);
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	twi_release()
+
+	This is a public function and is described in the header file, twi.h.
+******************************************************************************/
+void twi_release(void) {
+	HAL_CRITICAL_SECTION {
+		locked = 0;
+
+		if (!running && queue_count) {
+			start_next();
+		}
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Sends a START condition for the transaction at the head of the queue,
+	with the clock of its device. Waits for a previous STOP condition to be
+	executed first, at most one byte timeout.
+
+	Called with interrupts disabled.
+******************************************************************************/
+static void start_next(void) {
+	uint16_t idle_us = 0;
+
+	while ((hal_twi_control() & (1 << TWSTO)) && idle_us++ < i2c_bus_byte_timeout()) {
+		hal_delay_us(1);
+	}
+
+	i2c_bus_select(queue[queue_head]->address);
+
+	running = 1;
+	reading = 0;
+	byte_index = 0;
+	bus_bytes = 0;
+	hal_twi_set_control(TWCR_START);
+}
+
+
+
+/******************************************************************************
+	Writes the next byte of the write phase to TWDR.
+
+	Outputs:	uint8_t, 1 if a byte was written, 0 if write phase is done
+******************************************************************************/
+static uint8_t write_next_byte(twi_transaction_t *t) {
+	uint16_t index = byte_index;
+
+	if (t->flags & TWI_FLAG_PREFIX) {
+		if (index == 0) {
+			hal_twi_write(t->prefix);
+			hal_twi_set_control(TWCR_NEXT);
+			byte_index++;
+			return 1;
+		}
+		index--;
+	}
+
+	if (index >= t->write_length) {
+		return 0;
+	}
+
+	if (t->flags & TWI_FLAG_WRITE_PROGMEM) {
+		hal_twi_write(pgm_read_byte(&t->write_buffer[index]));
+	} else {
+		hal_twi_write(t->write_buffer[index]);
+	}
+	hal_twi_set_control(TWCR_NEXT);
+	byte_index++;
+
+	return 1;
+}
+
+
+
+/******************************************************************************
+	Removes the running transaction from the queue, counts it on its device
+	and reports the status.
+******************************************************************************/
+static void complete(int8_t status) {
+	twi_transaction_t *t = queue[queue_head];
+
+	queue_head = (queue_head + 1) % TWI_QUEUE_SIZE;
+	queue_count--;
+
+	i2c_bus_count(bus_bytes, status);
+
+	t->status = status;
+	if (t->callback) {
+		t->callback(t);				//may submit a new transaction
+	}
+}
+
+
+
+/******************************************************************************
+	Completes the running transaction and starts the next one, if any.
+	The STOP condition and the next START condition are sent in one go if
+	the next device runs at the same clock.
+
+	Called from ISR(TWI_vect).
+******************************************************************************/
+static void finish(int8_t status) {
+	twi_transaction_t *next;
+
+	complete(status);
+
+	if (queue_count && !locked) {
+		next = queue[queue_head];
+
+		if (i2c_bus_lookup(next->address)->twbr == hal_twi_bit_rate()) {
+			i2c_bus_select(next->address);
+			reading = 0;
+			byte_index = 0;
+			bus_bytes = 0;
+			hal_twi_set_control(TWCR_STOP_START);
+		} else {
+			hal_twi_set_control(TWCR_STOP);
+			start_next();			//new clock once the STOP is done
+		}
+	} else {
+		running = 0;
+		hal_twi_set_control(TWCR_STOP);
+	}
+}
+
+
+
+/******************************************************************************
+	Aborts the running transaction with TWI_STATUS_TIMEOUT, recovers the bus
+	and starts the next transaction, if any. Nothing is done if the bus has
+	made progress since the caller looked.
+
+	Inputs:		uint8_t seen, progress count seen by the caller
+******************************************************************************/
+static void abort_running(uint8_t seen) {
+	HAL_CRITICAL_SECTION {
+		if (running && progress == seen) {
+			hal_twi_set_control(0);
+			complete(TWI_STATUS_TIMEOUT);
+			i2c_bus_recover();
+			running = 0;
+
+			if (queue_count && !locked) {
+				start_next();
+			}
+		}
+	}
+}
+
+
+
+/******************************************************************************
+	One step of a bounded wait. The idle time is reset on every bus event.
+	The running transaction is aborted when the bus has been idle for one
+	byte timeout of the running device.
+
+	Inputs:		uint8_t *seen, last seen progress count
+				uint16_t *idle_us, micros since last bus event
+******************************************************************************/
+static void watchdog(uint8_t *seen, uint16_t *idle_us) {
+	if (*seen != progress || !running) {
+		*seen = progress;
+		*idle_us = 0;
+	} else if (*idle_us >= i2c_bus_byte_timeout()) {
+		abort_running(*seen);
+		*idle_us = 0;
+	} else {
+		hal_delay_us(1);
+		(*idle_us)++;
+	}
+}
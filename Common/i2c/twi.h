@@ -0,0 +1,130 @@
+/******************************************************************************
+	TWI TRANSACTION ENGINE HEADER FILE
+
+	This file contains the interface to queue interrupt driven TWI (I2C)
+	transactions. The engine is shared by the Remote and the Robot firmware.
+
+	A transaction is described by a twi_transaction_t:
+		- address		7-bit device address
+		- prefix		optional first byte to write, e.g. a register
+						address or an OLED control byte (TWI_FLAG_PREFIX)
+		- write_buffer	bytes to write after the prefix, in SRAM or in
+						flash (TWI_FLAG_WRITE_PROGMEM)
+		- read_buffer	bytes to read after the write, using a repeated
+						start
+		- status		TWI_STATUS_PENDING until completed, then
+						TWI_STATUS_OK or a negative error code
+		- callback		optional, called from ISR(TWI_vect) when the
+						transaction is completed
+
+	Transactions are queued by twi_submit() and run back to back from
+	ISR(TWI_vect), so the CPU is free while the bytes are on the bus. The
+	transaction and its buffers must stay valid until it is completed.
+
+	Each transaction is run with the clock profile of its device, see
+	i2c_bus.h. Consecutive transactions are joined by a combined STOP and
+	START condition when they run at the same clock.
+
+	The blocking i2c_xxx() functions in i2cmaster.c share the bus with the
+	engine. They claim the bus with twi_acquire() in i2c_start() and give it
+	back with twi_release() in i2c_stop(). Queued transactions wait for that.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef TWI_H_
+#define TWI_H_
+
+#include <stdint.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Maximum number of transactions waiting or running
+#define TWI_QUEUE_SIZE 4
+
+//Transaction status
+#define TWI_STATUS_OK			0
+#define TWI_STATUS_PENDING		1
+#define TWI_STATUS_NACK			-1	//device did not acknowledge
+#define TWI_STATUS_BUS_ERROR	-2	//bus error or arbitration lost
+#define TWI_STATUS_TIMEOUT		-3	//bus stuck, no progress within timeout
+
+//Transaction flags
+#define TWI_FLAG_PREFIX			(1 << 0)	//write prefix before write_buffer
+#define TWI_FLAG_WRITE_PROGMEM	(1 << 1)	//write_buffer is located in flash
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct twi_transaction twi_transaction_t;
+
+struct twi_transaction {
+	uint8_t address;
+	uint8_t flags;
+	uint8_t prefix;
+	const uint8_t *write_buffer;
+	uint16_t write_length;
+	uint8_t *read_buffer;
+	uint8_t read_length;
+	volatile int8_t status;
+	void (*callback)(twi_transaction_t *transaction);
+};
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	twi_submit()
+
+	Queues a transaction and starts it if the bus is free. Can be called
+	from an interrupt service routine, e.g. from a completion callback.
+	The status of a transaction that is not queued is left unchanged.
+
+	Inputs:		twi_transaction_t *transaction
+	Outputs:	uint8_t, 1 if queued, 0 if the queue is full
+******************************************************************************/
+uint8_t twi_submit(twi_transaction_t *transaction);
+
+/******************************************************************************
+	Function name:	twi_wait()
+
+	Waits until a queued transaction is completed. If the bus makes no
+	progress for one byte timeout of the running device (i2c_bus.h), the
+	running transaction is aborted with TWI_STATUS_TIMEOUT and the bus is
+	recovered.
+
+	Inputs:		twi_transaction_t *transaction
+	Outputs:	int8_t, the transaction status
+******************************************************************************/
+int8_t twi_wait(twi_transaction_t *transaction);
+
+/******************************************************************************
+	Function name:	twi_is_busy()
+
+	Outputs:	uint8_t, 1 if a transaction is running or waiting
+******************************************************************************/
+uint8_t twi_is_busy(void);
+
+/******************************************************************************
+	Function name:	twi_acquire() / twi_release()
+
+	Claims the bus for blocking (polled) TWI access, waiting for the running
+	transaction to complete first, and gives it back to the engine, which
+	then starts the next queued transaction. The wait for the running
+	transaction is bounded the same way as in twi_wait().
+******************************************************************************/
+void twi_acquire(void);
+void twi_release(void);
+
+
+
+#endif /* TWI_H_ */
@@ -0,0 +1,150 @@
+/******************************************************************************
+	LINK IMPLEMENTATION FILE
+
+	This file contains implementations of the framed messages between the
+	Robot and the Remote. See link.h for the frame format.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "link.h"
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Parser states, the next byte expected
+#define STATE_SYNC		0
+#define STATE_TYPE		1
+#define STATE_LENGTH	2
+#define STATE_PAYLOAD	3
+#define STATE_CHECKSUM	4
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	link_encode()
+
+	This is a public function and is described in the header file, link.h.
+******************************************************************************/
+uint8_t link_encode(uint8_t type, const uint8_t *payload, uint8_t length, uint8_t *frame) {
+	uint8_t sum = type + length;
+
+	frame[0] = LINK_SYNC;
+	frame[1] = type;
+	frame[2] = length;
+	for (uint8_t i = 0; i < length; i++) {
+		frame[3 + i] = payload[i];
+		sum += payload[i];
+	}
+	frame[3 + length] = -sum;
+
+	return length + LINK_FRAME_OVERHEAD;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	link_encode_status()
+
+	This is a public function and is described in the header file, link.h.
+******************************************************************************/
+uint8_t link_encode_status(const link_status_t *status, uint8_t *frame) {
+	uint8_t payload[LINK_STATUS_LENGTH];
+
+	payload[0] = status->left_pwm;
+	payload[1] = status->right_pwm;
+	payload[2] = status->flags;
+	payload[3] = status->distance_cm & 0xFF;
+	payload[4] = status->distance_cm >> 8;
+	payload[5] = status->accel_peak & 0xFF;
+	payload[6] = status->accel_peak >> 8;
+
+	return link_encode(LINK_TYPE_STATUS, payload, LINK_STATUS_LENGTH, frame);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	link_parse()
+
+	This is a public function and is described in the header file, link.h.
+******************************************************************************/
+uint8_t link_parse(link_parser_t *parser, uint8_t byte) {
+	switch (parser->state) {
+	case STATE_SYNC:
+		if (byte != LINK_SYNC) {
+			return LINK_PARSE_IDLE;
+		}
+		parser->sum = 0;
+		parser->state = STATE_TYPE;
+		return LINK_PARSE_BUSY;
+
+	case STATE_TYPE:
+		parser->type = byte;
+		parser->sum += byte;
+		parser->state = STATE_LENGTH;
+		return LINK_PARSE_BUSY;
+
+	case STATE_LENGTH:
+		if (byte > LINK_MAX_PAYLOAD) {
+			parser->state = STATE_SYNC;
+			parser->errors++;
+			return LINK_PARSE_ERROR;
+		}
+		parser->length = byte;
+		parser->received = 0;
+		parser->sum += byte;
+		parser->state = byte ? STATE_PAYLOAD : STATE_CHECKSUM;
+		return LINK_PARSE_BUSY;
+
+	case STATE_PAYLOAD:
+		parser->payload[parser->received++] = byte;
+		parser->sum += byte;
+		if (parser->received == parser->length) {
+			parser->state = STATE_CHECKSUM;
+		}
+		return LINK_PARSE_BUSY;
+
+	default:
+		parser->state = STATE_SYNC;
+		if ((uint8_t)(parser->sum + byte) != 0) {
+			parser->errors++;
+			return LINK_PARSE_ERROR;
+		}
+		return LINK_PARSE_FRAME;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	link_decode_status()
+
+	This is a public function and is described in the header file, link.h.
+******************************************************************************/
+uint8_t link_decode_status(const link_parser_t *parser, link_status_t *status) {
+	const uint8_t *p = parser->payload;
+
+	if (parser->type != LINK_TYPE_STATUS || parser->length < LINK_STATUS_LENGTH) {
+		return 0;
+	}
+
+	status->left_pwm = p[0];
+	status->right_pwm = p[1];
+	status->flags = p[2];
+	status->distance_cm = p[3] | ((uint16_t)p[4] << 8);
+	status->accel_peak = p[5] | ((uint16_t)p[6] << 8);
+
+	return 1;
+}
+/*****************************************************************************/
@@ -0,0 +1,178 @@
+/******************************************************************************
+	LINK HEADER FILE
+
+	This file contains the interface to the framed messages between the
+	Robot and the Remote. The link is shared by both firmwares.
+
+	The single character events ('0' no errors, '1' collision, '2' obstacle,
+	'3' tipped over) are still sent as before. Messages with a payload are
+	sent as a frame:
+
+		0xA5, type, length, payload (length bytes), checksum
+
+	The checksum makes the sum of type, length, payload and checksum 0
+	(mod 256). A frame always starts with LINK_SYNC, which is never an
+	event character, so the receiver tells frames and events apart by the
+	first byte. Multi-byte values are little-endian.
+
+	LINK_SYNC is also a motor byte of the Remote. The Robot therefore
+	holds a LINK_SYNC until the bytes after it show whether it begins a
+	frame. It drops the frames of the Remote before they reach the motors,
+	see Robot/command.h.
+
+	Trace message (LINK_TYPE_TRACE), sent by the Robot when it is built
+	with TRACE_RECORDING: whole trace records, see Common/trace/trace.h.
+
+	Profile messages (LINK_TYPE_PROFILE, LINK_TYPE_PROFILE_END), sent by
+	both firmwares when they are built with PROFILE_RECORDING: profiler
+	events, see Common/profile/profile.h.
+
+	SRAM message (LINK_TYPE_SRAM), sent by both firmwares on request: the
+	SRAM usage, see Common/sram/sram.h.
+
+	Timing message (LINK_TYPE_TIMING), sent by both firmwares every second
+	when they are built with TIMING_STATISTICS: loop period and interrupt
+	latency, see Common/timing/timing.h.
+
+	Status message (LINK_TYPE_STATUS), sent by the Robot every 50 ms:
+		0	left PWM, 0..255
+		1	right PWM, 0..255
+		2	flags, LINK_STATUS_xxx
+		3-4	distance to obstacle in cm, 0 if no echo
+		5-6	largest deviation of an accelerometer axis from its zero
+			since the last status, raw MPU6050 units
+
+	Example (receiver):
+		static link_parser_t parser;
+		link_status_t status;
+
+		if (link_parse(&parser, byte) == LINK_PARSE_FRAME &&
+			link_decode_status(&parser, &status)) {
+			...
+		}
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef LINK_H_
+#define LINK_H_
+
+#include <stdint.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//First byte of a frame
+#define LINK_SYNC 0xA5
+
+//Largest payload of a frame
+#define LINK_MAX_PAYLOAD 16
+
+//Bytes of a frame around the payload
+#define LINK_FRAME_OVERHEAD 4
+
+//Message types
+#define LINK_TYPE_STATUS 0x01
+#define LINK_TYPE_TRACE 0x02
+#define LINK_TYPE_PROFILE 0x03
+#define LINK_TYPE_PROFILE_END 0x04
+#define LINK_TYPE_SRAM 0x05
+#define LINK_TYPE_TIMING 0x06
+#define LINK_STATUS_LENGTH 7
+#define LINK_STATUS_FRAME_LENGTH (LINK_STATUS_LENGTH + LINK_FRAME_OVERHEAD)
+
+//Status flags
+#define LINK_STATUS_LEFT_REVERSE	(1 << 0)
+#define LINK_STATUS_RIGHT_REVERSE	(1 << 1)
+#define LINK_STATUS_OBSTACLE		(1 << 2)
+#define LINK_STATUS_TIPPED			(1 << 3)
+
+//Result of link_parse()
+#define LINK_PARSE_IDLE		0	//byte is not part of a frame, e.g. an event
+#define LINK_PARSE_BUSY		1	//byte taken, frame not complete yet
+#define LINK_PARSE_FRAME	2	//frame complete and checksum correct
+#define LINK_PARSE_ERROR	3	//frame dropped, bad length or checksum
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	uint8_t left_pwm;
+	uint8_t right_pwm;
+	uint8_t flags;
+	uint16_t distance_cm;
+	uint16_t accel_peak;
+} link_status_t;
+
+typedef struct {
+	uint8_t state;
+	uint8_t type;
+	uint8_t length;
+	uint8_t received;
+	uint8_t sum;
+	uint8_t payload[LINK_MAX_PAYLOAD];
+	uint16_t errors;			//frames dropped
+} link_parser_t;
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	link_encode()
+
+	Builds a frame around a payload.
+
+	Inputs:		uint8_t type, LINK_TYPE_xxx
+				const uint8_t *payload
+				uint8_t length, at most LINK_MAX_PAYLOAD
+	Outputs:	uint8_t *frame, length + LINK_FRAME_OVERHEAD bytes
+				uint8_t, bytes in frame
+******************************************************************************/
+uint8_t link_encode(uint8_t type, const uint8_t *payload, uint8_t length, uint8_t *frame);
+
+/******************************************************************************
+	Function name:	link_encode_status()
+
+	Builds a status frame.
+
+	Inputs:		const link_status_t *status
+	Outputs:	uint8_t *frame, LINK_STATUS_FRAME_LENGTH bytes
+				uint8_t, bytes in frame
+******************************************************************************/
+uint8_t link_encode_status(const link_status_t *status, uint8_t *frame);
+
+/******************************************************************************
+	Function name:	link_parse()
+
+	Feeds one received byte to the parser. Bytes outside a frame are
+	returned as LINK_PARSE_IDLE and are for the caller, e.g. events.
+	After LINK_PARSE_FRAME the frame is in the parser until the next byte.
+
+	Inputs:		link_parser_t *parser, zero initialized before first use
+				uint8_t byte
+	Outputs:	uint8_t, LINK_PARSE_xxx
+******************************************************************************/
+uint8_t link_parse(link_parser_t *parser, uint8_t byte);
+
+/******************************************************************************
+	Function name:	link_decode_status()
+
+	Reads the status message of a completed frame.
+
+	Inputs:		const link_parser_t *parser
+	Outputs:	link_status_t *status
+				uint8_t, 1 if the frame is a status message, else 0
+******************************************************************************/
+uint8_t link_decode_status(const link_parser_t *parser, link_status_t *status);
+
+
+
+#endif /* LINK_H_ */
@@ -0,0 +1,127 @@
+/******************************************************************************
+	PROFILER IMPLEMENTATION FILE
+
+	This file contains the in-firmware profiler. See profile.h for the
+	markers, the drain request and the messages.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "profile.h"
+#include "../hal/hal.h"
+#include "../link/link.h"
+#include "../timer2/timer2.h"
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Events per profile message
+#define EVENTS_PER_MESSAGE (LINK_MAX_PAYLOAD / PROFILE_EVENT_LENGTH)
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	uint8_t marker;
+	uint16_t ticks;
+} event_t;
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static event_t events[PROFILE_BUFFER_EVENTS];
+static uint8_t count = 0;
+static uint16_t dropped = 0;
+static uint8_t requests = 0;		//PROFILE_REQUEST bytes in a row
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	profile_event()
+
+	This is a public function and is described in the header file,
+	profile.h.
+******************************************************************************/
+void profile_event(uint8_t marker) {
+	HAL_CRITICAL_SECTION {
+		if (count < PROFILE_BUFFER_EVENTS) {
+			events[count].marker = marker;
+			events[count].ticks = timer2_get_ticks();
+			count++;
+		} else if (dropped < UINT16_MAX) {
+			dropped++;
+		}
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	profile_request()
+
+	This is a public function and is described in the header file,
+	profile.h.
+******************************************************************************/
+uint8_t profile_request(uint8_t byte) {
+	requests = byte == PROFILE_REQUEST ? requests + 1 : 0;
+
+	if (requests == PROFILE_REQUEST_LENGTH) {
+		requests = 0;
+		return 1;
+	}
+	return 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	profile_drain()
+
+	This is a public function and is described in the header file,
+	profile.h. The buffer is marked full while the events are transmitted,
+	so the events meanwhile are dropped and counted.
+******************************************************************************/
+void profile_drain(void (*transmit)(const uint8_t *frame, uint8_t length)) {
+	uint8_t payload[LINK_MAX_PAYLOAD];
+	uint8_t frame[LINK_MAX_PAYLOAD + LINK_FRAME_OVERHEAD];
+	uint8_t events_taken;
+	uint8_t length = 0;
+
+	HAL_CRITICAL_SECTION {
+		events_taken = count;
+		count = PROFILE_BUFFER_EVENTS;
+	}
+
+	for (uint8_t i = 0; i < events_taken; i++) {
+		payload[length++] = events[i].marker;
+		payload[length++] = events[i].ticks & 0xFF;
+		payload[length++] = events[i].ticks >> 8;
+
+		if (length == EVENTS_PER_MESSAGE * PROFILE_EVENT_LENGTH || i == events_taken - 1) {
+			transmit(frame, link_encode(LINK_TYPE_PROFILE, payload, length, frame));
+			length = 0;
+		}
+	}
+
+	HAL_CRITICAL_SECTION {
+		payload[0] = dropped & 0xFF;
+		payload[1] = dropped >> 8;
+		dropped = 0;
+		count = 0;
+	}
+	transmit(frame, link_encode(LINK_TYPE_PROFILE_END, payload, 2, frame));
+}
+/*****************************************************************************/
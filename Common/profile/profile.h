@@ -0,0 +1,150 @@
+/******************************************************************************
+	PROFILER HEADER FILE
+
+	This file contains the interface of the in-firmware profiler of both
+	firmwares. A section of code is marked like a hot path of the cycle
+	benchmarks (Common/bench/bench.h):
+
+		PROFILE_BEGIN(PROFILE_CONTROL_MOTORS);
+		...
+		PROFILE_END(PROFILE_CONTROL_MOTORS);
+
+	Every marker stores an event, the marker value and the TIMER2 tick
+	count (timer2_get_ticks(), 4 us per tick), in a buffer in SRAM, a
+	marker costs a call and a few loads and stores. The markers may be
+	used in interrupt service routines. A section must not nest in itself
+	and must be shorter than the 16-bit tick count wraps, 262 ms.
+
+	The buffer fills up and then keeps its events, a window of
+	consecutive events, until it is drained (later events are dropped and
+	counted). It is drained on demand, when the firmware receives
+	PROFILE_REQUEST_LENGTH PROFILE_REQUEST bytes in a row. The Remote
+	never sends them (its motor bytes alternate between the left and the
+	right motor), the Robot keeps them and the profile messages of a
+	Remote from its motors (Robot/command.h). Send the request e.g.
+	through a ZigBee module:
+
+		printf '\2\2\2\2' > /dev/ttyUSB0
+
+	The events are transmitted in profile messages of the link
+	(LINK_TYPE_PROFILE, Common/link/link.h), PROFILE_EVENT_LENGTH bytes
+	per event:
+		0	marker, section id, PROFILE_END_FLAG set at the end
+		1-2	TIMER2 ticks
+	and a LINK_TYPE_PROFILE_END message ends the window, 2 bytes: the
+	events dropped since the previous drain. Then the buffer records the
+	next window. tools/profile/profiletable turns the windows into a table
+	per section.
+
+	The markers are compiled only when PROFILE_RECORDING is defined (the
+	*_fw_profile targets of CMakeLists.txt), otherwise they are empty and
+	the firmware is not changed by them. Without PROFILE_RECORDING the
+	file can be included by host tools for the section table.
+
+	A new section is added to PROFILE_SECTIONS, with an id below
+	PROFILE_END_FLAG.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include <stdint.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Events of the buffer
+#ifndef PROFILE_BUFFER_EVENTS
+#define PROFILE_BUFFER_EVENTS 64
+#endif
+
+//Set in the marker value at the end of a section
+#define PROFILE_END_FLAG 0x80
+
+//Micros per TIMER2 tick
+#define PROFILE_TICK_US 4
+
+//Bytes of an event in a profile message
+#define PROFILE_EVENT_LENGTH 3
+
+//Drain request, see above
+#define PROFILE_REQUEST 0x02
+#define PROFILE_REQUEST_LENGTH 4
+
+//Sections: name, id, name in the table
+#define PROFILE_SECTIONS(X) \
+	X(PROFILE_ROBOT_LOOP,					1, "robot_loop") \
+	X(PROFILE_HC_SR04_GET_DISTANCE,			2, "hc_sr04_get_distance") \
+	X(PROFILE_CONTROL_MOTORS,				3, "control_motors") \
+	X(PROFILE_IS_COLLISION_DETECTED,		4, "is_collision_detected") \
+	X(PROFILE_MPU6050_READ_BYTES,			5, "mpu6050_readBytes") \
+	X(PROFILE_HANDLE_ACC_SAMPLE,			6, "handle_acc_sample") \
+	X(PROFILE_REMOTE_LOOP,					7, "remote_loop") \
+	X(PROFILE_HANDLE_USART_RECEIVE,			8, "handle_usart_receive") \
+	X(PROFILE_OUTPUT_BYTE_CREATOR_CREATE,	9, "output_byte_creator_create") \
+	X(PROFILE_PRINTOUT_LCD_POS_PUTS,		10, "printout_lcd_pos_puts") \
+	X(PROFILE_TEXTBUFFER_REFRESH,			11, "textbuffer_refresh") \
+	X(PROFILE_REFRESH_TELEMETRY_VIEW,		12, "refresh_telemetry_view")
+
+#define PROFILE_SECTION_ID(name, id, string) name = id,
+
+enum {
+	PROFILE_SECTIONS(PROFILE_SECTION_ID)
+};
+
+#ifdef PROFILE_RECORDING
+#define PROFILE_BEGIN(id)	profile_event(id)
+#define PROFILE_END(id)		profile_event((id) | PROFILE_END_FLAG)
+#define PROFILE_POLL(byte, transmit) \
+	do { if (profile_request(byte)) { profile_drain(transmit); } } while (0)
+#define PROFILE_DRAIN(transmit)	profile_drain(transmit)
+#else
+#define PROFILE_BEGIN(id)
+#define PROFILE_END(id)
+#define PROFILE_POLL(byte, transmit)
+#define PROFILE_DRAIN(transmit)
+#endif
+
+
+
+/******************************************************************************
+	Function name:	profile_event()
+
+	Stores an event, use the PROFILE_BEGIN() and PROFILE_END() markers.
+
+	Inputs:		uint8_t marker
+	Outputs:	none
+******************************************************************************/
+void profile_event(uint8_t marker);
+
+/******************************************************************************
+	Function name:	profile_request()
+
+	Feeds a received byte to the drain request detection, use
+	PROFILE_POLL() with every received byte. A receiver that detects the
+	request itself (Robot/command.c) uses PROFILE_DRAIN() instead.
+
+	Inputs:		uint8_t byte
+	Outputs:	uint8_t, 1 if the request is complete
+******************************************************************************/
+uint8_t profile_request(uint8_t byte);
+
+/******************************************************************************
+	Function name:	profile_drain()
+
+	Transmits the events as profile messages and empties the buffer.
+
+	Inputs:		void (*transmit)(const uint8_t *, uint8_t), transmits a
+				frame, e.g. usart_transmit_buffer()
+	Outputs:	none
+******************************************************************************/
+void profile_drain(void (*transmit)(const uint8_t *frame, uint8_t length));
+
+
+
+#endif /* PROFILE_H_ */
\ No newline at end of file
@@ -0,0 +1,119 @@
+/******************************************************************************
+	SRAM MONITOR IMPLEMENTATION FILE
+
+	This file contains the SRAM usage monitor. See sram.h for the paint,
+	the request and the message.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "sram.h"
+#include "../hal/hal.h"
+#include "../link/link.h"
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static uint16_t painted = 0;		//bytes painted above .bss
+static uint8_t requests = 0;		//SRAM_REQUEST bytes in a row
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	sram_init()
+
+	This is a public function and is described in the header file,
+	sram.h.
+******************************************************************************/
+void sram_init(void) {
+	uint8_t *p = hal_sram_heap_start();
+	uint8_t *end = hal_stack_pointer() - SRAM_PAINT_MARGIN;
+
+	while (p < end) {
+		*p++ = SRAM_PAINT;
+	}
+	painted = p - hal_sram_heap_start();
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	sram_stack_free()
+
+	This is a public function and is described in the header file,
+	sram.h.
+******************************************************************************/
+uint16_t sram_stack_free(void) {
+	const uint8_t *bottom = hal_sram_heap_start();
+	uint16_t free = 0;
+
+	while (free < painted && bottom[free] == SRAM_PAINT) {
+		free++;
+	}
+	return free;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	sram_static_size()
+
+	This is a public function and is described in the header file,
+	sram.h.
+******************************************************************************/
+uint16_t sram_static_size(void) {
+	return hal_sram_heap_start() - hal_sram_data_start();
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	sram_request()
+
+	This is a public function and is described in the header file,
+	sram.h.
+******************************************************************************/
+uint8_t sram_request(uint8_t byte) {
+	requests = byte == SRAM_REQUEST ? requests + 1 : 0;
+
+	if (requests == SRAM_REQUEST_LENGTH) {
+		requests = 0;
+		return 1;
+	}
+	return 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	sram_report()
+
+	This is a public function and is described in the header file,
+	sram.h.
+******************************************************************************/
+void sram_report(void (*transmit)(const uint8_t *frame, uint8_t length)) {
+	uint8_t payload[SRAM_REPORT_LENGTH];
+	uint8_t frame[SRAM_REPORT_LENGTH + LINK_FRAME_OVERHEAD];
+	uint16_t size = sram_static_size();
+	uint16_t free = sram_stack_free();
+
+	payload[0] = size & 0xFF;
+	payload[1] = size >> 8;
+	payload[2] = painted & 0xFF;
+	payload[3] = painted >> 8;
+	payload[4] = free & 0xFF;
+	payload[5] = free >> 8;
+	transmit(frame, link_encode(LINK_TYPE_SRAM, payload, SRAM_REPORT_LENGTH, frame));
+}
+/*****************************************************************************/
@@ -0,0 +1,134 @@
+/******************************************************************************
+	SRAM MONITOR HEADER FILE
+
+	This file contains the interface of the SRAM usage monitor of both
+	firmwares. The 2 KB of SRAM hold .data and .bss from the bottom and the
+	stack from the top (RAMEND) downwards, the firmwares do not use the
+	heap, so the bytes between .bss and the stack are what is left before
+	the stack overwrites the globals.
+
+	sram_init() paints those bytes with SRAM_PAINT at boot, the first thing
+	main() does. The stack overwrites the paint where it reaches, so the
+	paint still intact above .bss is the least free stack since boot,
+	returned by sram_stack_free(). The scan stops at the first byte that
+	is not SRAM_PAINT, a local that happens to hold SRAM_PAINT at the
+	deepest point of the stack makes the result a byte too large.
+
+	The usage is transmitted on demand, when the firmware receives
+	SRAM_REQUEST_LENGTH SRAM_REQUEST bytes in a row. The Remote never sends
+	them (its motor bytes alternate between the left and the right motor),
+	the Robot keeps them and the SRAM messages of a Remote from its motors
+	(Robot/command.h). Send the request e.g. through a ZigBee module:
+
+		printf '\3\3\3\3' > /dev/ttyUSB0
+
+	The reply is an SRAM message of the link (LINK_TYPE_SRAM,
+	Common/link/link.h), SRAM_REPORT_LENGTH bytes:
+		0-1	.data and .bss, bytes
+		2-3	bytes painted at boot, free for the stack
+		4-5	least free stack since boot, bytes
+	tools/linkdump prints it. The .data and .bss of each module are
+	reported when the firmware is linked, see cmake/sram_report.cmake.
+
+	The request is answered only when SRAM_MONITOR is defined (the
+	*_fw_sram targets of CMakeLists.txt), otherwise SRAM_POLL() and
+	SRAM_REPORT() are empty. The paint of sram_init() is always there, so
+	the stack of a normal firmware can be read with a debugger.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef SRAM_H_
+#define SRAM_H_
+
+#include <stdint.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Value of the unused SRAM
+#define SRAM_PAINT 0xC5
+
+//Bytes below the stack pointer of sram_init() that are not painted, the
+//stack used by the painting itself
+#define SRAM_PAINT_MARGIN 16
+
+//Request, see above
+#define SRAM_REQUEST 0x03
+#define SRAM_REQUEST_LENGTH 4
+
+//Bytes of the SRAM message
+#define SRAM_REPORT_LENGTH 6
+
+#ifdef SRAM_MONITOR
+#define SRAM_POLL(byte, transmit) \
+	do { if (sram_request(byte)) { sram_report(transmit); } } while (0)
+#define SRAM_REPORT(transmit)	sram_report(transmit)
+#else
+#define SRAM_POLL(byte, transmit)
+#define SRAM_REPORT(transmit)
+#endif
+
+
+
+/******************************************************************************
+	Function name:	sram_init()
+
+	Paints the SRAM between .bss and the stack, call it first in main()
+	before interrupts are enabled.
+
+	Inputs:		none
+	Outputs:	none
+******************************************************************************/
+void sram_init(void);
+
+/******************************************************************************
+	Function name:	sram_stack_free()
+
+	Returns the least free stack since sram_init(), the bytes of the paint
+	above .bss that the stack did not reach.
+
+	Inputs:		none
+	Outputs:	uint16_t, bytes
+******************************************************************************/
+uint16_t sram_stack_free(void);
+
+/******************************************************************************
+	Function name:	sram_static_size()
+
+	Returns the SRAM used by .data and .bss.
+
+	Inputs:		none
+	Outputs:	uint16_t, bytes
+******************************************************************************/
+uint16_t sram_static_size(void);
+
+/******************************************************************************
+	Function name:	sram_request()
+
+	Feeds a received byte to the request detection, use SRAM_POLL() with
+	every received byte. A receiver that detects the request itself
+	(Robot/command.c) uses SRAM_REPORT() instead.
+
+	Inputs:		uint8_t byte
+	Outputs:	uint8_t, 1 if the request is complete
+******************************************************************************/
+uint8_t sram_request(uint8_t byte);
+
+/******************************************************************************
+	Function name:	sram_report()
+
+	Transmits the SRAM message.
+
+	Inputs:		void (*transmit)(const uint8_t *, uint8_t), transmits a
+				frame, e.g. usart_transmit_buffer()
+	Outputs:	none
+******************************************************************************/
+void sram_report(void (*transmit)(const uint8_t *frame, uint8_t length));
+
+
+
+#endif /* SRAM_H_ */
@@ -0,0 +1,164 @@
+/******************************************************************************
+	TIMER2 IMPLEMENTATION FILE
+
+	This file contains implementations to handle Timer2, the free running
+	system clock.
+
+	For more information regarding the implementation, please refer to
+	Atmel-8271J-AVR- ATmega-Datasheet_11/2015.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+#include "timer2.h"
+#include "../hal/hal.h"
+
+
+
+/******************************************************************************
+	PRESCALER
+
+	Prescaler 64 @ 16 MHz gives 4 micros/TCNT2 count and an overflow every
+	1024 micros. The 32-bit microsecond clock wraps after about 71 minutes
+	and the millisecond clock after about 49 days, so always compare
+	timestamps by subtraction.
+******************************************************************************/
+#define MICROS_PER_TCNT2 (64 / (F_CPU / 1000000))
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+//overflow_count holds number of TCNT2 overflows
+static volatile uint32_t overflow_count = 0;
+
+//millis holds whole milliseconds, millis_fraction the micros left over
+//(each overflow is 1 millisecond and 24 micros)
+static volatile uint32_t millis = 0;
+static volatile uint16_t millis_fraction = 0;
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	INTERRUPT SERVICE ROUTINE
+******************************************************************************/
+ISR(TIMER2_OVF_vect) {
+	overflow_count++;
+
+	millis++;
+	millis_fraction += 24;
+	if (millis_fraction >= 1000) {
+		millis_fraction -= 1000;
+		millis++;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function initializes and starts TIMER2 in normal mode with
+	prescaler 64.
+
+	Inputs:		void
+	Outputs:	void
+	Calls:		sei()
+******************************************************************************/
+void timer2_init(void) {
+	hal_timer_normal_mode(2);				//Normal mode, OC2A/OC2B disconnected
+	hal_timer_set_count(2, 0);
+	hal_timer_clear_overflow(2);			//Clear Timer/Counter2, Overflow Flag
+	hal_timer_overflow_interrupt(2);		//Timer/Counter2, Overflow Interrupt Enable
+
+	hal_timer_set_clock(2, HAL_TIMER2_CLOCK_64);	//Prescaler 64, starts the timer
+
+	hal_interrupts_enable();				//Enable interrupts globally
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function returns the number of microseconds since timer2_init().
+
+	An overflow that has happened but is not yet counted by the ISR (because
+	interrupts are disabled by the caller) is taken into account.
+
+	Inputs:		none
+	Outputs:	uint32_t
+	Calls:		none
+******************************************************************************/
+uint32_t timer2_get_micros(void) {
+	uint32_t overflows;
+	uint8_t count;
+
+	HAL_CRITICAL_SECTION {
+		overflows = overflow_count;
+		count = hal_timer_count(2);
+
+		if (hal_timer_overflow_pending(2) && count < 255) {
+			overflows++;
+		}
+	}
+
+	return ((overflows << 8) + count) * MICROS_PER_TCNT2;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function returns the number of milliseconds since timer2_init().
+	The resolution is the overflow period, 1024 micros.
+
+	Inputs:		none
+	Outputs:	uint32_t
+	Calls:		none
+******************************************************************************/
+uint32_t timer2_get_millis(void) {
+	uint32_t m;
+
+	HAL_CRITICAL_SECTION {
+		m = millis;
+	}
+
+	return m;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function returns the TIMER2 ticks (4 micros each) since
+	timer2_init(), as a 16-bit count that wraps every 262144 micros. It is
+	the cheapest timestamp, e.g. for the profiler (Common/profile), and can
+	be called from interrupt service routines.
+
+	Inputs:		none
+	Outputs:	uint16_t
+	Calls:		none
+******************************************************************************/
+uint16_t timer2_get_ticks(void) {
+	uint8_t overflows;
+	uint8_t count;
+
+	HAL_CRITICAL_SECTION {
+		overflows = overflow_count;
+		count = hal_timer_count(2);
+
+		if (hal_timer_overflow_pending(2) && count < 255) {
+			overflows++;
+		}
+	}
+
+	return ((uint16_t)overflows << 8) | count;
+}
+/*****************************************************************************/
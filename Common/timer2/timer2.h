@@ -0,0 +1,25 @@
+/******************************************************************************
+	TIMER2 HEADER FILE
+
+	This file contains the interface to interact with and use timer2.c.
+
+	TIMER2 runs free as the system clock of the firmware. It is used to
+	timestamp events and to measure durations, e.g. I2C bus throughput.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef TIMER2_H_
+#define TIMER2_H_
+
+#include <stdint.h>
+
+void timer2_init(void);
+uint32_t timer2_get_micros(void);
+uint32_t timer2_get_millis(void);
+uint16_t timer2_get_ticks(void);
+
+
+
+#endif /* TIMER2_H_ */
@@ -0,0 +1,230 @@
+/******************************************************************************
+	TIMING STATISTICS IMPLEMENTATION FILE
+
+	This file contains the timing statistics. See timing.h for the
+	sections, the latency samples and the message.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "timing.h"
+#include "../hal/hal.h"
+#include "../link/link.h"
+#include "../timer2/timer2.h"
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define MICROS_PER_TICK 4
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static void end_section(uint32_t now);
+static void end_iteration(uint32_t now);
+static void transmit_report(void);
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static void (*transmit_frame)(const uint8_t *frame, uint8_t length) = 0;
+static uint32_t period_start = 0;			//millis
+
+//Iteration and section being timed, micros
+static uint8_t running = 0;
+static uint32_t iteration_start = 0;
+static uint32_t section_start = 0;
+static uint8_t section = 0;
+static uint32_t section_most = 0;			//longest section of the iteration
+static uint8_t section_most_id = 0;
+
+//Statistics of the period
+static uint16_t iterations = 0;
+static uint16_t buckets[TIMING_BUCKETS];
+static uint32_t longest = 0;
+static uint8_t longest_section = 0;
+
+//Latency samples of the period, ticks
+static volatile uint8_t latency_max = 0;
+static volatile uint32_t latency_sum = 0;
+static volatile uint16_t latency_samples = 0;
+
+
+
+/******************************************************************************
+	INTERRUPT SERVICE ROUTINE
+	Only with the statistics, a vector is linked even if nothing uses it.
+******************************************************************************/
+#ifdef TIMING_STATISTICS
+ISR(TIMER2_COMPB_vect) {
+	uint8_t match = hal_timer_compare(2, B);
+	uint8_t late = hal_timer_count(2) - match;
+
+	hal_timer_set_compare(2, B, match + TIMING_SAMPLE_TICKS);
+
+	if (late > latency_max) {
+		latency_max = late;
+	}
+	latency_sum += late;
+	if (latency_samples < UINT16_MAX) {
+		latency_samples++;
+	}
+}
+#endif
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	timing_init()
+
+	This is a public function and is described in the header file,
+	timing.h.
+******************************************************************************/
+void timing_init(void (*transmit)(const uint8_t *frame, uint8_t length)) {
+	transmit_frame = transmit;
+	period_start = timer2_get_millis();
+
+	hal_timer_set_compare(2, B, hal_timer_count(2) + TIMING_SAMPLE_TICKS);
+	hal_timer_compare_interrupt(2, B);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	timing_loop()
+
+	This is a public function and is described in the header file,
+	timing.h. The first call only begins an iteration, the time before it
+	is the start-up.
+******************************************************************************/
+void timing_loop(uint8_t id) {
+	uint32_t now = timer2_get_micros();
+
+	if (running) {
+		end_section(now);
+		end_iteration(now);
+	}
+
+	if (timer2_get_millis() - period_start >= TIMING_PERIOD_MS) {
+		transmit_report();
+		period_start = timer2_get_millis();
+		now = timer2_get_micros();
+	}
+
+	running = 1;
+	iteration_start = now;
+	section_start = now;
+	section = id;
+	section_most = 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	timing_section()
+
+	This is a public function and is described in the header file,
+	timing.h.
+******************************************************************************/
+void timing_section(uint8_t id) {
+	end_section(timer2_get_micros());
+	section = id;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+static void end_section(uint32_t now) {
+	uint32_t duration = now - section_start;
+
+	if (duration > section_most) {
+		section_most = duration;
+		section_most_id = section;
+	}
+	section_start = now;
+}
+/*****************************************************************************/
+
+static void end_iteration(uint32_t now) {
+	uint32_t period = now - iteration_start;
+	uint32_t units = period / TIMING_BUCKET_US;
+	uint8_t bucket = 0;
+
+	while (units && bucket < TIMING_BUCKETS - 1) {
+		units >>= 1;
+		bucket++;
+	}
+	if (iterations < UINT16_MAX) {
+		iterations++;
+		buckets[bucket]++;
+	}
+
+	if (period > longest) {
+		longest = period;
+		longest_section = section_most_id;
+	}
+}
+/*****************************************************************************/
+
+static void transmit_report(void) {
+	uint8_t payload[TIMING_REPORT_LENGTH];
+	uint8_t frame[TIMING_REPORT_LENGTH + LINK_FRAME_OVERHEAD];
+	uint32_t ticks = longest / MICROS_PER_TICK;
+	uint32_t mean = 0;
+	uint32_t sum;
+	uint16_t samples;
+	uint8_t max;
+
+	HAL_CRITICAL_SECTION {
+		max = latency_max;
+		sum = latency_sum;
+		samples = latency_samples;
+		latency_max = 0;
+		latency_sum = 0;
+		latency_samples = 0;
+	}
+	if (samples) {
+		mean = 16 * sum / samples;
+	}
+
+	payload[0] = iterations & 0xFF;
+	payload[1] = iterations >> 8;
+	for (uint8_t i = 0; i < TIMING_BUCKETS; i++) {
+		payload[2 + i] = iterations ? ((uint32_t)buckets[i] * 255 + iterations / 2) / iterations : 0;
+		buckets[i] = 0;
+	}
+	if (ticks > UINT16_MAX) {
+		ticks = UINT16_MAX;
+	}
+	payload[10] = ticks & 0xFF;
+	payload[11] = ticks >> 8;
+	payload[12] = longest_section;
+	payload[13] = max;
+	payload[14] = mean > UINT8_MAX ? UINT8_MAX : mean;
+
+	iterations = 0;
+	longest = 0;
+	longest_section = 0;
+
+	if (transmit_frame) {
+		transmit_frame(frame, link_encode(LINK_TYPE_TIMING, payload, TIMING_REPORT_LENGTH, frame));
+	}
+}
+/*****************************************************************************/
@@ -0,0 +1,140 @@
+/******************************************************************************
+	TIMING STATISTICS HEADER FILE
+
+	This file contains the interface of the timing statistics of both
+	firmwares: the period of the main loop, its longest iteration and the
+	latency of the interrupt service routines. The main loop is cut into
+	sections, each section lasts until the next marker:
+
+		while (1) {
+			TIMING_LOOP(TIMING_ROBOT_DISTANCE);		//an iteration begins
+			...
+			TIMING_SECTION(TIMING_ROBOT_MOTORS);
+			...
+		}
+
+	Every iteration is counted in a histogram of its period, power of two
+	buckets of TIMING_BUCKET_US << bucket micros. The longest iteration is
+	kept with the section that took the most of it, interrupts included in
+	the section they interrupted.
+
+	The latency is sampled on the compare unit B of TIMER2, which no module
+	uses (the Robot has no timer left): its interrupt is requested every
+	TIMING_SAMPLE_TICKS ticks of 4 us, and the ISR reads how many ticks
+	after the match it was entered. An interrupt service routine or a
+	critical section running at the match delays it, so the latency is the
+	time interrupts stayed masked, at the resolution of a tick.
+
+	Every TIMING_PERIOD_MS the statistics are transmitted in a timing
+	message of the link (LINK_TYPE_TIMING, Common/link/link.h) and
+	cleared, TIMING_REPORT_LENGTH bytes:
+		0-1		iterations
+		2-9		iterations per period bucket, share in 1/255
+		10-11	longest iteration in ticks, 0xFFFF if 262 ms or more
+		12		section that took the most of the longest iteration
+		13		longest latency in ticks
+		14		mean latency in 1/16 ticks
+	The transmission is not counted in the iteration. tools/linkdump
+	prints the message. A frame from the Remote reaches the Robot too,
+	whose command receiver drops it before the motors (Robot/command.h).
+
+	The markers are compiled only when TIMING_STATISTICS is defined (the
+	*_fw_timing targets of CMakeLists.txt), otherwise they are empty and
+	the firmware is not changed by them.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef TIMING_H_
+#define TIMING_H_
+
+#include <stdint.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Time between two timing messages
+#define TIMING_PERIOD_MS 1000
+
+//Upper bound of the first period bucket, doubled per bucket
+#define TIMING_BUCKET_US 256
+#define TIMING_BUCKETS 8
+
+//Ticks between two latency samples, not a divisor of 256 so the samples
+//fall on every phase of TIMER2
+#define TIMING_SAMPLE_TICKS 199
+
+//Bytes of the timing message
+#define TIMING_REPORT_LENGTH 15
+
+//Sections: name, id, name in tools/linkdump
+#define TIMING_SECTIONS(X) \
+	X(TIMING_ROBOT_DISTANCE,	1, "robot_distance") \
+	X(TIMING_ROBOT_TRANSMIT,	2, "robot_transmit") \
+	X(TIMING_ROBOT_DELAY,		3, "robot_delay") \
+	X(TIMING_ROBOT_MOTORS,		4, "robot_motors") \
+	X(TIMING_ROBOT_COLLISION,	5, "robot_collision") \
+	X(TIMING_REMOTE_RECEIVE,	6, "remote_receive") \
+	X(TIMING_REMOTE_JOYSTICK,	7, "remote_joystick") \
+	X(TIMING_REMOTE_TELEMETRY,	8, "remote_telemetry") \
+	X(TIMING_REMOTE_TEXTBUFFER,	9, "remote_textbuffer")
+
+#define TIMING_SECTION_ID(name, id, string) name = id,
+
+enum {
+	TIMING_SECTIONS(TIMING_SECTION_ID)
+};
+
+#ifdef TIMING_STATISTICS
+#define TIMING_INIT(transmit)	timing_init(transmit)
+#define TIMING_LOOP(id)			timing_loop(id)
+#define TIMING_SECTION(id)		timing_section(id)
+#else
+#define TIMING_INIT(transmit)
+#define TIMING_LOOP(id)
+#define TIMING_SECTION(id)
+#endif
+
+
+
+/******************************************************************************
+	Function name:	timing_init()
+
+	Starts the latency samples, call it after timer2_init(). Use the
+	TIMING_INIT() marker.
+
+	Inputs:		void (*transmit)(const uint8_t *, uint8_t), transmits a
+				frame, e.g. usart_transmit_buffer()
+	Outputs:	none
+******************************************************************************/
+void timing_init(void (*transmit)(const uint8_t *frame, uint8_t length));
+
+/******************************************************************************
+	Function name:	timing_loop()
+
+	Ends the iteration of the main loop and begins the next one with a
+	section, transmits the timing message when it is due. Use the
+	TIMING_LOOP() marker first in the loop.
+
+	Inputs:		uint8_t section
+	Outputs:	none
+******************************************************************************/
+void timing_loop(uint8_t section);
+
+/******************************************************************************
+	Function name:	timing_section()
+
+	Ends the section of the main loop and begins the next one. Use the
+	TIMING_SECTION() marker.
+
+	Inputs:		uint8_t section
+	Outputs:	none
+******************************************************************************/
+void timing_section(uint8_t section);
+
+
+
+#endif /* TIMING_H_ */
@@ -0,0 +1,294 @@
+/******************************************************************************
+	TRACE IMPLEMENTATION FILE
+
+	This file contains the recorder of the binary trace. See trace.h for
+	the record format.
+
+	Records are written whole or not at all: a record that does not fit in
+	the ring buffer is counted as lost, and the records it would have been
+	compared with (the previous accelerometer sample, distance and motor
+	speeds) are forgotten, so the next ones are written in full. Every
+	TRACE_SYNC_RECORDS records the time and the accelerometer are written
+	in full as well, so a trace message lost on the link only shifts the
+	records up to the next sync.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "trace.h"
+#include "../hal/hal.h"
+#include "../timer2/timer2.h"
+#include <stdlib.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define TRACE_BUFFER_MASK (TRACE_BUFFER_SIZE - 1)
+
+//Records between two syncs
+#define TRACE_SYNC_RECORDS 32
+
+//Free bytes kept for the other records, accelerometer samples are lost
+//first when the link falls behind
+#define TRACE_ACCEL_RESERVE (TRACE_BUFFER_SIZE / 2)
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static uint8_t write_record(uint8_t type, const uint8_t *payload, uint8_t length);
+static void put(uint8_t byte);
+static void forget(void);
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+//Records from tail up to head wait to be taken
+static uint8_t buffer[TRACE_BUFFER_SIZE];
+static uint8_t head = 0;
+static uint8_t tail = 0;
+
+static uint32_t last_ms = 0;
+static uint8_t lost = 0;
+static uint8_t until_sync = 0;		//0: the next record is a sync
+
+static uint8_t accel_count = 0;
+static uint8_t accel_known = 0;
+static int16_t last_accel[3];
+static uint8_t distance_known = 0;
+static uint16_t last_distance;
+static uint8_t motors_known = 0;
+static uint8_t last_motors[3];
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	trace_command()
+
+	This is a public function and is described in the header file, trace.h.
+******************************************************************************/
+void trace_command(uint8_t byte) {
+	HAL_CRITICAL_SECTION {
+		write_record(TRACE_TYPE_COMMAND, &byte, 1);
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	trace_distance()
+
+	This is a public function and is described in the header file, trace.h.
+******************************************************************************/
+void trace_distance(uint16_t cm) {
+	uint8_t payload[2] = { cm & 0xFF, cm >> 8 };
+
+	HAL_CRITICAL_SECTION {
+		if (!distance_known || cm != last_distance) {
+			last_distance = cm;
+			distance_known = write_record(TRACE_TYPE_DISTANCE, payload, 2);
+		}
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	trace_accel()
+
+	This is a public function and is described in the header file, trace.h.
+******************************************************************************/
+void trace_accel(int16_t x, int16_t y, int16_t z) {
+	int16_t accel[3] = { x, y, z };
+	uint8_t payload[6];
+	uint8_t jump = 0;
+	uint8_t full;
+
+	HAL_CRITICAL_SECTION {
+		for (uint8_t i = 0; i < 3; i++) {
+			if (labs((int32_t)accel[i] - last_accel[i]) > TRACE_ACCEL_JUMP) {
+				jump = 1;
+			}
+		}
+
+		if (!accel_known || jump || ++accel_count >= TRACE_ACCEL_DIVIDER) {
+			accel_count = 0;
+
+			full = !accel_known || until_sync == 0;
+			for (uint8_t i = 0; i < 3 && !full; i++) {
+				int32_t delta = (int32_t)accel[i] - last_accel[i];
+
+				full = delta < -128 || delta > 127;
+				payload[i] = (uint8_t)delta;
+			}
+
+			if (((tail - head - 1) & TRACE_BUFFER_MASK) < TRACE_ACCEL_RESERVE) {
+				if (lost < 255) {
+					lost++;
+				}
+				accel_known = 0;
+			} else if (full) {
+				for (uint8_t i = 0; i < 3; i++) {
+					payload[2 * i] = accel[i] & 0xFF;
+					payload[2 * i + 1] = (uint16_t)accel[i] >> 8;
+				}
+				accel_known = write_record(TRACE_TYPE_ACCEL, payload, 6);
+			} else {
+				accel_known = write_record(TRACE_TYPE_ACCEL_DELTA, payload, 3);
+			}
+
+			for (uint8_t i = 0; i < 3; i++) {
+				last_accel[i] = accel[i];
+			}
+		}
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	trace_motors()
+
+	This is a public function and is described in the header file, trace.h.
+******************************************************************************/
+void trace_motors(int16_t left, int16_t right) {
+	uint8_t payload[3] = { abs(left), abs(right), 0 };
+
+	if (left < 0) {
+		payload[2] |= TRACE_MOTORS_LEFT_REVERSE;
+	}
+	if (right < 0) {
+		payload[2] |= TRACE_MOTORS_RIGHT_REVERSE;
+	}
+
+	HAL_CRITICAL_SECTION {
+		if (!motors_known || payload[0] != last_motors[0] ||
+			payload[1] != last_motors[1] || payload[2] != last_motors[2]) {
+			for (uint8_t i = 0; i < 3; i++) {
+				last_motors[i] = payload[i];
+			}
+			motors_known = write_record(TRACE_TYPE_MOTORS, payload, 3);
+		}
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	trace_event()
+
+	This is a public function and is described in the header file, trace.h.
+******************************************************************************/
+void trace_event(char c) {
+	HAL_CRITICAL_SECTION {
+		write_record(TRACE_TYPE_EVENT, (const uint8_t *)&c, 1);
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	trace_take()
+
+	This is a public function and is described in the header file, trace.h.
+******************************************************************************/
+uint8_t trace_take(uint8_t *payload, uint8_t max) {
+	uint8_t taken = 0;
+
+	HAL_CRITICAL_SECTION {
+		while (tail != head) {
+			uint8_t length = trace_record_length(buffer[tail]);
+
+			if (taken + length > max) {
+				break;
+			}
+			for (uint8_t i = 0; i < length; i++) {
+				payload[taken++] = buffer[tail];
+				tail = (tail + 1) & TRACE_BUFFER_MASK;
+			}
+		}
+	}
+
+	return taken;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Writes a record with the time and lost records before it if needed.
+	Returns 1 if written, 0 if lost. Called with interrupts disabled.
+******************************************************************************/
+static uint8_t write_record(uint8_t type, const uint8_t *payload, uint8_t length) {
+	uint32_t now = timer2_get_millis();
+	uint32_t delta = now - last_ms;
+	uint8_t sync = until_sync == 0 || delta > TRACE_DELTA_MAX;
+	uint8_t needed = 1 + length + (sync ? 5 : 0) + (lost ? 2 : 0);
+
+	if (((tail - head - 1) & TRACE_BUFFER_MASK) < needed) {
+		if (lost < 255) {
+			lost++;
+		}
+		forget();
+		return 0;
+	}
+
+	if (sync) {
+		put(TRACE_TYPE_TIME << TRACE_HEADER_SHIFT);
+		for (uint8_t i = 0; i < 4; i++) {
+			put(now >> (8 * i));
+		}
+		delta = 0;
+		until_sync = TRACE_SYNC_RECORDS;
+	}
+	if (lost) {
+		put((TRACE_TYPE_LOST << TRACE_HEADER_SHIFT) | delta);
+		put(lost);
+		lost = 0;
+		delta = 0;
+	}
+
+	put((type << TRACE_HEADER_SHIFT) | delta);
+	for (uint8_t i = 0; i < length; i++) {
+		put(payload[i]);
+	}
+
+	last_ms = now;
+	until_sync--;
+	return 1;
+}
+
+static void put(uint8_t byte) {
+	buffer[head] = byte;
+	head = (head + 1) & TRACE_BUFFER_MASK;
+}
+
+/******************************************************************************
+	After a lost record the next accelerometer sample, distance and motor
+	speeds are written in full.
+******************************************************************************/
+static void forget(void) {
+	accel_known = 0;
+	distance_known = 0;
+	motors_known = 0;
+}
+/*****************************************************************************/
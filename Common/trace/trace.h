@@ -0,0 +1,187 @@
+/******************************************************************************
+	TRACE HEADER FILE
+
+	This file contains the interface to the binary trace of the Robot: what
+	it received, measured and did, timestamped, so that a drive can be
+	replayed on the host (tools/trace). The Robot records into a ring
+	buffer in SRAM and transmits the records in trace messages of the link
+	(LINK_TYPE_TRACE, Common/link/link.h) when the transmit queue has room.
+
+	A record is a header byte and the payload of its type:
+
+		header: bits 7..5 type, bits 4..0 ms since the previous record
+
+		TRACE_TYPE_TIME				4	absolute time in ms, written before
+									a record more than 31 ms after the
+									previous one and at every sync
+		TRACE_TYPE_COMMAND			1	byte read from the Remote
+		TRACE_TYPE_DISTANCE			2	HC-SR04 distance in cm, when it
+									changes
+		TRACE_TYPE_ACCEL			6	accelerometer x, y, z, raw MPU6050
+									units
+		TRACE_TYPE_ACCEL_DELTA		3	accelerometer change from the
+									previous sample, x, y, z in -128..127
+		TRACE_TYPE_MOTORS			3	left PWM, right PWM,
+									TRACE_MOTORS_xxx flags, when they
+									change
+		TRACE_TYPE_EVENT			1	event character sent to the Remote
+		TRACE_TYPE_LOST				1	records lost to a full buffer before
+									this one, at most 255
+
+	Multi-byte values are little-endian. The link of 9600 baud cannot
+	carry every accelerometer sample: every TRACE_ACCEL_DIVIDER-th sample
+	is recorded, and every sample with an axis more than TRACE_ACCEL_JUMP
+	from the previous recorded sample, e.g. of an impact. When the link
+	falls behind, accelerometer samples are lost first.
+
+	The firmware records through the TRACE_xxx() markers, which are
+	compiled only when TRACE_RECORDING is defined (the robot_fw_trace
+	target of CMakeLists.txt), otherwise they are empty and the firmware
+	is not changed by them:
+
+		TRACE_COMMAND(received_byte);
+
+	The host tools decode the records of a message with trace_decode().
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <stdint.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Bytes of the ring buffer, power of 2
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE 128
+#endif
+
+//Every n-th accelerometer sample is recorded, and the samples jumping
+//more than TRACE_ACCEL_JUMP raw units (0.5 g at +-16 g)
+#ifndef TRACE_ACCEL_DIVIDER
+#define TRACE_ACCEL_DIVIDER 4
+#endif
+#define TRACE_ACCEL_JUMP 1024
+
+//Record types
+#define TRACE_TYPE_TIME				0
+#define TRACE_TYPE_COMMAND			1
+#define TRACE_TYPE_DISTANCE			2
+#define TRACE_TYPE_ACCEL			3
+#define TRACE_TYPE_ACCEL_DELTA		4
+#define TRACE_TYPE_MOTORS			5
+#define TRACE_TYPE_EVENT			6
+#define TRACE_TYPE_LOST				7
+
+//Header byte
+#define TRACE_HEADER_SHIFT	5
+#define TRACE_DELTA_MAX		31
+
+//Motor flags
+#define TRACE_MOTORS_LEFT_REVERSE	(1 << 0)
+#define TRACE_MOTORS_RIGHT_REVERSE	(1 << 1)
+
+#ifdef TRACE_RECORDING
+#define TRACE_COMMAND(byte)				trace_command(byte)
+#define TRACE_DISTANCE(cm)				trace_distance(cm)
+#define TRACE_ACCEL(x, y, z)			trace_accel((x), (y), (z))
+#define TRACE_MOTORS(left, right)		trace_motors((left), (right))
+#define TRACE_EVENT(c)					trace_event(c)
+#else
+#define TRACE_COMMAND(byte)
+#define TRACE_DISTANCE(cm)
+#define TRACE_ACCEL(x, y, z)
+#define TRACE_MOTORS(left, right)
+#define TRACE_EVENT(c)
+#endif
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+//A decoded record, accelerometer deltas are decoded to TRACE_TYPE_ACCEL
+typedef struct {
+	uint8_t type;
+	uint32_t time_ms;
+	uint8_t byte;				//TRACE_TYPE_COMMAND, TRACE_TYPE_EVENT, TRACE_TYPE_LOST
+	uint16_t distance_cm;		//TRACE_TYPE_DISTANCE
+	int16_t accel[3];			//TRACE_TYPE_ACCEL
+	uint8_t left_pwm;			//TRACE_TYPE_MOTORS
+	uint8_t right_pwm;
+	uint8_t flags;
+} trace_record_t;
+
+//State of the decoder between messages, zero it to start
+typedef struct {
+	uint32_t time_ms;
+	int16_t accel[3];
+} trace_decoder_t;
+
+
+
+/******************************************************************************
+	Function name:	trace_command()
+					trace_distance()
+					trace_accel()
+					trace_motors()
+					trace_event()
+
+	Record a byte read from the Remote, a distance, an accelerometer
+	sample, the motor speeds (-255..255, negative in reverse) and an
+	event sent to the Remote. Distances and motor speeds are recorded
+	only when they change. The functions may be called from interrupts.
+
+	Use the TRACE_xxx() markers in the firmware.
+******************************************************************************/
+void trace_command(uint8_t byte);
+void trace_distance(uint16_t cm);
+void trace_accel(int16_t x, int16_t y, int16_t z);
+void trace_motors(int16_t left, int16_t right);
+void trace_event(char c);
+
+/******************************************************************************
+	Function name:	trace_take()
+
+	Takes the oldest whole records out of the ring buffer.
+
+	Inputs:		uint8_t max, bytes that fit in payload
+	Outputs:	uint8_t *payload
+				uint8_t, bytes taken, 0 if the buffer is empty
+******************************************************************************/
+uint8_t trace_take(uint8_t *payload, uint8_t max);
+
+/******************************************************************************
+	Function name:	trace_record_length()
+
+	Inputs:		uint8_t header
+	Outputs:	uint8_t, bytes of the record with this header byte
+******************************************************************************/
+uint8_t trace_record_length(uint8_t header);
+
+/******************************************************************************
+	Function name:	trace_decode()
+
+	Decodes the records of a trace message. TRACE_TYPE_TIME records only move
+	the time and are not passed on.
+
+	Inputs:		trace_decoder_t *decoder
+				const uint8_t *payload
+				uint8_t length
+				void (*record)(const trace_record_t *), called with every
+				decoded record
+	Outputs:	uint8_t, 1 if the message was whole records, else 0 and
+				the records up to the broken one were passed on
+******************************************************************************/
+uint8_t trace_decode(trace_decoder_t *decoder, const uint8_t *payload, uint8_t length,
+					 void (*record)(const trace_record_t *));
+
+
+
+#endif /* TRACE_H_ */
@@ -0,0 +1,113 @@
+/******************************************************************************
+	TRACE DECODER IMPLEMENTATION FILE
+
+	This file contains the decoder of the binary trace, see trace.h for the
+	record format. It has no hardware dependencies, the host tools link it
+	without the recorder (trace.c).
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "trace.h"
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+//Payload bytes of each record type
+static const uint8_t PAYLOAD_LENGTH[8] = {
+	[TRACE_TYPE_TIME] = 4,
+	[TRACE_TYPE_COMMAND] = 1,
+	[TRACE_TYPE_DISTANCE] = 2,
+	[TRACE_TYPE_ACCEL] = 6,
+	[TRACE_TYPE_ACCEL_DELTA] = 3,
+	[TRACE_TYPE_MOTORS] = 3,
+	[TRACE_TYPE_EVENT] = 1,
+	[TRACE_TYPE_LOST] = 1,
+};
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	trace_record_length()
+
+	This is a public function and is described in the header file, trace.h.
+******************************************************************************/
+uint8_t trace_record_length(uint8_t header) {
+	return 1 + PAYLOAD_LENGTH[header >> TRACE_HEADER_SHIFT];
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	trace_decode()
+
+	This is a public function and is described in the header file, trace.h.
+******************************************************************************/
+uint8_t trace_decode(trace_decoder_t *decoder, const uint8_t *payload, uint8_t length,
+					 void (*record)(const trace_record_t *)) {
+	uint8_t i = 0;
+
+	while (i < length) {
+		uint8_t header = payload[i];
+		const uint8_t *p = &payload[i + 1];
+		trace_record_t decoded = { 0 };
+
+		if (i + trace_record_length(header) > length) {
+			return 0;
+		}
+		i += trace_record_length(header);
+
+		decoded.type = header >> TRACE_HEADER_SHIFT;
+		decoder->time_ms += header & TRACE_DELTA_MAX;
+		decoded.time_ms = decoder->time_ms;
+
+		switch (decoded.type) {
+			case TRACE_TYPE_TIME:
+				decoder->time_ms = p[0] | (uint32_t)p[1] << 8 |
+								   (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+				continue;
+			case TRACE_TYPE_COMMAND:
+			case TRACE_TYPE_EVENT:
+			case TRACE_TYPE_LOST:
+				decoded.byte = p[0];
+				break;
+			case TRACE_TYPE_DISTANCE:
+				decoded.distance_cm = p[0] | p[1] << 8;
+				break;
+			case TRACE_TYPE_ACCEL:
+				for (uint8_t axis = 0; axis < 3; axis++) {
+					decoder->accel[axis] = (int16_t)(p[2 * axis] | p[2 * axis + 1] << 8);
+				}
+				break;
+			case TRACE_TYPE_ACCEL_DELTA:
+				for (uint8_t axis = 0; axis < 3; axis++) {
+					decoder->accel[axis] += (int8_t)p[axis];
+				}
+				decoded.type = TRACE_TYPE_ACCEL;
+				break;
+			case TRACE_TYPE_MOTORS:
+				decoded.left_pwm = p[0];
+				decoded.right_pwm = p[1];
+				decoded.flags = p[2];
+				break;
+			default:
+				break;
+		}
+
+		for (uint8_t axis = 0; axis < 3; axis++) {
+			decoded.accel[axis] = decoder->accel[axis];
+		}
+		record(&decoded);
+	}
+
+	return 1;
+}
+/*****************************************************************************/
@@ -1,284 +1,991 @@
-/*******************************************************************************
-
-	REDBOT REMOTE CONTROL
-
-	Main execution file for RedBot Remote Control.
-
-	Created: 2020-10-27
-	Author: Mattias Ahle, mattias.ahle@gmail.com
-
-	Last update: 2020-11-03
-    By: Mattias Ahle
-
-*******************************************************************************/
-
-
-
-/*******************************************************************************
-	DEFINE
-*******************************************************************************/
-#define F_CPU 16000000UL
-
-
-
-/*******************************************************************************
-	INCLUDE
-*******************************************************************************/
-#include "joystick.h"
-#include "output_byte_creator.h"
-#include "usart0.h"
-#include "oled/lcd.h"
-#include "oled/printout.h"
-#include "oled/font.h"
-#include <util/delay.h>
-#include <stdlib.h>
-
-
-
-/*******************************************************************************
-	GLOBAL VARIABLES
-*******************************************************************************/
-static char buffer[10];
-int8_t received_byte;
-
-
-/*******************************************************************************
-	FUNCTION PROTOTYPES
-*******************************************************************************/
-void handle_usart_receive(void);
-void print_x_on_oled(uint8_t *p_x);
-void print_y_on_oled(uint8_t *p_y);
-void print_output_byte_on_oled(uint8_t output_byte);
-void reset_error_print_on_oled(void);
-void print_collision_error_on_oled(void);
-void print_distance_error_on_oled(void);
-void print_communication_error_on_oled(void);
-void print_pic_full_screen(const unsigned char *arr);
-void print_pic_half_top_screen(const unsigned char *arr);
-
-
-
-/*******************************************************************************
-	MAIN FUNCTION
-*******************************************************************************/
-int main(void)
-{
-	uint8_t joystick_x_value;
-	uint8_t joystick_y_value;
-	uint8_t output_byte;
-
-	joystick_init();
-	output_byte_creator_init();
-	usart_init();
-	lcd_init(0xAF);
-
-	_delay_ms(100);
-
-	//Print intro pics
-	print_pic_full_screen(&slak_2020);
-	_delay_ms(4000);
-	lcd_clrscr();
-
-	print_pic_full_screen(&hkr_logo_two);
-	_delay_ms(2000);
-	lcd_clrscr();
-
-    while (1)
-	{
-		if (joystick_button_is_pressed())
-		{
-			reset_error_print_on_oled();
-		}
-
-		if (usart_receive())
-		{
-			handle_usart_receive();
-		}
-
-		joystick_x_value = joystick_get_position('X');
-		//print_x_on_oled(&joystick_x_value);
-
-		joystick_y_value = joystick_get_position('Y');
-		//print_y_on_oled(&joystick_y_value);
-
-		output_byte = output_byte_creator_create(&joystick_x_value, &joystick_y_value, 'L');
-		print_output_byte_on_oled(output_byte);
-		usart_transmit_character(output_byte);
-
-		output_byte = output_byte_creator_create(&joystick_x_value, &joystick_y_value, 'R');
-		print_output_byte_on_oled(output_byte);
-		usart_transmit_character(output_byte);
-    }
-}
-
-
-
-/*******************************************************************************
-	SUB FUNCTIONS
-*******************************************************************************/
-void handle_usart_receive(void)
-{
-	received_byte = UDR0;
-
-	if (received_byte == '0')
-	{
-		reset_error_print_on_oled();
-	}
-	else if (received_byte == '1')
-	{
-		while (1) //wait for button press to confirm collision
-		{
-			print_pic_full_screen(&collision_one);
-			_delay_ms(500);
-			print_collision_error_on_oled();
-			_delay_ms(500);
-
-			if (joystick_button_is_pressed())
-			{
-				break;
-			}
-		}
-		usart_transmit_character('1');
-		lcd_clrscr();
-	}
-	else if (received_byte == '2')
-	{
-		print_distance_error_on_oled();
-	}
-	else
-	{
-		print_communication_error_on_oled();
-	}
-}
-
-void reset_error_print_on_oled(void)
-{
-	printout_lcd_pos_puts(0, 0, "                    ");
-	printout_lcd_pos_puts(0, 1, "                    ");
-	printout_lcd_pos_puts(0, 2, "                    ");
-	printout_lcd_pos_puts(0, 3, "                    ");
-}
-
-void print_collision_error_on_oled(void)
-{
-	printout_lcd_pos_puts(6, 2, "COLLISION!");
-	printout_lcd_pos_puts(4, 3, "Press and hold");
-	printout_lcd_pos_puts(3, 4, "joystick button");
-	printout_lcd_pos_puts(6, 5, "to confirm.");
-}
-
-void print_distance_error_on_oled(void)
-{
-	print_pic_half_top_screen(&safe_distance);
-// 	printout_lcd_pos_puts(0, 0, "OBSTACLE WARNING    ");
-// 	printout_lcd_pos_puts(0, 1, "Forward motion      ");
-// 	printout_lcd_pos_puts(0, 2, "disabled            ");
-// 	printout_lcd_pos_puts(0, 3, "                    ");
-}
-
-void print_communication_error_on_oled(void)
-{
-	printout_lcd_pos_puts(0, 0, "COMMUNICATION ERROR ");
-	printout_lcd_pos_puts(0, 1, "                    ");
-	printout_lcd_pos_puts(0, 2, "                    ");
-	printout_lcd_pos_puts(0, 3, "                    ");
-}
-
-void print_x_on_oled(uint8_t *p_x)
-{
-	printout_lcd_pos_puts(0, 0, "Raw X = ");
-	itoa(*p_x, buffer, 10);
-	printout_clear_garbage_left_align(3, buffer);
-	printout_lcd_pos_puts(8, 0, buffer);
-}
-
-void print_y_on_oled(uint8_t *p_y)
-{
-	printout_lcd_pos_puts(0, 1, "Raw Y = ");
-	itoa(*p_y, buffer, 10);
-	printout_clear_garbage_left_align(3, buffer);
-	printout_lcd_pos_puts(8, 1, buffer);
-}
-
-void print_output_byte_on_oled(uint8_t output_byte)
-{
-	printout_lcd_pos_puts(2, 4, "JOYSTICK OUTPUT");
-	printout_lcd_pos_puts(0, 5, "Motor: LEFT | RIGHT");
-	printout_lcd_pos_puts(0, 6, "Gear:");
-	printout_lcd_pos_puts(12, 6, "|");
-	printout_lcd_pos_puts(0, 7, "PWM:");
-	printout_lcd_pos_puts(12, 7, "|");
-
-	if (output_byte & (1 << 0))	//if left motor
-	{
-		if (output_byte & (1 << 1))	//if fwd gear
-		{
-			printout_lcd_pos_puts(8, 6, "FWD");
-		}
-		else //else rev gear
-		{
-			printout_lcd_pos_puts(8, 6, "REV");
-		}
-
-		itoa(output_byte & 0b11111100, buffer, 10);
-		printout_clear_garbage_left_align(3, buffer);
-		printout_lcd_pos_puts(8, 7, buffer);
-	}
-	else //else right motor
-	{
-		if (output_byte & (1 << 1))	//if fwd gear
-		{
-			printout_lcd_pos_puts(14, 6, "FWD");
-		}
-		else //else rev gear
-		{
-			printout_lcd_pos_puts(14, 6, "REV");
-		}
-
-		itoa(output_byte & 0b11111100, buffer, 10);
-		printout_clear_garbage_left_align(3, buffer);
-		printout_lcd_pos_puts(14, 7, buffer);
-	}
-}
-
-
-
-void print_pic_full_screen(const unsigned char *arr)
-{
-	int counter = 0;
-	for (uint8_t a = 0; a < 8; a++)
-	{
-		lcd_gotoxy(0, a);
-		i2c_start(LCD_I2C_ADR << 1);
-		i2c_write(0x40);
-
-		for (uint8_t b = 0; b < 128; b++)
-		{
-			i2c_write(pgm_read_byte(&arr[counter]));
-			counter++;
-		}
-
-		i2c_stop();
-	}
-}
-
-
-
-void print_pic_half_top_screen(const unsigned char *arr)
-{
-	int counter = 0;
-	for (uint8_t a = 0; a < 4; a++)
-	{
-		lcd_gotoxy(0, a);
-		i2c_start(LCD_I2C_ADR << 1);
-		i2c_write(0x40);
-
-		for (uint8_t b = 0; b < 128; b++)
-		{
-			i2c_write(pgm_read_byte(&arr[counter]));
-			counter++;
-		}
-
-		i2c_stop();
-	}
-}
\ No newline at end of file
+/*******************************************************************************
+
+	REDBOT REMOTE CONTROL
+
+	Main execution file for RedBot Remote Control.
+
+	Created: 2020-10-27
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+
+	Last update: 2020-11-03
+    By: Mattias Ahle
+
+*******************************************************************************/
+
+
+
+/*******************************************************************************
+	DEFINE
+*******************************************************************************/
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+//The benchmarks can also be enabled from the build, see the bench_*
+//targets in CMakeLists.txt
+
+//The profiler (Common/profile/profile.h) is compiled when
+//PROFILE_RECORDING is defined, see the remote_fw_profile target
+
+//The timing statistics (Common/timing/timing.h) are transmitted when
+//TIMING_STATISTICS is defined, see the remote_fw_timing target
+
+//The SRAM usage (Common/sram/sram.h) is transmitted on request when
+//SRAM_MONITOR is defined, see the remote_fw_sram target
+
+//Set to 1 to measure the I2C bus throughput to the OLED at start-up,
+//the result is displayed on the OLED
+#ifndef I2C_BUS_BENCHMARK
+#define I2C_BUS_BENCHMARK 0
+#endif
+#define I2C_BUS_BENCHMARK_ITERATIONS 100
+
+//Set to 1 to measure bytes on the I2C bus and time per printed line at
+//start-up, the result is displayed on the OLED
+#ifndef PRINTOUT_BENCHMARK
+#define PRINTOUT_BENCHMARK 0
+#endif
+#define PRINTOUT_BENCHMARK_ITERATIONS 20
+
+//Set to 1 to measure CPU cycles of bitmap, rectangle and circle drawing
+//with the blit engine against the per pixel GRAPHICMODE code at start-up,
+//the result is displayed on the OLED (needs 1 KB SRAM for a framebuffer)
+#ifndef BLIT_BENCHMARK
+#define BLIT_BENCHMARK 0
+#endif
+#define BLIT_BENCHMARK_ITERATIONS 20
+
+//Set to 1 to measure bytes on the I2C bus and time per chart sample for the
+//sweeping, the controller scrolled and the software scrolled chart at
+//start-up, the result is displayed on the OLED
+#ifndef CHART_BENCHMARK
+#define CHART_BENCHMARK 0
+#endif
+#define CHART_BENCHMARK_SAMPLES 50
+
+//OLED characters sent per main loop (6 bytes each), the display task
+//never takes longer than this from the control loop, 4 chars ~ 0.8 ms
+//on the I2C bus at 400 kHz, while the CPU goes on with the loop
+#define DISPLAY_CHUNK_CHARS 4
+
+//Time the joystick button must be held to confirm a collision
+#define COLLISION_CONFIRM_HOLD_MS 1000
+
+//Set to 1 to show the telemetry from the Robot (motor speed and distance
+//gauges on rows 4..7, distance and accelerometer chart on rows 0..3), set
+//to 0 to show the joystick output on rows 4..7
+#define TELEMETRY_VIEW 1
+
+//OLED columns sent per main loop by the telemetry widgets
+#define TELEMETRY_CHUNK_COLUMNS 16
+
+//The chart scrolls where the controller can do it (one new column per
+//sample), else it sweeps (three columns per sample), since a software
+//scroll sends the whole chart for each sample, see CHART_BENCHMARK
+#ifdef LCD_CONTENT_SCROLL
+#define TELEMETRY_CHART_MODE WIDGET_CHART_SCROLL
+#else
+#define TELEMETRY_CHART_MODE WIDGET_CHART_SWEEP
+#endif
+
+//Telemetry scales, distance in cm and accelerometer deviation in raw units
+#define TELEMETRY_DISTANCE_MAX 200
+#define TELEMETRY_ACCEL_MAX 16384
+
+
+
+/*******************************************************************************
+	INCLUDE
+*******************************************************************************/
+#include "joystick.h"
+#include "output_byte_creator.h"
+#include "usart0.h"
+#include "oled/lcd.h"
+#include "oled/printout.h"
+#include "oled/textbuffer.h"
+#include "oled/font.h"
+#include "oled/image.h"
+#include "oled/images.h"
+#include "oled/animation.h"
+#include "oled/blit.h"
+#include "oled/widget.h"
+#include "oled/numfield.h"
+#include "../Common/i2c/twi.h"
+#include "../Common/i2c/i2c_bus.h"
+#include "../Common/timer2/timer2.h"
+#include "../Common/link/link.h"
+#include "../Common/bench/bench.h"
+#include "../Common/profile/profile.h"
+#include "../Common/sram/sram.h"
+#include "../Common/timing/timing.h"
+#include "../Common/hal/hal.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAL_HOST
+#include <stdio.h>
+#endif
+
+
+
+/*******************************************************************************
+	GLOBAL VARIABLES
+*******************************************************************************/
+static char buffer[10];
+int8_t received_byte;
+
+//Numbers on the OLED, only changed values are converted and only changed
+//digits are sent
+static numfield_t raw_x_field = NUMFIELD(8, 0, 3);
+static numfield_t raw_y_field = NUMFIELD(8, 1, 3);
+static numfield_t left_pwm_field = NUMFIELD(8, 7, 3);
+static numfield_t right_pwm_field = NUMFIELD(14, 7, 3);
+static numfield_t distance_field = NUMFIELD(3, 7, 4);
+static numfield_t accel_field = NUMFIELD(13, 7, 5);
+
+//Collision alert, shown until the collision is confirmed
+static uint8_t collision_alert_active = 0;
+static uint32_t button_pressed_since;
+
+static const char collision_text_0[] PROGMEM = "COLLISION!";
+static const char collision_text_1[] PROGMEM = "Press and hold";
+static const char collision_text_2[] PROGMEM = "joystick button";
+static const char collision_text_3[] PROGMEM = "to confirm.";
+
+static const animation_text_t collision_text[] PROGMEM = {
+	{ 6, 2, collision_text_0 },
+	{ 4, 3, collision_text_1 },
+	{ 3, 4, collision_text_2 },
+	{ 6, 5, collision_text_3 },
+};
+
+static const animation_frame_t collision_frames[] PROGMEM = {
+	{ image_collision_one, IMAGE_OVERWRITE, NULL, 0, 500 },
+	{ NULL, 0, collision_text, 4, 500 },
+};
+
+static const animation_t collision_alert PROGMEM = { collision_frames, 2, ANIMATION_LOOP };
+
+//Status messages from the Robot among the event characters
+static link_parser_t link_parser;
+
+//Telemetry widgets, the chart is hidden while a warning is on rows 0..3
+static widget_bar_t left_speed_bar = WIDGET_BAR(4, 8, 120, 255, WIDGET_BAR_CENTERED);
+static widget_bar_t right_speed_bar = WIDGET_BAR(5, 8, 120, 255, WIDGET_BAR_CENTERED);
+static widget_bar_t distance_bar = WIDGET_BAR(6, 8, 120, TELEMETRY_DISTANCE_MAX, 0);
+static widget_chart_t telemetry_chart;
+static uint8_t telemetry_chart_visible = 1;
+
+
+/*******************************************************************************
+	FUNCTION PROTOTYPES
+*******************************************************************************/
+void handle_usart_receive(void);
+void print_x_on_oled(uint8_t *p_x);
+void print_y_on_oled(uint8_t *p_y);
+void print_output_byte_on_oled(uint8_t output_byte);
+void reset_error_print_on_oled(void);
+void handle_collision_confirm(void);
+void print_distance_error_on_oled(void);
+void print_communication_error_on_oled(void);
+void print_tip_over_error_on_oled(void);
+void print_pic(const uint8_t *image, uint8_t flags);
+void invalidate_number_fields(void);
+void handle_status(const link_status_t *status);
+void init_telemetry_view(void);
+void refresh_telemetry_view(void);
+void invalidate_telemetry_view(void);
+void show_telemetry_chart(void);
+void hide_telemetry_chart(void);
+void print_i2c_bus_benchmark_on_oled(void);
+void print_printout_benchmark_on_oled(void);
+void printout_lcd_pos_puts_per_char(int x, int y, char *string);
+#if BLIT_BENCHMARK == 1
+void print_blit_benchmark_on_oled(void);
+#endif
+#if CHART_BENCHMARK == 1
+void print_chart_benchmark_on_oled(void);
+#endif
+
+
+
+/*******************************************************************************
+	MAIN FUNCTION
+*******************************************************************************/
+int main(void)
+{
+	uint8_t joystick_x_value;
+	uint8_t joystick_y_value;
+	uint8_t output_byte;
+
+	sram_init();
+	joystick_init();
+	output_byte_creator_init();
+	usart_init();
+	timer2_init();
+	lcd_init(0xAF);
+
+	hal_delay_ms(100);
+
+#if I2C_BUS_BENCHMARK == 1
+	print_i2c_bus_benchmark_on_oled();
+	hal_delay_ms(4000);
+	lcd_clrscr();
+#endif
+
+#if PRINTOUT_BENCHMARK == 1
+	print_printout_benchmark_on_oled();
+	hal_delay_ms(4000);
+	lcd_clrscr();
+#endif
+
+#if BLIT_BENCHMARK == 1
+	print_blit_benchmark_on_oled();
+	hal_delay_ms(4000);
+	lcd_clrscr();
+#endif
+
+#if CHART_BENCHMARK == 1
+	print_chart_benchmark_on_oled();
+	hal_delay_ms(4000);
+	lcd_clrscr();
+#endif
+
+	//Print intro pics
+	print_pic(image_slak_2020, IMAGE_ON_BLANK);
+	hal_delay_ms(4000);
+	lcd_clrscr();
+
+	print_pic(image_hkr_logo_two, IMAGE_ON_BLANK);
+	hal_delay_ms(2000);
+	lcd_clrscr();
+	textbuffer_clear();
+	init_telemetry_view();
+	TIMING_INIT(usart_transmit_buffer);
+
+    while (1)
+	{
+		BENCH_BEGIN(BENCH_REMOTE_LOOP);
+		PROFILE_BEGIN(PROFILE_REMOTE_LOOP);
+		TIMING_LOOP(TIMING_REMOTE_RECEIVE);
+
+		while (usart_receive())
+		{
+			PROFILE_BEGIN(PROFILE_HANDLE_USART_RECEIVE);
+			handle_usart_receive();
+			PROFILE_END(PROFILE_HANDLE_USART_RECEIVE);
+		}
+
+		TIMING_SECTION(TIMING_REMOTE_JOYSTICK);
+		joystick_x_value = joystick_get_position('X');
+		//print_x_on_oled(&joystick_x_value);
+
+		joystick_y_value = joystick_get_position('Y');
+		//print_y_on_oled(&joystick_y_value);
+
+		if (collision_alert_active)
+		{
+			//the robot waits for the confirmation only, no motor bytes are
+			//sent since one of them could be taken for it
+			animation_update(); //blink the alert
+			handle_collision_confirm();
+		}
+		else
+		{
+			if (joystick_button_is_pressed())
+			{
+				reset_error_print_on_oled();
+			}
+
+			output_byte = output_byte_creator_create(&joystick_x_value, &joystick_y_value, 'L');
+#if TELEMETRY_VIEW == 0
+			print_output_byte_on_oled(output_byte);
+#endif
+			usart_transmit_character(output_byte);
+
+			output_byte = output_byte_creator_create(&joystick_x_value, &joystick_y_value, 'R');
+#if TELEMETRY_VIEW == 0
+			print_output_byte_on_oled(output_byte);
+#endif
+			usart_transmit_character(output_byte);
+
+#if TELEMETRY_VIEW == 1
+			TIMING_SECTION(TIMING_REMOTE_TELEMETRY);
+			PROFILE_BEGIN(PROFILE_REFRESH_TELEMETRY_VIEW);
+			refresh_telemetry_view(); //send a piece of the gauges and chart
+			PROFILE_END(PROFILE_REFRESH_TELEMETRY_VIEW);
+#endif
+		}
+
+		TIMING_SECTION(TIMING_REMOTE_TEXTBUFFER);
+		PROFILE_BEGIN(PROFILE_TEXTBUFFER_REFRESH);
+		textbuffer_refresh(DISPLAY_CHUNK_CHARS); //send a piece of what changed
+		PROFILE_END(PROFILE_TEXTBUFFER_REFRESH);
+
+		PROFILE_END(PROFILE_REMOTE_LOOP);
+		BENCH_END(BENCH_REMOTE_LOOP);
+    }
+}
+
+
+
+/*******************************************************************************
+	SUB FUNCTIONS
+*******************************************************************************/
+void handle_usart_receive(void)
+{
+	link_status_t status;
+
+	received_byte = usart_read();
+
+	switch (link_parse(&link_parser, received_byte))
+	{
+	case LINK_PARSE_IDLE:
+		PROFILE_POLL(received_byte, usart_transmit_buffer);
+		SRAM_POLL(received_byte, usart_transmit_buffer);
+		break; //an event, see below
+	case LINK_PARSE_FRAME:
+		if (link_decode_status(&link_parser, &status))
+		{
+			handle_status(&status);
+		}
+		return;
+	default:
+		return; //part of a frame, or a frame dropped
+	}
+
+	if (received_byte == '0')
+	{
+		reset_error_print_on_oled();
+	}
+	else if (received_byte == '1')
+	{
+		//blink the alert until the collision is confirmed, see
+		//handle_collision_confirm()
+		animation_start(&collision_alert);
+		collision_alert_active = 1;
+		button_pressed_since = timer2_get_millis();
+	}
+	else if (received_byte == '2')
+	{
+		print_distance_error_on_oled();
+	}
+	else if (received_byte == '3')
+	{
+		print_tip_over_error_on_oled();
+	}
+	else
+	{
+		print_communication_error_on_oled();
+	}
+}
+
+void reset_error_print_on_oled(void)
+{
+#if TELEMETRY_VIEW == 1
+	show_telemetry_chart(); //the chart is drawn over the warning
+#else
+	textbuffer_puts(0, 0, "                    ");
+	textbuffer_puts(0, 1, "                    ");
+	textbuffer_puts(0, 2, "                    ");
+	textbuffer_puts(0, 3, "                    ");
+#endif
+}
+
+void handle_collision_confirm(void)
+{
+	if (!joystick_button_is_pressed())
+	{
+		button_pressed_since = timer2_get_millis();
+		return;
+	}
+
+	if (timer2_get_millis() - button_pressed_since >= COLLISION_CONFIRM_HOLD_MS)
+	{
+		usart_transmit_character('1');
+		animation_stop();
+		collision_alert_active = 0;
+		lcd_clrscr();
+		textbuffer_clear();
+		invalidate_number_fields();
+		invalidate_telemetry_view();
+	}
+}
+
+void print_distance_error_on_oled(void)
+{
+	hide_telemetry_chart();
+	print_pic(image_safe_distance, IMAGE_OVERWRITE);
+// 	printout_lcd_pos_puts(0, 0, "OBSTACLE WARNING    ");
+// 	printout_lcd_pos_puts(0, 1, "Forward motion      ");
+// 	printout_lcd_pos_puts(0, 2, "disabled            ");
+// 	printout_lcd_pos_puts(0, 3, "                    ");
+}
+
+void print_tip_over_error_on_oled(void)
+{
+	hide_telemetry_chart();
+	textbuffer_puts(0, 0, "TIPPED OVER         ");
+	textbuffer_puts(0, 1, "Motors stopped      ");
+	textbuffer_puts(0, 2, "Put RedBot upright  ");
+	textbuffer_puts(0, 3, "                    ");
+}
+
+void print_communication_error_on_oled(void)
+{
+	hide_telemetry_chart();
+	textbuffer_puts(0, 0, "COMMUNICATION ERROR ");
+	textbuffer_puts(0, 1, "                    ");
+	textbuffer_puts(0, 2, "                    ");
+	textbuffer_puts(0, 3, "                    ");
+}
+
+void print_x_on_oled(uint8_t *p_x)
+{
+	textbuffer_puts(0, 0, "Raw X = ");
+	numfield_set(&raw_x_field, *p_x);
+}
+
+void print_y_on_oled(uint8_t *p_y)
+{
+	textbuffer_puts(0, 1, "Raw Y = ");
+	numfield_set(&raw_y_field, *p_y);
+}
+
+void print_output_byte_on_oled(uint8_t output_byte)
+{
+	textbuffer_puts(2, 4, "JOYSTICK OUTPUT");
+	textbuffer_puts(0, 5, "Motor: LEFT | RIGHT");
+	textbuffer_puts(0, 6, "Gear:");
+	textbuffer_puts(12, 6, "|");
+	textbuffer_puts(0, 7, "PWM:");
+	textbuffer_puts(12, 7, "|");
+
+	if (output_byte & (1 << 0))	//if left motor
+	{
+		if (output_byte & (1 << 1))	//if fwd gear
+		{
+			textbuffer_puts(8, 6, "FWD");
+		}
+		else //else rev gear
+		{
+			textbuffer_puts(8, 6, "REV");
+		}
+
+		numfield_set(&left_pwm_field, output_byte & 0b11111100);
+	}
+	else //else right motor
+	{
+		if (output_byte & (1 << 1))	//if fwd gear
+		{
+			textbuffer_puts(14, 6, "FWD");
+		}
+		else //else rev gear
+		{
+			textbuffer_puts(14, 6, "REV");
+		}
+
+		numfield_set(&right_pwm_field, output_byte & 0b11111100);
+	}
+}
+
+
+
+void print_pic(const uint8_t *image, uint8_t flags)
+{
+	uint8_t pages = image_draw(image, flags);
+
+	textbuffer_forget(0, pages - 1); //text under the picture is gone
+	invalidate_number_fields();
+}
+
+void invalidate_number_fields(void)
+{
+	numfield_invalidate(&raw_x_field);
+	numfield_invalidate(&raw_y_field);
+	numfield_invalidate(&left_pwm_field);
+	numfield_invalidate(&right_pwm_field);
+	numfield_invalidate(&distance_field);
+	numfield_invalidate(&accel_field);
+}
+
+
+
+/*******************************************************************************
+	Telemetry view
+
+	The status messages from the Robot (every 50 ms) move the gauges and add
+	a sample to the chart. The widgets send only the columns that change, a
+	chunk per main loop, next to the text of the textbuffer. The chart is
+	126 columns wide, the same as the text, so a text warning covers it.
+*******************************************************************************/
+void handle_status(const link_status_t *status)
+{
+	int16_t left = status->left_pwm;
+	int16_t right = status->right_pwm;
+	int16_t samples[2];
+
+	if (status->flags & LINK_STATUS_LEFT_REVERSE)
+	{
+		left = -left;
+	}
+	if (status->flags & LINK_STATUS_RIGHT_REVERSE)
+	{
+		right = -right;
+	}
+
+	widget_bar_set(&left_speed_bar, left);
+	widget_bar_set(&right_speed_bar, right);
+	widget_bar_set(&distance_bar, status->distance_cm);
+
+	samples[0] = status->distance_cm > TELEMETRY_DISTANCE_MAX ? TELEMETRY_DISTANCE_MAX : status->distance_cm;
+	samples[1] = status->accel_peak > TELEMETRY_ACCEL_MAX ? TELEMETRY_ACCEL_MAX : status->accel_peak;
+	widget_chart_push(&telemetry_chart, samples);
+
+#if TELEMETRY_VIEW == 1
+	numfield_set(&distance_field, status->distance_cm);
+	numfield_set(&accel_field, status->accel_peak);
+#endif
+}
+
+void init_telemetry_view(void)
+{
+	widget_chart_init(&telemetry_chart, 0, 4, 0, TEXTBUFFER_COLUMNS * sizeof(FONT[0]));
+	widget_chart_set_series(&telemetry_chart, 0, 0, TELEMETRY_DISTANCE_MAX, WIDGET_CHART_LINE);
+	widget_chart_set_series(&telemetry_chart, 1, 0, TELEMETRY_ACCEL_MAX, WIDGET_CHART_DOTS);
+	widget_chart_set_mode(&telemetry_chart, TELEMETRY_CHART_MODE);
+
+	invalidate_telemetry_view();
+}
+
+void refresh_telemetry_view(void)
+{
+	if (widget_bar_refresh(&left_speed_bar, TELEMETRY_CHUNK_COLUMNS) ||
+		widget_bar_refresh(&right_speed_bar, TELEMETRY_CHUNK_COLUMNS) ||
+		widget_bar_refresh(&distance_bar, TELEMETRY_CHUNK_COLUMNS))
+	{
+		return;
+	}
+
+	widget_chart_refresh(&telemetry_chart, TELEMETRY_CHUNK_COLUMNS);
+}
+
+void invalidate_telemetry_view(void)
+{
+	widget_bar_invalidate(&left_speed_bar);
+	widget_bar_invalidate(&right_speed_bar);
+	widget_bar_invalidate(&distance_bar);
+	widget_chart_show(&telemetry_chart);
+	telemetry_chart_visible = 1;
+
+#if TELEMETRY_VIEW == 1
+	textbuffer_puts(0, 4, "L");
+	textbuffer_puts(0, 5, "R");
+	textbuffer_puts(0, 6, "D");
+	textbuffer_puts(0, 7, "cm");
+	textbuffer_puts(9, 7, "acc");
+#endif
+}
+
+void show_telemetry_chart(void)
+{
+	if (telemetry_chart_visible)
+	{
+		return;
+	}
+
+	//the text warning is not known to the textbuffer any more, the chart
+	//covers it, the 2 columns right of it are cleared (pictures)
+	textbuffer_forget(0, 3);
+	for (uint8_t page = 0; page < 4; page++)
+	{
+		lcd_data_begin(TEXTBUFFER_COLUMNS * sizeof(FONT[0]), page);
+		i2c_write(0x00);
+		i2c_write(0x00);
+		i2c_stop();
+	}
+
+	widget_chart_show(&telemetry_chart);
+	telemetry_chart_visible = 1;
+}
+
+void hide_telemetry_chart(void)
+{
+	if (!telemetry_chart_visible)
+	{
+		return;
+	}
+
+	//all text of the warning is sent, also blanks over the chart, which
+	//neither draws nor scrolls until it is shown again
+	textbuffer_forget(0, 3);
+	widget_chart_hide(&telemetry_chart);
+	telemetry_chart_visible = 0;
+}
+
+
+
+/*******************************************************************************
+	Writes a blank display page (128 bytes) a number of times through the
+	transaction engine and displays the I2C bus throughput.
+*******************************************************************************/
+void print_i2c_bus_benchmark_on_oled(void)
+{
+	static const uint8_t blank_page[128];
+	static twi_transaction_t page_write = {
+		.address = LCD_I2C_ADR,
+		.flags = TWI_FLAG_PREFIX,
+		.prefix = 0x40,			//0x40 for data
+		.write_buffer = blank_page,
+		.write_length = sizeof(blank_page),
+	};
+	i2c_bus_benchmark_t result;
+
+	lcd_gotoxy(0, 0);
+	i2c_bus_benchmark(&page_write, I2C_BUS_BENCHMARK_ITERATIONS, &result);
+
+	printout_lcd_pos_puts(0, 0, "I2C page write");
+	printout_lcd_pos_puts(0, 1, "us/page:");
+	ultoa(result.micros / result.iterations, buffer, 10);
+	printout_lcd_pos_puts(9, 1, buffer);
+	printout_lcd_pos_puts(0, 2, "B/s:");
+	ultoa(result.bytes_per_second, buffer, 10);
+	printout_lcd_pos_puts(9, 2, buffer);
+	printout_lcd_pos_puts(0, 3, "Errors:");
+	itoa(result.errors, buffer, 10);
+	printout_lcd_pos_puts(9, 3, buffer);
+
+#ifdef HAL_HOST
+	//the host build has no one looking at the display
+	printf("I2C page write: %lu us/page, %lu B/s, %u errors\n",
+		(unsigned long)(result.micros / result.iterations),
+		(unsigned long)result.bytes_per_second, result.errors);
+#endif
+}
+
+
+
+/*******************************************************************************
+	Prints a 20 character line a number of times with the per character
+	renderer (before) and with printout_lcd_pos_puts() (after), and displays
+	bytes on the I2C bus and micros per line for both.
+*******************************************************************************/
+void print_printout_benchmark_on_oled(void)
+{
+	char line[] = "0123456789ABCDEFGHIJ";
+	i2c_bus_device_t *oled = i2c_bus_lookup(LCD_I2C_ADR);
+	uint32_t bytes[2];
+	uint32_t micros[2];
+
+	for (uint8_t run = 0; run < 2; run++)
+	{
+		bytes[run] = oled->stats.bytes;
+		micros[run] = timer2_get_micros();
+
+		for (uint8_t i = 0; i < PRINTOUT_BENCHMARK_ITERATIONS; i++)
+		{
+			if (run == 0)
+			{
+				printout_lcd_pos_puts_per_char(0, 0, line);
+			}
+			else
+			{
+				printout_lcd_pos_puts(0, 0, line);
+			}
+		}
+
+		micros[run] = (timer2_get_micros() - micros[run]) / PRINTOUT_BENCHMARK_ITERATIONS;
+		bytes[run] = (oled->stats.bytes - bytes[run]) / PRINTOUT_BENCHMARK_ITERATIONS;
+	}
+
+	lcd_clrscr();
+	printout_lcd_pos_puts(0, 0, "Line of 20 chars");
+	printout_lcd_pos_puts(0, 2, "Before B:");
+	ultoa(bytes[0], buffer, 10);
+	printout_lcd_pos_puts(10, 2, buffer);
+	printout_lcd_pos_puts(0, 3, "Before us:");
+	ultoa(micros[0], buffer, 10);
+	printout_lcd_pos_puts(10, 3, buffer);
+	printout_lcd_pos_puts(0, 5, "After B:");
+	ultoa(bytes[1], buffer, 10);
+	printout_lcd_pos_puts(10, 5, buffer);
+	printout_lcd_pos_puts(0, 6, "After us:");
+	ultoa(micros[1], buffer, 10);
+	printout_lcd_pos_puts(10, 6, buffer);
+
+#ifdef HAL_HOST
+	printf("Line of 20 chars: before %lu B %lu us, after %lu B %lu us\n",
+		(unsigned long)bytes[0], (unsigned long)micros[0],
+		(unsigned long)bytes[1], (unsigned long)micros[1]);
+#endif
+}
+
+/*******************************************************************************
+	The previous renderer, one position command and one data transaction
+	per character. Only kept as reference for the benchmark.
+*******************************************************************************/
+void printout_lcd_pos_puts_per_char(int x, int y, char *string)
+{
+	for (uint8_t j = 0; j < strlen(string); j++)
+	{
+		lcd_gotoxy(x + j, y);			//line x column y
+		i2c_start(LCD_I2C_ADR << 1);
+		i2c_write(0x40);
+
+		for (uint8_t i = 0; i < 7; i++)
+		{
+			i2c_write(pgm_read_byte(&(FONT[string[j] - 32][i])));
+		}
+
+		i2c_stop();
+	}
+}
+
+
+
+#if CHART_BENCHMARK == 1
+/*******************************************************************************
+	Adds samples to the telemetry chart in each mode and sends them, and
+	displays bytes on the I2C bus and micros per sample for each mode.
+	Without LCD_CONTENT_SCROLL (lcd.h) the scroll mode is the software
+	scroll.
+*******************************************************************************/
+void print_chart_benchmark_on_oled(void)
+{
+	static const uint8_t modes[3] = { WIDGET_CHART_SWEEP, WIDGET_CHART_SCROLL, WIDGET_CHART_SCROLL_SOFTWARE };
+	i2c_bus_device_t *oled = i2c_bus_lookup(LCD_I2C_ADR);
+	uint32_t bytes[3];
+	uint32_t micros[3];
+	uint32_t start;
+	int16_t samples[2];
+
+	for (uint8_t run = 0; run < 3; run++)
+	{
+		widget_chart_init(&telemetry_chart, 0, 4, 0, TEXTBUFFER_COLUMNS * sizeof(FONT[0]));
+		widget_chart_set_series(&telemetry_chart, 1, 0, TELEMETRY_ACCEL_MAX, WIDGET_CHART_DOTS);
+		widget_chart_set_mode(&telemetry_chart, modes[run]);
+		while (widget_chart_refresh(&telemetry_chart, TELEMETRY_CHUNK_COLUMNS) || twi_is_busy()) {}
+
+		bytes[run] = oled->stats.bytes;
+		micros[run] = 0;
+
+		for (uint8_t i = 0; i < CHART_BENCHMARK_SAMPLES; i++)
+		{
+			samples[0] = (i * 8) & 0xFF;
+			samples[1] = (i & 1) ? TELEMETRY_ACCEL_MAX / 2 : 0;
+
+			start = timer2_get_micros();
+			widget_chart_push(&telemetry_chart, samples);
+			while (widget_chart_refresh(&telemetry_chart, TELEMETRY_CHUNK_COLUMNS) || twi_is_busy()) {}
+			micros[run] += timer2_get_micros() - start;
+
+			hal_delay_ms(10); //one display frame between two content scroll commands
+		}
+
+		bytes[run] = (oled->stats.bytes - bytes[run]) / CHART_BENCHMARK_SAMPLES;
+		micros[run] /= CHART_BENCHMARK_SAMPLES;
+	}
+
+	lcd_clrscr();
+	printout_lcd_pos_puts(0, 0, "Chart  B/sample  us");
+	printout_lcd_pos_puts(0, 2, "Sweep");
+	printout_lcd_pos_puts(0, 3, "Scroll");
+	printout_lcd_pos_puts(0, 4, "SW scroll");
+	for (uint8_t run = 0; run < 3; run++)
+	{
+		ultoa(bytes[run], buffer, 10);
+		printout_lcd_pos_puts(10, 2 + run, buffer);
+		ultoa(micros[run], buffer, 10);
+		printout_lcd_pos_puts(15, 2 + run, buffer);
+	}
+
+#ifdef HAL_HOST
+	static const char *names[3] = { "sweep", "scroll", "SW scroll" };
+
+	for (uint8_t run = 0; run < 3; run++)
+	{
+		printf("Chart %s: %lu B/sample, %lu us\n", names[run],
+			(unsigned long)bytes[run], (unsigned long)micros[run]);
+	}
+#endif
+}
+#endif
+
+
+
+#if BLIT_BENCHMARK == 1
+/*******************************************************************************
+	Draws a 32x32 bitmap at an unaligned y, a filled 100x40 rectangle and a
+	filled circle of radius 20 into a framebuffer a number of times, with
+	the per pixel GRAPHICMODE code (before) and with the blit engine
+	(after), and displays CPU cycles per drawing for both.
+*******************************************************************************/
+static uint8_t benchmark_buffer[DISPLAY_HEIGHT / 8][DISPLAY_WIDTH];
+
+static void reference_drawPixel(uint8_t x, uint8_t y, uint8_t color);
+static void reference_drawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color);
+static void reference_drawCircle(uint8_t center_x, uint8_t center_y, uint8_t radius, uint8_t color);
+
+void print_blit_benchmark_on_oled(void)
+{
+	static const blit_target_t target = { &benchmark_buffer[0][0], 0, DISPLAY_HEIGHT / 8, 0, DISPLAY_WIDTH };
+	static const char *names[] = { "Bitmap", "Fill rect", "Fill circ" };
+	const uint8_t *bitmap = image_slak_2020; //any 128 bytes in flash
+	uint32_t cycles[3][2];
+	uint32_t micros;
+
+	for (uint8_t test = 0; test < 3; test++)
+	{
+		for (uint8_t run = 0; run < 2; run++)
+		{
+			micros = timer2_get_micros();
+
+			for (uint8_t i = 0; i < BLIT_BENCHMARK_ITERATIONS; i++)
+			{
+				if (test == 0 && run == 0)
+				{
+					//the per pixel lcd_drawBitmap()
+					for (uint8_t y = 0; y < 32; y++)
+					{
+						for (uint8_t x = 0; x < 32; x++)
+						{
+							if (pgm_read_byte(bitmap + y * 4 + x / 8) & (128 >> (x & 7)))
+							{
+								reference_drawPixel(40 + x, 13 + y, WHITE);
+							}
+							else
+							{
+								reference_drawPixel(40 + x, 13 + y, BLACK);
+							}
+						}
+					}
+				}
+				else if (test == 0)
+				{
+					blit_bitmap(&target, 40, 13, bitmap, 32, 32, WHITE);
+				}
+				else if (test == 1 && run == 0)
+				{
+					//the lcd_fillRect(), one line per row
+					for (uint8_t y = 5; y <= 44; y++)
+					{
+						reference_drawLine(10, y, 109, y, WHITE);
+					}
+				}
+				else if (test == 1)
+				{
+					blit_fill_rect(&target, 10, 5, 109, 44, WHITE);
+				}
+				else if (run == 0)
+				{
+					//the lcd_fillCircle(), one circle per radius
+					for (uint8_t r = 0; r <= 20; r++)
+					{
+						reference_drawCircle(64, 32, r, WHITE);
+					}
+				}
+				else
+				{
+					blit_fill_circle(&target, 64, 32, 20, WHITE);
+				}
+			}
+
+			micros = timer2_get_micros() - micros;
+			cycles[test][run] = micros * (F_CPU / 1000000UL) / BLIT_BENCHMARK_ITERATIONS;
+		}
+	}
+
+	lcd_clrscr();
+	printout_lcd_pos_puts(0, 0, "Cycles    before after");
+	for (uint8_t test = 0; test < 3; test++)
+	{
+		printout_lcd_pos_puts(0, 2 + test, (char *)names[test]);
+		ultoa(cycles[test][0], buffer, 10);
+		printout_lcd_pos_puts(10, 2 + test, buffer);
+		ultoa(cycles[test][1], buffer, 10);
+		printout_lcd_pos_puts(16, 2 + test, buffer);
+	}
+
+#ifdef HAL_HOST
+	//the host simulates no time for the drawing itself (hal_host.h), the
+	//cycles only mean something on the AVR
+	for (uint8_t test = 0; test < 3; test++)
+	{
+		printf("%s: before %lu cycles, after %lu cycles (not simulated)\n", names[test],
+			(unsigned long)cycles[test][0], (unsigned long)cycles[test][1]);
+	}
+#endif
+}
+
+/*******************************************************************************
+	The per pixel GRAPHICMODE code of lcd.c. Only kept as reference for the
+	benchmark.
+*******************************************************************************/
+static void reference_drawPixel(uint8_t x, uint8_t y, uint8_t color)
+{
+	if (x > DISPLAY_WIDTH - 1 || y > (DISPLAY_HEIGHT - 1))
+	{
+		return;
+	}
+
+	if (color == WHITE)
+	{
+		benchmark_buffer[(y / (DISPLAY_HEIGHT / 8))][x] |= (1 << (y % (DISPLAY_HEIGHT / 8)));
+	}
+	else
+	{
+		benchmark_buffer[(y / (DISPLAY_HEIGHT / 8))][x] &= ~(1 << (y % (DISPLAY_HEIGHT / 8)));
+	}
+}
+
+static void reference_drawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color)
+{
+	int dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
+	int dy = -abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
+	int err = dx + dy, e2;
+
+	while (1)
+	{
+		reference_drawPixel(x1, y1, color);
+		if (x1 == x2 && y1 == y2) break;
+		e2 = 2 * err;
+		if (e2 > dy) { err += dy; x1 += sx; }
+		if (e2 < dx) { err += dx; y1 += sy; }
+	}
+}
+
+static void reference_drawCircle(uint8_t center_x, uint8_t center_y, uint8_t radius, uint8_t color)
+{
+	int16_t f = 1 - radius;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * radius;
+	int16_t x = 0;
+	int16_t y = radius;
+
+	reference_drawPixel(center_x, center_y + radius, color);
+	reference_drawPixel(center_x, center_y - radius, color);
+	reference_drawPixel(center_x + radius, center_y, color);
+	reference_drawPixel(center_x - radius, center_y, color);
+
+	while (x < y)
+	{
+		if (f >= 0)
+		{
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+
+		reference_drawPixel(center_x + x, center_y + y, color);
+		reference_drawPixel(center_x - x, center_y + y, color);
+		reference_drawPixel(center_x + x, center_y - y, color);
+		reference_drawPixel(center_x - x, center_y - y, color);
+		reference_drawPixel(center_x + y, center_y + x, color);
+		reference_drawPixel(center_x - y, center_y + x, color);
+		reference_drawPixel(center_x + y, center_y - x, color);
+		reference_drawPixel(center_x - y, center_y - x, color);
+	}
+}
+#endif
\ No newline at end of file
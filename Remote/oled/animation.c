@@ -0,0 +1,168 @@
+/******************************************************************************
+	ANIMATION PLAYER IMPLEMENTATION FILE
+
+	This file contains the implementation of the animation player. See
+	animation.h for a description.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "animation.h"
+#include "image.h"
+#include "textbuffer.h"
+#include "../../Common/timer2/timer2.h"
+#include <avr/pgmspace.h>
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+//Running animation, a copy of the flash struct, length 0 if none
+static animation_t animation = { NULL, 0, ANIMATION_ONCE };
+
+//Frame on screen and the time it was started
+static animation_frame_t frame;
+static uint8_t frame_index;
+static uint32_t frame_start;
+
+//Picture of the frame still being drawn, page by page
+static image_decoder_t decoder;
+static uint8_t drawing;
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static void begin_frame(uint8_t index);
+static void write_text(void);
+
+
+
+/******************************************************************************
+	Function name:	animation_start()
+
+	This is a public function and is described in the header file,
+	animation.h.
+******************************************************************************/
+void animation_start(const animation_t *a) {
+	memcpy_P(&animation, a, sizeof(animation));
+
+	if (animation.length > 0) {
+		begin_frame(0);
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	animation_stop()
+
+	This is a public function and is described in the header file,
+	animation.h.
+******************************************************************************/
+void animation_stop(void) {
+	animation.length = 0;
+	drawing = 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	animation_is_running()
+
+	This is a public function and is described in the header file,
+	animation.h.
+******************************************************************************/
+uint8_t animation_is_running(void) {
+	return animation.length > 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	animation_update()
+
+	This is a public function and is described in the header file,
+	animation.h.
+******************************************************************************/
+uint8_t animation_update(void) {
+	uint8_t page;
+
+	if (animation.length == 0) {
+		return 0;
+	}
+
+	//one page of the picture per call, the text goes on top when done
+	if (drawing) {
+		page = decoder.page;
+		drawing = image_draw_page(&decoder);
+		textbuffer_forget(page, page);		//text under the page is gone
+
+		if (!drawing) {
+			write_text();
+		}
+		return 1;
+	}
+
+	//timestamps are compared by subtraction, the clock wraps
+	if (timer2_get_millis() - frame_start < frame.duration_ms) {
+		return 0;
+	}
+
+	if (frame_index + 1 < animation.length) {
+		begin_frame(frame_index + 1);
+	} else if (animation.mode == ANIMATION_LOOP) {
+		begin_frame(0);
+	} else {
+		animation_stop();
+		return 0;
+	}
+
+	return 1;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Loads a frame from flash and starts its picture, or writes its text at
+	once if it has no picture.
+******************************************************************************/
+static void begin_frame(uint8_t index) {
+	frame_index = index;
+	memcpy_P(&frame, &animation.frames[index], sizeof(frame));
+	frame_start = timer2_get_millis();
+
+	if (frame.image) {
+		image_begin(&decoder, frame.image, frame.image_flags);
+		drawing = 1;
+	} else {
+		drawing = 0;
+		write_text();
+	}
+}
+
+
+
+/******************************************************************************
+	Writes the text lines of the frame to the text framebuffer.
+******************************************************************************/
+static void write_text(void) {
+	animation_text_t line;
+	uint8_t i;
+
+	for (i = 0; i < frame.text_lines; i++) {
+		memcpy_P(&line, &frame.text[i], sizeof(line));
+		textbuffer_puts_P(line.x, line.y, line.string);
+	}
+}
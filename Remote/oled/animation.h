@@ -0,0 +1,119 @@
+/******************************************************************************
+	ANIMATION PLAYER HEADER FILE
+
+	This file contains the interface to the animation player, which plays
+	alert screens on the OLED without blocking the main loop.
+
+	An animation is a sequence of frames in flash. A frame is a packed
+	picture (image.h), lines of text, or both, and is shown for a duration
+	in milliseconds. animation_update() is called once per main loop: it
+	draws at most one page of a picture per call and moves on to the next
+	frame when the system clock (timer2.c) says the frame has been shown
+	long enough. Text is written to the text framebuffer (textbuffer.h)
+	after the picture, textbuffer_refresh() sends it.
+
+	Example:
+		static const char alert_text[] PROGMEM = "ALERT!";
+		static const animation_text_t alert_lines[] PROGMEM = {
+			{ 7, 3, alert_text },
+		};
+		static const animation_frame_t alert_frames[] PROGMEM = {
+			{ image_alert, IMAGE_OVERWRITE, NULL, 0, 500 },
+			{ NULL, 0, alert_lines, 1, 500 },
+		};
+		static const animation_t alert PROGMEM = { alert_frames, 2, ANIMATION_LOOP };
+
+		animation_start(&alert);
+		while (1) {
+			animation_update();
+			textbuffer_refresh(4);
+			...
+		}
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef ANIMATION_H_
+#define ANIMATION_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <avr/pgmspace.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define ANIMATION_ONCE 0			//stops after the last frame
+#define ANIMATION_LOOP 1			//starts over after the last frame
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	uint8_t x;					//column (character)
+	uint8_t y;					//row (display page)
+	const char *string;			//in flash
+} animation_text_t;
+
+typedef struct {
+	const uint8_t *image;		//packed picture in flash, or NULL
+	uint8_t image_flags;		//IMAGE_OVERWRITE or IMAGE_ON_BLANK
+	const animation_text_t *text;	//text lines in flash, or NULL
+	uint8_t text_lines;
+	uint16_t duration_ms;
+} animation_frame_t;
+
+typedef struct {
+	const animation_frame_t *frames;	//in flash
+	uint8_t length;
+	uint8_t mode;				//ANIMATION_ONCE or ANIMATION_LOOP
+} animation_t;
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	animation_start()
+
+	Starts an animation from its first frame, a running animation is
+	replaced. Nothing is drawn until animation_update().
+
+	Inputs:		const animation_t *animation, in flash
+******************************************************************************/
+void animation_start(const animation_t *animation);
+
+/******************************************************************************
+	Function name:	animation_stop()
+
+	Stops the running animation. What has been drawn stays on the OLED.
+******************************************************************************/
+void animation_stop(void);
+
+/******************************************************************************
+	Function name:	animation_is_running()
+
+	Outputs:	uint8_t, 1 (true) while an animation is running
+******************************************************************************/
+uint8_t animation_is_running(void);
+
+/******************************************************************************
+	Function name:	animation_update()
+
+	Advances the running animation, call once per main loop. Draws at most
+	one page of a picture (about 2.5 ms on the bus at 400 kHz) and returns.
+
+	Outputs:	uint8_t, 1 (true) if something was drawn or written
+******************************************************************************/
+uint8_t animation_update(void);
+
+
+
+#endif /* ANIMATION_H_ */
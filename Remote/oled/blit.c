@@ -0,0 +1,266 @@
+/******************************************************************************
+	BLIT ENGINE IMPLEMENTATION FILE
+
+	This file contains the implementation of the blit engine. See blit.h
+	for a description.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "blit.h"
+#include "lcd.h"
+#include <avr/pgmspace.h>
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static void apply(uint8_t *dst, uint8_t bits, uint8_t valid, uint8_t color);
+static void circle(const blit_target_t *target, int16_t cx, int16_t cy,
+				   uint8_t r, uint8_t fill, uint8_t color);
+
+
+
+/******************************************************************************
+	Function name:	blit_column()
+
+	This is a public function and is described in the header file, blit.h.
+******************************************************************************/
+void blit_column(const blit_target_t *target, int16_t x, int16_t y,
+				 uint8_t bits, uint8_t valid, uint8_t color) {
+	int16_t page = (y >> 3) - target->first_page;	//floor, also for y < 0
+	uint8_t shift = y & 7;
+
+	x -= target->first_column;
+	if (x < 0 || x >= target->columns) {
+		return;
+	}
+
+	//upper part of the column in this page, the rest in the next one
+	if (page >= 0 && page < target->pages) {
+		apply(target->buffer + page * target->columns + x,
+			  bits << shift, valid << shift, color);
+	}
+
+	page++;
+	if (shift && page >= 0 && page < target->pages) {
+		apply(target->buffer + page * target->columns + x,
+			  bits >> (8 - shift), valid >> (8 - shift), color);
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	blit_vspan()
+
+	This is a public function and is described in the header file, blit.h.
+******************************************************************************/
+void blit_vspan(const blit_target_t *target, int16_t x, int16_t y1, int16_t y2,
+				uint8_t color) {
+	blit_fill_rect(target, x, y1, x, y2, color);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	blit_fill_rect()
+
+	This is a public function and is described in the header file, blit.h.
+******************************************************************************/
+void blit_fill_rect(const blit_target_t *target, int16_t x1, int16_t y1,
+					int16_t x2, int16_t y2, uint8_t color) {
+	int16_t top = target->first_page * 8;
+	int16_t bottom = top + target->pages * 8 - 1;
+	uint8_t *dst;
+	uint8_t mask;
+	uint8_t page;
+	uint8_t last_page;
+	int16_t x;
+
+	//clip to the target, x relative to its first column
+	x1 -= target->first_column;
+	x2 -= target->first_column;
+	if (x1 < 0) {
+		x1 = 0;
+	}
+	if (x2 > target->columns - 1) {
+		x2 = target->columns - 1;
+	}
+	if (y1 < top) {
+		y1 = top;
+	}
+	if (y2 > bottom) {
+		y2 = bottom;
+	}
+	if (x1 > x2 || y1 > y2) {
+		return;
+	}
+
+	page = (y1 - top) >> 3;
+	last_page = (y2 - top) >> 3;
+
+	//one mask per page, the same for all columns
+	for (; page <= last_page; page++) {
+		mask = 0xFF;
+		if (page == (uint8_t)((y1 - top) >> 3)) {
+			mask &= 0xFF << (y1 & 7);
+		}
+		if (page == last_page) {
+			mask &= 0xFF >> (7 - (y2 & 7));
+		}
+
+		dst = target->buffer + page * target->columns + x1;
+		for (x = x1; x <= x2; x++, dst++) {
+			apply(dst, mask, mask, color);
+		}
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function names:	blit_circle(), blit_fill_circle()
+
+	These are public functions and are described in the header file,
+	blit.h.
+******************************************************************************/
+void blit_circle(const blit_target_t *target, int16_t center_x, int16_t center_y,
+				 uint8_t radius, uint8_t color) {
+	circle(target, center_x, center_y, radius, 0, color);
+}
+
+void blit_fill_circle(const blit_target_t *target, int16_t center_x, int16_t center_y,
+					  uint8_t radius, uint8_t color) {
+	circle(target, center_x, center_y, radius, 1, color);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	blit_bitmap()
+
+	This is a public function and is described in the header file, blit.h.
+******************************************************************************/
+void blit_bitmap(const blit_target_t *target, int16_t x, int16_t y,
+				 const uint8_t *bitmap, uint8_t width, uint8_t height, uint8_t color) {
+	uint8_t byte_width = (width + 7) / 8;
+	int16_t top = target->first_page * 8;
+	int16_t bottom = top + target->pages * 8 - 1;
+	uint8_t columns[8];
+	uint8_t valid;
+	uint8_t rows;
+	uint8_t row;
+	uint8_t block;
+	uint8_t c;
+
+	for (row = 0; row < height; row += 8) {
+		//skip row blocks outside the target
+		if (y + row + 7 < top || y + row > bottom) {
+			continue;
+		}
+
+		rows = height - row < 8 ? height - row : 8;
+		valid = 0xFF >> (8 - rows);
+
+		for (block = 0; block < byte_width; block++) {
+			//transpose 8 row bytes into 8 column bytes
+			for (c = 0; c < 8; c++) {
+				columns[c] = 0;
+			}
+			for (uint8_t r = 0; r < rows; r++) {
+				uint8_t bits = pgm_read_byte(bitmap + (row + r) * byte_width + block);
+				uint8_t bit = 1 << r;
+
+				for (c = 0; c < 8; c++, bits <<= 1) {
+					if (bits & 0x80) {
+						columns[c] |= bit;
+					}
+				}
+			}
+
+			for (c = 0; c < 8 && block * 8 + c < width; c++) {
+				blit_column(target, x + block * 8 + c, y + row, columns[c], valid, color);
+			}
+		}
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Writes the valid pixels of a page byte.
+******************************************************************************/
+static void apply(uint8_t *dst, uint8_t bits, uint8_t valid, uint8_t color) {
+	if (color == WHITE) {
+		*dst = (*dst & ~valid) | (bits & valid);
+	} else if (color == BLIT_INVERT) {
+		*dst ^= bits & valid;
+	} else {
+		*dst = (*dst & ~valid) | (~bits & valid);
+	}
+}
+
+
+
+/******************************************************************************
+	Circle, outline or filled, drawn column by column. h is the half height
+	of the circle in column cx +/- dx, the outline of a column runs from h
+	down to just above the half height of the next column out.
+******************************************************************************/
+static void circle(const blit_target_t *target, int16_t cx, int16_t cy,
+				   uint8_t r, uint8_t fill, uint8_t color) {
+	uint32_t rr = (uint32_t)r * r + r;		//(r + 1/2)^2, rounder edges
+	int16_t h = r;
+	int16_t next;
+	int16_t low;
+	uint8_t dx = 0;
+
+	while (1) {
+		if (dx < r) {
+			next = h;
+			while ((uint32_t)next * next + (uint32_t)(dx + 1) * (dx + 1) > rr) {
+				next--;
+			}
+		} else {
+			next = -1;
+		}
+
+		low = fill ? 0 : next + 1;
+		if (low > h) {
+			low = h;
+		}
+
+		for (uint8_t side = 0; side < 2; side++) {
+			int16_t x = side ? cx - dx : cx + dx;
+
+			if (low <= 0) {
+				blit_vspan(target, x, cy - h, cy + h, color);
+			} else {
+				blit_vspan(target, x, cy - h, cy - low, color);
+				blit_vspan(target, x, cy + low, cy + h, color);
+			}
+
+			if (dx == 0) {
+				break;
+			}
+		}
+
+		if (dx == r) {
+			break;
+		}
+		h = next;
+		dx++;
+	}
+}
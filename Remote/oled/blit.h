@@ -0,0 +1,116 @@
+/******************************************************************************
+	BLIT ENGINE HEADER FILE
+
+	This file contains the interface to the blit engine, the rasteriser
+	shared by the page renderer (pagerender.c) and the GRAPHICMODE of
+	lcd.c.
+
+	The engine draws into a target of display pages, one byte per column,
+	bit 0 of a byte being the top pixel of the page. A target covers a
+	range of pages and columns: the whole display (the lcd.c framebuffer),
+	a single page (the page buffer of pagerender.c) or a few columns (the
+	widgets of widget.c). Coordinates are display pixels and everything
+	outside the target is clipped.
+
+	All operations work on page bytes: a column of up to 8 pixels at any y
+	offset is written as a shifted mask into at most two page bytes, and
+	fills are vertical spans, one masked byte per page and column. No
+	pixel is drawn twice by one operation, so BLIT_INVERT is exact.
+
+	Colors: WHITE and BLACK (lcd.h) set and clear pixels, BLIT_INVERT
+	toggles them.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef BLIT_H_
+#define BLIT_H_
+
+#include <stdint.h>
+#include "lcd.h"
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define BLIT_INVERT 0x02
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	uint8_t *buffer;			//pages * columns bytes, page by page
+	uint8_t first_page;			//display page of the first buffer page
+	uint8_t pages;
+	uint8_t first_column;		//display column of the first buffer column
+	uint8_t columns;
+} blit_target_t;
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	blit_column()
+
+	Writes a column of 8 pixels with its top at any y. Only the pixels in
+	valid are drawn: set bits of bits with the color, clear bits with the
+	opposite color (with BLIT_INVERT set bits are toggled). valid == bits
+	draws the set bits only (transparent), e.g. glyphs.
+
+	Inputs:		const blit_target_t *target
+				int16_t x, int16_t y, top pixel of the column
+				uint8_t bits, uint8_t valid
+				uint8_t color
+******************************************************************************/
+void blit_column(const blit_target_t *target, int16_t x, int16_t y,
+				 uint8_t bits, uint8_t valid, uint8_t color);
+
+/******************************************************************************
+	Function name:	blit_vspan()
+
+	Draws the pixels y1..y2 (y1 <= y2) of a column.
+******************************************************************************/
+void blit_vspan(const blit_target_t *target, int16_t x, int16_t y1, int16_t y2,
+				uint8_t color);
+
+/******************************************************************************
+	Function name:	blit_fill_rect()
+
+	Fills the rectangle x1..x2, y1..y2 (x1 <= x2, y1 <= y2), one masked
+	byte per page and column.
+******************************************************************************/
+void blit_fill_rect(const blit_target_t *target, int16_t x1, int16_t y1,
+					int16_t x2, int16_t y2, uint8_t color);
+
+/******************************************************************************
+	Function names:	blit_circle(), blit_fill_circle()
+
+	Draws the outline of a circle or fills it, one vertical span (two for
+	the outline) per column.
+******************************************************************************/
+void blit_circle(const blit_target_t *target, int16_t center_x, int16_t center_y,
+				 uint8_t radius, uint8_t color);
+void blit_fill_circle(const blit_target_t *target, int16_t center_x, int16_t center_y,
+					  uint8_t radius, uint8_t color);
+
+/******************************************************************************
+	Function name:	blit_bitmap()
+
+	Draws a bitmap in flash in the row format of lcd_drawBitmap() (MSB
+	first, rows padded to whole bytes). Set bits are drawn with the color,
+	clear bits with the opposite color. Each block of 8x8 pixels is read
+	with 8 flash reads and turned into 8 column bytes for blit_column().
+******************************************************************************/
+void blit_bitmap(const blit_target_t *target, int16_t x, int16_t y,
+				 const uint8_t *bitmap, uint8_t width, uint8_t height, uint8_t color);
+
+
+
+#endif /* BLIT_H_ */
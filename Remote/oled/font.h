@@ -12,20 +12,4 @@
 
 extern const char ssd1306oled_font[][6] PROGMEM;
 extern const char special_char[][2] PROGMEM;
-extern const unsigned char GudnyBjorkOdinsdottir_128x64[][768] PROGMEM;
-extern const unsigned char BR[] PROGMEM;
-extern const unsigned char HKR_logo[] PROGMEM;
-extern const unsigned char hkr_logo_2[] PROGMEM;
-extern const unsigned char hkr_full[] PROGMEM;
-extern const unsigned char slak_2020[] PROGMEM;
-extern const unsigned char niklas_lantau[] PROGMEM;
-extern const unsigned char haydar[] PROGMEM;
-extern const unsigned char hkr_logo_two[] PROGMEM;
-extern const unsigned char got_one[] PROGMEM;
-extern const unsigned char python_one[] PROGMEM;
-extern const unsigned char nazila[] PROGMEM;
-extern const unsigned char collision_one[] PROGMEM;
-extern const unsigned char safe_distance[] PROGMEM;
-extern const unsigned char team_one[] PROGMEM;
-extern const unsigned char kungen[] PROGMEM;
 #endif
@@ -0,0 +1,160 @@
+/******************************************************************************
+	PACKED IMAGE IMPLEMENTATION FILE
+
+	This file contains the streaming decoder of packed images. See image.h
+	for a description of the format.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "image.h"
+#include "lcd.h"
+#include "../../Common/i2c/i2cmaster.h"
+#include <avr/pgmspace.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Skipping a blank run inside a page costs a new transaction with position
+//(address, 3 or 4 position commands and a data header, 8 to 10 bytes), so
+//shorter runs are written as zeros. Runs to the end of the page are always
+//skipped.
+#define IMAGE_SKIP_MIN_COLUMNS 10
+
+
+
+/******************************************************************************
+	Function name:	image_pages()
+
+	This is a public function and is described in the header file, image.h.
+******************************************************************************/
+uint8_t image_pages(const uint8_t *image) {
+	return pgm_read_byte(image);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	image_begin()
+
+	This is a public function and is described in the header file, image.h.
+******************************************************************************/
+void image_begin(image_decoder_t *decoder, const uint8_t *image, uint8_t flags) {
+	decoder->pages = pgm_read_byte(image);
+	decoder->next = image + 1;
+	decoder->page = 0;
+	decoder->flags = flags;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	image_draw_page()
+
+	This is a public function and is described in the header file, image.h.
+
+	The data transaction is opened at the first column that is sent, so a
+	page that is skipped completely costs nothing on the bus.
+******************************************************************************/
+uint8_t image_draw_page(image_decoder_t *decoder) {
+	uint8_t column = 0;
+	uint8_t open = 0;
+	uint8_t token;
+	uint8_t value;
+	uint8_t n;
+	uint8_t i;
+
+	if (decoder->page >= decoder->pages) {
+		return 0;
+	}
+
+	while (column < IMAGE_COLUMNS) {
+		token = pgm_read_byte(decoder->next++);
+
+		switch (token & IMAGE_TOKEN_TYPE_MASK) {
+			case IMAGE_TOKEN_BLANK:
+				//one run, even if the packer had to split it
+				n = (token & IMAGE_TOKEN_COUNT_MASK) + 1;
+				while (column + n < IMAGE_COLUMNS
+					   && (pgm_read_byte(decoder->next) & IMAGE_TOKEN_TYPE_MASK) == IMAGE_TOKEN_BLANK) {
+					n += (pgm_read_byte(decoder->next++) & IMAGE_TOKEN_COUNT_MASK) + 1;
+				}
+
+				if ((decoder->flags & IMAGE_ON_BLANK)
+					&& (n >= IMAGE_SKIP_MIN_COLUMNS || column + n == IMAGE_COLUMNS)) {
+					if (open) {
+						i2c_stop();
+						open = 0;
+					}
+				} else {
+					if (!open) {
+						lcd_data_begin(column, decoder->page);
+						open = 1;
+					}
+					for (i = 0; i < n; i++) {
+						i2c_write(0x00);
+					}
+				}
+				break;
+
+			case IMAGE_TOKEN_REPEAT:
+				n = (token & IMAGE_TOKEN_COUNT_MASK) + IMAGE_REPEAT_MIN;
+				value = pgm_read_byte(decoder->next++);
+
+				if (!open) {
+					lcd_data_begin(column, decoder->page);
+					open = 1;
+				}
+				for (i = 0; i < n; i++) {
+					i2c_write(value);
+				}
+				break;
+
+			default:
+				n = token + 1;
+
+				if (!open) {
+					lcd_data_begin(column, decoder->page);
+					open = 1;
+				}
+				for (i = 0; i < n; i++) {
+					i2c_write(pgm_read_byte(decoder->next++));
+				}
+				break;
+		}
+
+		column += n;
+	}
+
+	if (open) {
+		i2c_stop();
+	}
+
+	decoder->page++;
+
+	return decoder->page < decoder->pages;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	image_draw()
+
+	This is a public function and is described in the header file, image.h.
+******************************************************************************/
+uint8_t image_draw(const uint8_t *image, uint8_t flags) {
+	image_decoder_t decoder;
+
+	image_begin(&decoder, image, flags);
+
+	while (image_draw_page(&decoder)) {}
+
+	return decoder.pages;
+}
+/*****************************************************************************/
@@ -0,0 +1,120 @@
+/******************************************************************************
+	PACKED IMAGE HEADER FILE
+
+	This file contains the interface to draw packed images on the OLED.
+
+	Pictures are stored in flash in a packed format made by the host tool
+	tools/imgpack (see Remote/oled/images.c) and streamed from flash
+	straight into the I2C data stream, page by page, without a RAM buffer.
+
+	Packed format:
+		byte 0		number of pages, drawn from page 0
+		tokens		per page, covering exactly 128 columns, a token
+					never crosses a page:
+			0x00-0x7F	literal, the next (token + 1) bytes are columns
+			0x80-0xBF	repeat, the next byte is repeated
+						((token & 0x3F) + 3) times
+			0xC0-0xFF	blank, ((token & 0x3F) + 1) zero columns, no
+						data bytes
+
+	When the OLED is known to be blank under the image (IMAGE_ON_BLANK,
+	e.g. right after lcd_clrscr()), long blank runs are not sent: the
+	decoder ends the data transaction and continues at the next column
+	with content, and blank pages are skipped completely. Otherwise
+	(IMAGE_OVERWRITE) blank runs are written as zeros.
+
+	Example:
+		lcd_clrscr();
+		image_draw(image_slak_2020, IMAGE_ON_BLANK);
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef IMAGE_H_
+#define IMAGE_H_
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define IMAGE_COLUMNS 128
+
+//Tokens
+#define IMAGE_TOKEN_TYPE_MASK 0xC0
+#define IMAGE_TOKEN_COUNT_MASK 0x3F
+#define IMAGE_TOKEN_LITERAL 0x00
+#define IMAGE_TOKEN_REPEAT 0x80
+#define IMAGE_TOKEN_BLANK 0xC0
+#define IMAGE_REPEAT_MIN 3
+
+//Flags
+#define IMAGE_OVERWRITE 0			//blank columns are written as zeros
+#define IMAGE_ON_BLANK 1			//OLED is blank under the image
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	const uint8_t *next;		//next token, in flash
+	uint8_t page;				//next page to draw
+	uint8_t pages;				//pages in the image
+	uint8_t flags;				//IMAGE_xxx
+} image_decoder_t;
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	image_pages()
+
+	Inputs:		const uint8_t *image, packed image in flash
+	Outputs:	uint8_t, number of pages (rows of 8 pixels) in the image
+******************************************************************************/
+uint8_t image_pages(const uint8_t *image);
+
+/******************************************************************************
+	Function name:	image_begin()
+
+	Prepares a decoder to draw an image one page at a time with
+	image_draw_page(), e.g. one page per pass of the main loop.
+
+	Inputs:		const uint8_t *image, packed image in flash
+				uint8_t flags, IMAGE_OVERWRITE or IMAGE_ON_BLANK
+	Outputs:	image_decoder_t *decoder
+******************************************************************************/
+void image_begin(image_decoder_t *decoder, const uint8_t *image, uint8_t flags);
+
+/******************************************************************************
+	Function name:	image_draw_page()
+
+	Draws the next page of the image, blocking until it is on the bus.
+
+	Inputs:		image_decoder_t *decoder
+	Outputs:	uint8_t, 1 if there are pages left, 0 when the image is done
+******************************************************************************/
+uint8_t image_draw_page(image_decoder_t *decoder);
+
+/******************************************************************************
+	Function name:	image_draw()
+
+	Draws a whole image, blocking.
+
+	Inputs:		const uint8_t *image, packed image in flash
+				uint8_t flags, IMAGE_OVERWRITE or IMAGE_ON_BLANK
+	Outputs:	uint8_t, number of pages drawn
+******************************************************************************/
+uint8_t image_draw(const uint8_t *image, uint8_t flags);
+
+
+
+#endif /* IMAGE_H_ */
@@ -0,0 +1,87 @@
+/******************************************************************************
+	PACKED IMAGES
+
+	Generated by tools/imgpack from tools/imgpack/bitmaps.c, do not edit.
+	The format is described in image.h.
+******************************************************************************/
+
+#include "images.h"
+
+//slak_2020, 8 pages, 1024 bytes packed to 322
+const uint8_t image_slak_2020[] PROGMEM = {
+	0x08, 0xFF, 0xFF, 0xC7, 0x00, 0xFC, 0x83, 0xFF, 0x86, 0x03, 0x83, 0x1F, 0x00, 0x1E, 0xC5, 0x84,
+	0xFF, 0xD3, 0x09, 0xC0, 0xF0, 0xFC, 0xFE, 0xFF, 0xFF, 0x3F, 0x0F, 0x0F, 0x1F, 0x80, 0xFF, 0x03,
+	0xFC, 0xF0, 0xE0, 0x80, 0xC8, 0x84, 0xFF, 0xC1, 0x0F, 0x80, 0xC0, 0xE0, 0xF0, 0xF0, 0xF8, 0xFC,
+	0x7E, 0x3F, 0x3F, 0x1F, 0x0F, 0x07, 0x03, 0x03, 0x01, 0xCC, 0xC8, 0x00, 0xF1, 0x82, 0xF3, 0x86,
+	0x03, 0x83, 0xFF, 0x00, 0xFE, 0xC5, 0x84, 0xFF, 0xCE, 0x03, 0x80, 0xE0, 0xF8, 0xFE, 0x80, 0xFF,
+	0x02, 0x3F, 0x3F, 0x33, 0x83, 0x30, 0x02, 0x33, 0x3F, 0x3F, 0x80, 0xFF, 0x03, 0xFE, 0xFC, 0xF0,
+	0xC0, 0xC4, 0x84, 0xFF, 0x0F, 0x00, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0x7E, 0xFC, 0xF8,
+	0xF0, 0xF0, 0xE0, 0xC0, 0x80, 0xCE, 0xC8, 0x00, 0x01, 0x90, 0x03, 0x01, 0x01, 0x01, 0xC5, 0x90,
+	0x03, 0xC1, 0x00, 0x01, 0x83, 0x03, 0xCD, 0x84, 0x03, 0xC3, 0x00, 0x01, 0x83, 0x03, 0xC9, 0x00,
+	0x01, 0x83, 0x03, 0x00, 0x02, 0xCC, 0xC7, 0x01, 0xE0, 0xE0, 0x82, 0xF0, 0x86, 0x30, 0x82, 0xF0,
+	0x01, 0xE0, 0xC0, 0xC4, 0x01, 0xE0, 0xE0, 0x81, 0xF0, 0x00, 0x70, 0x86, 0x30, 0x82, 0xF0, 0x01,
+	0xE0, 0xC0, 0xC4, 0x01, 0xE0, 0xE0, 0x82, 0xF0, 0x86, 0x30, 0x82, 0xF0, 0x01, 0xE0, 0xE0, 0xC4,
+	0x00, 0xE0, 0x83, 0xF0, 0x86, 0x30, 0x82, 0xF0, 0x01, 0xE0, 0xE0, 0xCC, 0xC7, 0x84, 0x03, 0x0F,
+	0x00, 0x80, 0xC0, 0xC0, 0xE0, 0xF0, 0xF0, 0xF8, 0xFC, 0xFF, 0x7F, 0x3F, 0x3F, 0x1F, 0x0F, 0x07,
+	0xC4, 0x83, 0xFF, 0xC9, 0x84, 0xFF, 0xC4, 0x84, 0x03, 0x0F, 0x00, 0x80, 0xC0, 0xC0, 0xE0, 0xF0,
+	0xF0, 0xF8, 0xFC, 0xFF, 0x7F, 0x3F, 0x3F, 0x1F, 0x0F, 0x07, 0xC4, 0x84, 0xFF, 0xC8, 0x84, 0xFF,
+	0xCC, 0xC7, 0x05, 0x30, 0x38, 0x38, 0x3C, 0x3C, 0x3E, 0x81, 0x3F, 0x04, 0x37, 0x37, 0x33, 0x33,
+	0x31, 0x85, 0x30, 0xC4, 0x00, 0x1F, 0x82, 0x3F, 0x00, 0x38, 0x86, 0x30, 0x83, 0x3F, 0x00, 0x0F,
+	0xC4, 0x05, 0x30, 0x38, 0x38, 0x3C, 0x3C, 0x3E, 0x81, 0x3F, 0x04, 0x37, 0x37, 0x33, 0x33, 0x31,
+	0x84, 0x30, 0x00, 0x20, 0xC4, 0x00, 0x1F, 0x83, 0x3F, 0x86, 0x30, 0x83, 0x3F, 0x00, 0x1F, 0xCC,
+	0xFF, 0xFF
+};
+
+//hkr_logo_two, 8 pages, 1024 bytes packed to 203
+const uint8_t image_hkr_logo_two[] PROGMEM = {
+	0x08, 0x82, 0xFF, 0x98, 0x07, 0x81, 0xFF, 0x96, 0x07, 0xBF, 0xFF, 0x00, 0xFF, 0x82, 0xFF, 0x81,
+	0xFC, 0xD3, 0x80, 0x3C, 0x81, 0x3F, 0x80, 0x3C, 0xD2, 0x80, 0xFC, 0xBF, 0xFF, 0x00, 0xFF, 0x86,
+	0xFF, 0xD3, 0x87, 0xF0, 0xD2, 0xBF, 0xFF, 0x81, 0xFF, 0x82, 0xFF, 0x00, 0xC0, 0x96, 0x80, 0x00,
+	0xC0, 0x81, 0xFF, 0x00, 0xC0, 0x95, 0x80, 0xBF, 0xFF, 0x00, 0xFF, 0x82, 0xFF, 0x98, 0x03, 0x81,
+	0xFF, 0x96, 0x03, 0x83, 0xFF, 0xA8, 0x03, 0x81, 0x07, 0x04, 0x0F, 0x0F, 0x1F, 0x1F, 0x3F, 0x86,
+	0xFF, 0x86, 0xFF, 0xD2, 0x0A, 0xBF, 0x3F, 0x1F, 0x1F, 0x0F, 0x0F, 0x07, 0x03, 0x03, 0x01, 0x01,
+	0xC7, 0x08, 0x20, 0x20, 0x70, 0xF8, 0xF8, 0xFC, 0xFC, 0xFE, 0xFE, 0x8B, 0xFF, 0xD2, 0x00, 0x0F,
+	0x83, 0x1F, 0x80, 0x0F, 0x00, 0x06, 0xCE, 0x04, 0x80, 0x80, 0xC0, 0xE0, 0xF8, 0x85, 0xFF, 0x82,
+	0xFF, 0x81, 0x3F, 0xD2, 0x08, 0x3F, 0x3F, 0x3E, 0x3E, 0xFC, 0xF8, 0xF8, 0xF0, 0x20, 0xCD, 0x06,
+	0x01, 0x01, 0x03, 0x07, 0x0F, 0x0F, 0x1F, 0x80, 0x3F, 0x83, 0xFF, 0x80, 0x3F, 0xD2, 0x81, 0x3C,
+	0x06, 0xFC, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80, 0xCC, 0x05, 0x01, 0x03, 0x03, 0x07, 0x0F, 0x1F,
+	0x81, 0x3F, 0x82, 0xFF, 0x82, 0xFF, 0x98, 0xE0, 0x81, 0xFF, 0x96, 0xE0, 0x83, 0xFF, 0x97, 0xE0,
+	0x85, 0xFF, 0x03, 0xFE, 0xFC, 0xF8, 0xF0, 0x8F, 0xE0, 0x82, 0xFF
+};
+
+//collision_one, 8 pages, 1024 bytes packed to 363
+const uint8_t image_collision_one[] PROGMEM = {
+	0x08, 0x80, 0xFF, 0x05, 0x1F, 0x07, 0xE3, 0xF3, 0x73, 0x3B, 0xBF, 0x1B, 0xA9, 0x1B, 0x05, 0x3B,
+	0x7B, 0xF3, 0xE3, 0x07, 0x0F, 0x80, 0xFF, 0x80, 0xFF, 0xC1, 0x01, 0xFF, 0xFF, 0xF2, 0x01, 0x60,
+	0xE0, 0xFC, 0x01, 0xFF, 0xFF, 0xC1, 0x80, 0xFF, 0x80, 0xFF, 0xC1, 0x01, 0xFF, 0xFF, 0xE9, 0x01,
+	0x02, 0x04, 0xC4, 0x04, 0x0C, 0x1C, 0x38, 0x61, 0xC0, 0xC1, 0x01, 0xC0, 0xC0, 0xC2, 0x01, 0xFC,
+	0x18, 0xC2, 0x02, 0x20, 0x18, 0x08, 0xEC, 0x01, 0xFF, 0xFF, 0xC1, 0x80, 0xFF, 0x80, 0xFF, 0xC1,
+	0x01, 0xFF, 0xFF, 0xD7, 0x00, 0x80, 0x81, 0xC0, 0x83, 0x60, 0x01, 0xE0, 0xE0, 0x84, 0x60, 0x0D,
+	0x70, 0x71, 0xF0, 0xE2, 0xE0, 0xC0, 0x80, 0x82, 0x04, 0x00, 0x09, 0x02, 0x00, 0x03, 0xC2, 0x00,
+	0x03, 0xC1, 0x08, 0x04, 0x02, 0x21, 0x10, 0x08, 0x0C, 0x04, 0x02, 0x03, 0xC3, 0x02, 0x01, 0x81,
+	0xC0, 0x85, 0x60, 0x8A, 0xC0, 0x00, 0x80, 0xCB, 0x01, 0xFF, 0xFF, 0xC1, 0x80, 0xFF, 0x80, 0xFF,
+	0xC1, 0x01, 0xFF, 0xFF, 0xC6, 0x81, 0x80, 0x81, 0xC0, 0x81, 0xE0, 0x05, 0xF0, 0xF8, 0xEC, 0xE6,
+	0xE3, 0xE1, 0x87, 0xE0, 0x01, 0xF1, 0xFF, 0x87, 0xF0, 0x02, 0x71, 0x71, 0x73, 0x80, 0x7F, 0x04,
+	0xFE, 0xFE, 0xFC, 0x9C, 0x60, 0x81, 0xFC, 0x02, 0xFE, 0x7E, 0x7E, 0x80, 0xBE, 0x01, 0x7E, 0x7C,
+	0x80, 0xFC, 0x05, 0xF8, 0xFC, 0xFE, 0xF2, 0xF3, 0xF1, 0x82, 0xF0, 0x82, 0xE0, 0x01, 0xFC, 0xFF,
+	0x84, 0xE0, 0x0B, 0xC0, 0xC1, 0xC3, 0xC7, 0xCF, 0xFE, 0xFE, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0xC3,
+	0x01, 0xFF, 0xFF, 0xC1, 0x80, 0xFF, 0x80, 0xFF, 0xC1, 0x01, 0xFF, 0xFF, 0xC3, 0x00, 0x1F, 0x80,
+	0x3F, 0x09, 0x0F, 0x73, 0xFB, 0xFD, 0xFD, 0xFF, 0xFD, 0xFD, 0xFB, 0x07, 0x87, 0x1F, 0x8C, 0x0F,
+	0x04, 0x07, 0x07, 0x01, 0x3E, 0x3F, 0x81, 0x7F, 0x05, 0x3F, 0x1E, 0x01, 0x07, 0x07, 0x00, 0x81,
+	0x03, 0x09, 0x00, 0x1E, 0x3F, 0x3F, 0x7F, 0x7F, 0x3F, 0x1F, 0x0C, 0x03, 0x85, 0x07, 0x8A, 0x0F,
+	0x81, 0x1F, 0x0C, 0x03, 0xF9, 0xFD, 0xFD, 0xFF, 0xFD, 0xFD, 0xF9, 0x23, 0x1F, 0x3F, 0x3F, 0x1F,
+	0xC3, 0x01, 0xFF, 0xFF, 0xC1, 0x80, 0xFF, 0x80, 0xFF, 0xC1, 0x01, 0xFF, 0xFF, 0xC4, 0x00, 0x06,
+	0x81, 0x0E, 0x83, 0x0F, 0xBF, 0x0E, 0x8E, 0x0E, 0x82, 0x0F, 0x81, 0x0E, 0x00, 0x06, 0xC4, 0x01,
+	0xFF, 0xFF, 0xC1, 0x80, 0xFF, 0x80, 0xFF, 0x05, 0xF0, 0xE0, 0xC7, 0xCF, 0xDE, 0xDC, 0xBF, 0x98,
+	0xA9, 0x98, 0x05, 0xDC, 0xDE, 0xCF, 0xC7, 0xE0, 0xF8, 0x80, 0xFF
+};
+
+//safe_distance, 4 pages, 512 bytes packed to 89
+const uint8_t image_safe_distance[] PROGMEM = {
+	0x04, 0xDF, 0x00, 0x01, 0xC8, 0x03, 0x80, 0xC0, 0xC0, 0x80, 0xE3, 0x03, 0x80, 0xC0, 0xC0, 0x80,
+	0xC7, 0x01, 0x01, 0x03, 0xDF, 0xE5, 0x03, 0xE0, 0xF0, 0xF8, 0xFB, 0x81, 0xFF, 0x02, 0xF8, 0xF0,
+	0xF0, 0xDD, 0x02, 0xF0, 0xF0, 0xF8, 0x81, 0xFF, 0x03, 0xFB, 0xF8, 0xF0, 0xE0, 0xE5, 0xE5, 0x02,
+	0x3F, 0x7F, 0x3F, 0x83, 0xFF, 0x01, 0x7F, 0x7F, 0xC2, 0x04, 0x18, 0x38, 0x3C, 0x7E, 0x5A, 0x8B,
+	0x18, 0x04, 0x5A, 0x7E, 0x3C, 0x18, 0x18, 0xC2, 0x01, 0x7F, 0x7F, 0x83, 0xFF, 0x02, 0x7F, 0x7F,
+	0x3F, 0xE5, 0xE8, 0x83, 0xFF, 0xE1, 0x83, 0xFF, 0xE8
+};
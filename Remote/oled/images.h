@@ -0,0 +1,19 @@
+/******************************************************************************
+	PACKED IMAGES HEADER FILE
+
+	Generated by tools/imgpack from tools/imgpack/bitmaps.c, do not edit.
+	Draw the images with image_draw() (image.h).
+******************************************************************************/
+
+#ifndef IMAGES_H_
+#define IMAGES_H_
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+extern const uint8_t image_slak_2020[] PROGMEM;
+extern const uint8_t image_hkr_logo_two[] PROGMEM;
+extern const uint8_t image_collision_one[] PROGMEM;
+extern const uint8_t image_safe_distance[] PROGMEM;
+
+#endif /* IMAGES_H_ */
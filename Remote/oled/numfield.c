@@ -0,0 +1,114 @@
+/******************************************************************************
+	NUMERIC FIELD IMPLEMENTATION FILE
+
+	This file contains implementations of the numeric fields of the text
+	framebuffer. See numfield.h for a description.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "numfield.h"
+#include "textbuffer.h"
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+//Powers of ten subtracted for the digits before the last one
+static const uint16_t powers_of_ten[NUMFIELD_MAX_WIDTH - 1] = {
+	10000, 1000, 100, 10
+};
+
+//Largest value shown by a field of 1..NUMFIELD_MAX_WIDTH characters
+static const uint16_t field_max[NUMFIELD_MAX_WIDTH] = {
+	9, 99, 999, 9999, 65535
+};
+
+
+
+/******************************************************************************
+	This function shows a value in a field. Nothing is done if the field
+	already shows the value. Values too large for the field are shown as
+	the largest value that fits, e.g. 999.
+
+	Inputs:		numfield_t *field
+				uint16_t value
+	Outputs:	void
+	Calls:		numfield_format(), textbuffer_puts()
+******************************************************************************/
+void numfield_set(numfield_t *field, uint16_t value) {
+	char text[NUMFIELD_MAX_WIDTH + 1];
+	uint8_t length;
+
+	if (value > field_max[field->width - 1]) {
+		value = field_max[field->width - 1];
+	}
+
+	if (field->valid && field->value == value) {
+		return;
+	}
+
+	length = numfield_format(value, text);
+	while (length < field->width) {
+		text[length++] = ' ';
+	}
+	text[length] = '\0';
+
+	textbuffer_puts(field->x, field->y, text);
+
+	field->value = value;
+	field->valid = 1;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function tells a field that its cells have been cleared or drawn
+	over, e.g. after textbuffer_clear(). The next value is written again.
+
+	Inputs:		numfield_t *field
+	Outputs:	void
+	Calls:		none
+******************************************************************************/
+void numfield_invalidate(numfield_t *field) {
+	field->valid = 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function writes the decimal digits of a value, without leading
+	zeros and without a terminating '\0'. Each digit is found by counting
+	how many times its power of ten can be subtracted, at most 9
+	subtractions per digit and no division.
+
+	Inputs:		uint16_t value
+	Outputs:	char *digits, at least NUMFIELD_MAX_WIDTH chars
+				uint8_t, number of digits
+	Calls:		none
+******************************************************************************/
+uint8_t numfield_format(uint16_t value, char *digits) {
+	uint8_t length = 0;
+	char digit;
+
+	for (uint8_t i = 0; i < NUMFIELD_MAX_WIDTH - 1; i++) {
+		digit = '0';
+		while (value >= powers_of_ten[i]) {
+			value -= powers_of_ten[i];
+			digit++;
+		}
+
+		if (length || digit != '0') {
+			digits[length++] = digit;
+		}
+	}
+
+	digits[length++] = '0' + value;
+
+	return length;
+}
+/*****************************************************************************/
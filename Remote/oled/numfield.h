@@ -0,0 +1,66 @@
+/******************************************************************************
+	NUMERIC FIELD HEADER FILE
+
+	This file contains the interface to interact with and use numfield.c.
+
+	A numeric field is a fixed number of text cells in the text framebuffer
+	(textbuffer.c) showing an unsigned number, left aligned and padded with
+	blanks. The field holds the value on display: setting the same value
+	again costs nothing, and a new value is converted to digits without a
+	division (subtraction of powers of ten) and written to the textbuffer,
+	which sends only the digits that change.
+
+	Example:
+		static numfield_t distance = NUMFIELD(3, 7, 4);
+
+		numfield_set(&distance, 123);
+		...
+		lcd_clrscr();
+		textbuffer_clear();
+		numfield_invalidate(&distance);
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef NUMFIELD_H_
+#define NUMFIELD_H_
+
+#include <stdint.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Digits of the largest value, 65535
+#define NUMFIELD_MAX_WIDTH 5
+
+//Field at column x (character) and row y, width characters wide
+#define NUMFIELD(x, y, width) { (x), (y), (width), 0, 0 }
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	uint8_t x;
+	uint8_t y;
+	uint8_t width;				//1..NUMFIELD_MAX_WIDTH
+	uint8_t valid;				//value is in the textbuffer
+	uint16_t value;
+} numfield_t;
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+void numfield_set(numfield_t *field, uint16_t value);
+void numfield_invalidate(numfield_t *field);
+uint8_t numfield_format(uint16_t value, char *digits);
+
+
+
+#endif /* NUMFIELD_H_ */
@@ -0,0 +1,371 @@
+/******************************************************************************
+	PAGE RENDERER IMPLEMENTATION FILE
+
+	This file contains the implementation of the page renderer. See
+	pagerender.h for a description.
+
+	The primitives are rasterised by the blit engine (blit.c) into a target
+	of one page, the page buffer.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "pagerender.h"
+#include "blit.h"
+#include "lcd.h"
+#include "font.h"
+#include "../../Common/i2c/i2cmaster.h"
+#include <avr/pgmspace.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define ITEM_PIXEL 0
+#define ITEM_LINE 1
+#define ITEM_RECT 2
+#define ITEM_FILL_RECT 3
+#define ITEM_CIRCLE 4
+#define ITEM_FILL_CIRCLE 5
+#define ITEM_BITMAP 6
+#define ITEM_TEXT 7
+
+#define GLYPH_WIDTH sizeof(FONT[0])
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+//One primitive, a to d depend on the type:
+//	pixel				x, y
+//	line, rectangles	x1, y1, x2, y2
+//	circles				center x, center y, radius
+//	bitmap				x, y, width, height
+//	text				x, y
+typedef struct {
+	uint8_t type;
+	uint8_t color;
+	uint8_t a;
+	uint8_t b;
+	uint8_t c;
+	uint8_t d;
+	const void *data;			//bitmap (flash) or string (SRAM)
+} item_t;
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static item_t items[PAGERENDER_MAX_ITEMS];
+static uint8_t item_count = 0;
+
+//The page being rendered
+static uint8_t page_buffer[DISPLAY_WIDTH];
+static blit_target_t target = { page_buffer, 0, 1, 0, DISPLAY_WIDTH };
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static uint8_t add(uint8_t type, uint8_t color, uint8_t a, uint8_t b,
+				   uint8_t c, uint8_t d, const void *data);
+static void rasterise(const item_t *item);
+static void line(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint8_t color);
+static void rect(const item_t *item);
+static void text(const item_t *item);
+
+
+
+/******************************************************************************
+	Function name:	pagerender_clear()
+
+	This is a public function and is described in the header file,
+	pagerender.h.
+******************************************************************************/
+void pagerender_clear(void) {
+	item_count = 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Functions adding primitives.
+
+	These are public functions and are described in the header file,
+	pagerender.h.
+******************************************************************************/
+uint8_t pagerender_pixel(uint8_t x, uint8_t y, uint8_t color) {
+	return add(ITEM_PIXEL, color, x, y, x, y, 0);
+}
+
+uint8_t pagerender_line(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color) {
+	return add(ITEM_LINE, color, x1, y1, x2, y2, 0);
+}
+
+uint8_t pagerender_rect(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color) {
+	return add(ITEM_RECT, color, x1, y1, x2, y2, 0);
+}
+
+uint8_t pagerender_fill_rect(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color) {
+	return add(ITEM_FILL_RECT, color, x1, y1, x2, y2, 0);
+}
+
+uint8_t pagerender_circle(uint8_t center_x, uint8_t center_y, uint8_t radius, uint8_t color) {
+	return add(ITEM_CIRCLE, color, center_x, center_y, radius, 0, 0);
+}
+
+uint8_t pagerender_fill_circle(uint8_t center_x, uint8_t center_y, uint8_t radius, uint8_t color) {
+	return add(ITEM_FILL_CIRCLE, color, center_x, center_y, radius, 0, 0);
+}
+
+uint8_t pagerender_bitmap(uint8_t x, uint8_t y, const uint8_t *bitmap,
+						  uint8_t width, uint8_t height, uint8_t color) {
+	return add(ITEM_BITMAP, color, x, y, width, height, bitmap);
+}
+
+uint8_t pagerender_text(uint8_t x, uint8_t y, const char *string, uint8_t color) {
+	return add(ITEM_TEXT, color, x, y, 0, 0, string);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	pagerender_page()
+
+	This is a public function and is described in the header file,
+	pagerender.h.
+******************************************************************************/
+void pagerender_page(uint8_t page) {
+	uint8_t i;
+
+	target.first_page = page;
+
+	for (i = 0; i < DISPLAY_WIDTH; i++) {
+		page_buffer[i] = 0;
+	}
+
+	for (i = 0; i < item_count; i++) {
+		rasterise(&items[i]);
+	}
+
+	lcd_data_begin(0, page);
+	for (i = 0; i < DISPLAY_WIDTH; i++) {
+		i2c_write(page_buffer[i]);
+	}
+	i2c_stop();
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	pagerender_display()
+
+	This is a public function and is described in the header file,
+	pagerender.h.
+******************************************************************************/
+void pagerender_display(void) {
+	for (uint8_t page = 0; page < PAGERENDER_PAGES; page++) {
+		pagerender_page(page);
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Adds an item to the display list. Lines are kept as given, rectangles
+	are stored with x1 <= x2 and y1 <= y2.
+******************************************************************************/
+static uint8_t add(uint8_t type, uint8_t color, uint8_t a, uint8_t b,
+				   uint8_t c, uint8_t d, const void *data) {
+	item_t *item;
+	uint8_t temp;
+
+	if (item_count >= PAGERENDER_MAX_ITEMS) {
+		return 0;
+	}
+
+	if (type == ITEM_RECT || type == ITEM_FILL_RECT) {
+		if (a > c) {
+			temp = a;
+			a = c;
+			c = temp;
+		}
+		if (b > d) {
+			temp = b;
+			b = d;
+			d = temp;
+		}
+	}
+
+	item = &items[item_count++];
+	item->type = type;
+	item->color = color;
+	item->a = a;
+	item->b = b;
+	item->c = c;
+	item->d = d;
+	item->data = data;
+
+	return 1;
+}
+
+
+
+/******************************************************************************
+	Draws the part of an item that falls on the page. Items that do not
+	touch the page rows are skipped at once.
+******************************************************************************/
+static void rasterise(const item_t *item) {
+	int16_t page_top = target.first_page * 8;
+	int16_t top;
+	int16_t bottom;
+
+	switch (item->type) {
+		case ITEM_CIRCLE:
+		case ITEM_FILL_CIRCLE:
+			top = (int16_t)item->b - item->c;
+			bottom = (int16_t)item->b + item->c;
+			break;
+
+		case ITEM_BITMAP:
+			top = item->b;
+			bottom = (int16_t)item->b + item->d - 1;
+			break;
+
+		case ITEM_TEXT:
+			top = item->b;
+			bottom = (int16_t)item->b + 7;
+			break;
+
+		default:
+			top = item->b < item->d ? item->b : item->d;
+			bottom = item->b < item->d ? item->d : item->b;
+			break;
+	}
+
+	if (bottom < page_top || top > page_top + 7) {
+		return;
+	}
+
+	switch (item->type) {
+		case ITEM_PIXEL:
+			blit_column(&target, item->a, item->b, 0x01, 0x01, item->color);
+			break;
+
+		case ITEM_LINE:
+			line(item->a, item->b, item->c, item->d, item->color);
+			break;
+
+		case ITEM_RECT:
+			rect(item);
+			break;
+
+		case ITEM_FILL_RECT:
+			blit_fill_rect(&target, item->a, item->b, item->c, item->d, item->color);
+			break;
+
+		case ITEM_CIRCLE:
+			blit_circle(&target, item->a, item->b, item->c, item->color);
+			break;
+
+		case ITEM_FILL_CIRCLE:
+			blit_fill_circle(&target, item->a, item->b, item->c, item->color);
+			break;
+
+		case ITEM_BITMAP:
+			blit_bitmap(&target, item->a, item->b, item->data, item->c, item->d, item->color);
+			break;
+
+		case ITEM_TEXT:
+			text(item);
+			break;
+
+		default:
+			break;
+	}
+}
+
+
+
+/******************************************************************************
+	Bresenham line, same pixels as lcd_drawLine().
+******************************************************************************/
+static void line(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint8_t color) {
+	int16_t dx = x2 > x1 ? x2 - x1 : x1 - x2;
+	int16_t dy = y2 > y1 ? y1 - y2 : y2 - y1;
+	int8_t sx = x1 < x2 ? 1 : -1;
+	int8_t sy = y1 < y2 ? 1 : -1;
+	int16_t err = dx + dy;
+	int16_t e2;
+
+	while (1) {
+		blit_column(&target, x1, y1, 0x01, 0x01, color);
+		if (x1 == x2 && y1 == y2) {
+			break;
+		}
+		e2 = 2 * err;
+		if (e2 > dy) {
+			err += dy;
+			x1 += sx;
+		}
+		if (e2 < dx) {
+			err += dx;
+			y1 += sy;
+		}
+	}
+}
+
+
+
+/******************************************************************************
+	Rectangle outline: full columns at the sides, top and bottom rows in
+	between.
+******************************************************************************/
+static void rect(const item_t *item) {
+	blit_vspan(&target, item->a, item->b, item->d, item->color);
+	if (item->c != item->a) {
+		blit_vspan(&target, item->c, item->b, item->d, item->color);
+	}
+
+	if (item->c - item->a >= 2) {
+		blit_fill_rect(&target, item->a + 1, item->b, item->c - 1, item->b, item->color);
+		if (item->d != item->b) {
+			blit_fill_rect(&target, item->a + 1, item->d, item->c - 1, item->d, item->color);
+		}
+	}
+}
+
+
+
+/******************************************************************************
+	Text, each glyph column is blitted at the pixel row of the text.
+******************************************************************************/
+static void text(const item_t *item) {
+	const char *s = item->data;
+	int16_t x = item->a;
+	uint8_t glyph;
+
+	for (; *s && x < DISPLAY_WIDTH; s++) {
+		if (*s < ' ') {
+			continue;
+		}
+
+		for (uint8_t i = 0; i < GLYPH_WIDTH; i++, x++) {
+			glyph = pgm_read_byte(&(FONT[*s - 32][i]));
+			blit_column(&target, x, item->b, glyph, glyph, item->color);
+		}
+	}
+}
@@ -0,0 +1,119 @@
+/******************************************************************************
+	PAGE RENDERER HEADER FILE
+
+	This file contains the interface to draw graphics on the OLED without a
+	framebuffer.
+
+	The GRAPHICMODE of lcd.c keeps the whole display in SRAM (1026 bytes,
+	half of the ATmega328P). The page renderer instead keeps a display list
+	of primitives and, for each of the 8 pages (rows of 8 pixels), clears a
+	single 128-byte page buffer, rasterises every primitive that touches
+	the page into it and streams the page to the OLED. The renderer uses
+	about 200 bytes of SRAM (page buffer and PAGERENDER_MAX_ITEMS items of
+	8 bytes).
+
+	Primitives are drawn in the order they were added, with WHITE (set
+	pixels), BLACK (clear pixels) or PAGERENDER_INVERT. Coordinates are
+	pixels, (0, 0) is the upper left corner, and whatever is outside the
+	display is clipped.
+
+	Example:
+		pagerender_clear();
+		pagerender_rect(0, 0, 127, 63, WHITE);
+		pagerender_fill_circle(64, 32, 20, WHITE);
+		pagerender_text(40, 29, "RedBot", PAGERENDER_INVERT);
+		pagerender_display();
+
+	The display list is kept until pagerender_clear(), so a page can also
+	be rendered one at a time, e.g. one page per main loop.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef PAGERENDER_H_
+#define PAGERENDER_H_
+
+#include <stdint.h>
+#include "lcd.h"
+#include "blit.h"
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Items in the display list
+#ifndef PAGERENDER_MAX_ITEMS
+#define PAGERENDER_MAX_ITEMS 8
+#endif
+
+#define PAGERENDER_PAGES (DISPLAY_HEIGHT / 8)
+
+//Colors, WHITE and BLACK are defined in lcd.h
+#define PAGERENDER_INVERT BLIT_INVERT
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	pagerender_clear()
+
+	Empties the display list.
+******************************************************************************/
+void pagerender_clear(void);
+
+/******************************************************************************
+	Functions adding primitives to the display list.
+
+	pagerender_pixel()			one pixel
+	pagerender_line()			line between two points
+	pagerender_rect()			outline of a rectangle, corners included
+	pagerender_fill_rect()		filled rectangle, corners included
+	pagerender_circle()			outline of a circle
+	pagerender_fill_circle()	filled circle
+	pagerender_bitmap()			bitmap in flash, in the row format of
+								lcd_drawBitmap() (MSB first, each row
+								padded to whole bytes). Set bits are drawn
+								with the color, clear bits with the
+								opposite color.
+	pagerender_text()			text with the 6x8 font, cleared pixels of
+								the glyphs are not drawn. The string is
+								not copied and must stay valid until it
+								has been rendered.
+
+	Outputs:	uint8_t, 1 if added, 0 if the display list is full
+******************************************************************************/
+uint8_t pagerender_pixel(uint8_t x, uint8_t y, uint8_t color);
+uint8_t pagerender_line(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color);
+uint8_t pagerender_rect(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color);
+uint8_t pagerender_fill_rect(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color);
+uint8_t pagerender_circle(uint8_t center_x, uint8_t center_y, uint8_t radius, uint8_t color);
+uint8_t pagerender_fill_circle(uint8_t center_x, uint8_t center_y, uint8_t radius, uint8_t color);
+uint8_t pagerender_bitmap(uint8_t x, uint8_t y, const uint8_t *bitmap,
+						  uint8_t width, uint8_t height, uint8_t color);
+uint8_t pagerender_text(uint8_t x, uint8_t y, const char *string, uint8_t color);
+
+/******************************************************************************
+	Function name:	pagerender_page()
+
+	Rasterises the display list into the page buffer and sends the page to
+	the OLED, blocking.
+
+	Inputs:		uint8_t page, 0..7
+******************************************************************************/
+void pagerender_page(uint8_t page);
+
+/******************************************************************************
+	Function name:	pagerender_display()
+
+	Renders and sends all pages.
+******************************************************************************/
+void pagerender_display(void);
+
+
+
+#endif /* PAGERENDER_H_ */
@@ -1,17 +1,23 @@
-/*
- * printout.h
- *
- * Created: 2020-10-22 21:26:22
- *  Author: Mattias Ahle
- */
-
-
-#ifndef PRINTOUT_H_
-#define PRINTOUT_H_
-
-void printout_lcd_pos_puts(int x, int y, char *string);
-void printout_clear_garbage_left_align(int string_length, char *buffer);
-
-
-
+/*
+ * printout.h
+ *
+ * Created: 2020-10-22 21:26:22
+ *  Author: Mattias Ahle
+ */
+
+
+#ifndef PRINTOUT_H_
+#define PRINTOUT_H_
+
+//Characters per display line, 128 columns / 6 columns per glyph
+#define PRINTOUT_COLUMNS 21
+
+#include <stdint.h>
+
+void printout_lcd_pos_puts(int x, int y, char *string);
+void printout_lcd_pos_putn(int x, int y, const char *string, uint8_t length);
+void printout_clear_garbage_left_align(int string_length, char *buffer);
+
+
+
 #endif /* PRINTOUT_H_ */
\ No newline at end of file
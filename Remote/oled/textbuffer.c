@@ -0,0 +1,355 @@
+/******************************************************************************
+	TEXT FRAMEBUFFER IMPLEMENTATION FILE
+
+	This file contains implementations of the text framebuffer for the
+	OLED. See textbuffer.h for a description.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "textbuffer.h"
+#include "printout.h"
+#include "lcd.h"
+#include "font.h"
+#include "../../Common/i2c/twi.h"
+#include <avr/pgmspace.h>
+#include <string.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Cell content not known, e.g. covered by a picture. Never equal to text,
+//so the next text written to the cell is always sent.
+#define CELL_UNKNOWN 0
+
+//Clean cells between two dirty runs are sent along when that is cheaper
+//than a new run, which costs a position command (7 bytes) and a data
+//header (2 bytes) against 6 bytes per character.
+#define MAX_CLEAN_GAP 1
+
+//Position commands and data control byte in front of a chunk
+#define CHUNK_HEADER LCD_DATA_HEADER_SIZE
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+//Characters wanted on the OLED
+static char cells[TEXTBUFFER_ROWS][TEXTBUFFER_COLUMNS];
+
+//Bit x of dirty[y] is set if cells[y][x] is not yet on the OLED
+static uint32_t dirty[TEXTBUFFER_ROWS];
+
+//Chunk on the bus: position and glyph columns in one transaction
+static uint8_t chunk[CHUNK_HEADER + TEXTBUFFER_CHUNK_CHARS * sizeof(FONT[0])];
+static twi_transaction_t chunk_transaction = {
+	.address = LCD_I2C_ADR,
+	.write_buffer = chunk,
+};
+static uint8_t chunk_row;
+static uint8_t chunk_column;
+static uint8_t chunk_length;
+
+//Cell where the search for the next dirty run continues
+static uint8_t resume_row = 0;
+static uint8_t resume_column = 0;
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static uint8_t find_run(uint8_t *y, uint8_t *x, uint8_t max_length);
+static uint8_t build_chunk(uint8_t y, uint8_t x, uint8_t length);
+static void mark_dirty(uint8_t y, uint8_t x, uint8_t length);
+static void resend_failed_chunk(void);
+
+
+
+/******************************************************************************
+	This function writes a string into the buffer at a given position.
+	Only cells that change are marked dirty. Characters that would pass the
+	right edge of the display are dropped.
+
+	Inputs:		uint8_t x, column (character)
+				uint8_t y, row (display page)
+				const char *string
+	Outputs:	void
+	Calls:		none
+******************************************************************************/
+void textbuffer_puts(uint8_t x, uint8_t y, const char *string) {
+	if (y >= TEXTBUFFER_ROWS) {
+		return;
+	}
+
+	while (*string && x < TEXTBUFFER_COLUMNS) {
+		if (cells[y][x] != *string) {
+			cells[y][x] = *string;
+			dirty[y] |= (1UL << x);
+		}
+		string++;
+		x++;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function writes a string from flash to the buffer, like
+	textbuffer_puts().
+
+	Inputs:		uint8_t x, uint8_t y, const char *progmem_string
+	Outputs:	void
+	Calls:		none
+******************************************************************************/
+void textbuffer_puts_P(uint8_t x, uint8_t y, const char *progmem_string) {
+	char c;
+
+	if (y >= TEXTBUFFER_ROWS) {
+		return;
+	}
+
+	while ((c = pgm_read_byte(progmem_string)) && x < TEXTBUFFER_COLUMNS) {
+		if (cells[y][x] != c) {
+			cells[y][x] = c;
+			dirty[y] |= (1UL << x);
+		}
+		progmem_string++;
+		x++;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function sends the next dirty run of at most max_chars characters
+	to the OLED, as one transaction on the TWI engine, and returns at once.
+	Nothing is done while the previous chunk is still on the bus. Call it
+	once per main loop, the search resumes after the last chunk sent.
+
+	Inputs:		uint8_t max_chars, 1..TEXTBUFFER_CHUNK_CHARS
+	Outputs:	uint8_t, 1 if a chunk was started
+	Calls:		find_run(), build_chunk(), twi_submit()
+******************************************************************************/
+uint8_t textbuffer_refresh(uint8_t max_chars) {
+	uint8_t y;
+	uint8_t x;
+	uint8_t length;
+
+	if (chunk_transaction.status == TWI_STATUS_PENDING) {
+		return 0;
+	}
+
+	if (chunk_transaction.status != TWI_STATUS_OK) {
+		resend_failed_chunk();
+	}
+
+	if (max_chars > TEXTBUFFER_CHUNK_CHARS) {
+		max_chars = TEXTBUFFER_CHUNK_CHARS;
+	}
+
+	length = find_run(&y, &x, max_chars);
+	if (length == 0) {
+		return 0;
+	}
+
+	chunk_transaction.write_length = build_chunk(y, x, length);
+	chunk_row = y;
+	chunk_column = x;
+	chunk_length = length;
+
+	//cells changed from now on are dirty again and sent later
+	for (uint8_t i = x; i < x + length; i++) {
+		dirty[y] &= ~(1UL << i);
+	}
+	resume_row = y;
+	resume_column = x + length;
+
+	if (!twi_submit(&chunk_transaction)) {
+		mark_dirty(y, x, length);			//queue full, try again later
+		return 0;
+	}
+
+	return 1;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function sends all dirty cells to the OLED and waits until they
+	are on the display.
+
+	Inputs:		none
+	Outputs:	void
+	Calls:		textbuffer_refresh(), twi_wait()
+******************************************************************************/
+void textbuffer_flush(void) {
+	twi_wait(&chunk_transaction);
+
+	while (textbuffer_refresh(TEXTBUFFER_CHUNK_CHARS)) {
+		if (twi_wait(&chunk_transaction) != TWI_STATUS_OK) {
+			break;							//OLED not answering, stays dirty
+		}
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function tells the buffer that the OLED has been cleared, e.g. by
+	lcd_clrscr(). All cells are set to blank and nothing is dirty.
+
+	Inputs:		none
+	Outputs:	void
+	Calls:		none
+******************************************************************************/
+void textbuffer_clear(void) {
+	memset(cells, ' ', sizeof(cells));
+	memset(dirty, 0, sizeof(dirty));
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function tells the buffer that rows have been drawn over, e.g. by
+	a picture. The cells of the rows are unknown until text is written to
+	them again, and pending changes are dropped.
+
+	Inputs:		uint8_t first_row, uint8_t last_row
+	Outputs:	void
+	Calls:		none
+******************************************************************************/
+void textbuffer_forget(uint8_t first_row, uint8_t last_row) {
+	for (uint8_t y = first_row; y <= last_row && y < TEXTBUFFER_ROWS; y++) {
+		memset(cells[y], CELL_UNKNOWN, TEXTBUFFER_COLUMNS);
+		dirty[y] = 0;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function returns 1 (true) if any cell waits to be flushed or is
+	still on the bus.
+
+	Inputs:		none
+	Outputs:	uint8_t
+	Calls:		none
+******************************************************************************/
+uint8_t textbuffer_is_dirty(void) {
+	if (chunk_transaction.status == TWI_STATUS_PENDING) {
+		return 1;
+	}
+
+	for (uint8_t y = 0; y < TEXTBUFFER_ROWS; y++) {
+		if (dirty[y]) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Finds the next dirty run of at most max_length characters, starting at
+	the resume position and wrapping around the display. Short clean gaps
+	of known cells are joined into the run.
+
+	Outputs:	uint8_t, run length (0 if nothing is dirty), *y and *x
+******************************************************************************/
+static uint8_t find_run(uint8_t *y, uint8_t *x, uint8_t max_length) {
+	uint8_t row;
+	uint8_t column;
+	uint8_t end;
+	uint8_t i;
+
+	for (i = 0; i <= TEXTBUFFER_ROWS; i++) {
+		row = (resume_row + i) % TEXTBUFFER_ROWS;
+		column = (i == 0) ? resume_column : 0;
+
+		while (column < TEXTBUFFER_COLUMNS && !(dirty[row] & (1UL << column))) {
+			column++;
+		}
+
+		if (column < TEXTBUFFER_COLUMNS) {
+			break;
+		}
+	}
+
+	if (i > TEXTBUFFER_ROWS) {
+		return 0;
+	}
+
+	end = column + 1;
+	for (i = end; i < TEXTBUFFER_COLUMNS && i < column + max_length &&
+				  i <= end + MAX_CLEAN_GAP && cells[row][i] != CELL_UNKNOWN; i++) {
+		if (dirty[row] & (1UL << i)) {
+			end = i + 1;
+		}
+	}
+
+	*y = row;
+	*x = column;
+
+	return end - column;
+}
+
+
+
+/******************************************************************************
+	Fills chunk[] with the position commands and the glyph columns of a
+	run, see lcd_data_header() for the position commands.
+
+	Outputs:	uint8_t, bytes in chunk[]
+******************************************************************************/
+static uint8_t build_chunk(uint8_t y, uint8_t x, uint8_t length) {
+	uint8_t *p = chunk + lcd_data_header(chunk, x * sizeof(FONT[0]), y);
+
+	for (uint8_t j = x; j < x + length; j++) {
+		for (uint8_t i = 0; i < sizeof(FONT[0]); i++) {
+			*p++ = pgm_read_byte(&(FONT[cells[y][j] - 32][i]));
+		}
+	}
+
+	return p - chunk;
+}
+
+
+
+/******************************************************************************
+	Marks a run of cells dirty again.
+******************************************************************************/
+static void mark_dirty(uint8_t y, uint8_t x, uint8_t length) {
+	for (uint8_t i = x; i < x + length; i++) {
+		dirty[y] |= (1UL << i);
+	}
+}
+
+
+
+/******************************************************************************
+	Marks the cells of a chunk that did not reach the OLED dirty again.
+	Cells forgotten meanwhile are not sent.
+******************************************************************************/
+static void resend_failed_chunk(void) {
+	for (uint8_t i = chunk_column; i < chunk_column + chunk_length; i++) {
+		if (cells[chunk_row][i] != CELL_UNKNOWN) {
+			dirty[chunk_row] |= (1UL << i);
+		}
+	}
+
+	chunk_transaction.status = TWI_STATUS_OK;
+}
@@ -0,0 +1,57 @@
+/******************************************************************************
+	TEXT FRAMEBUFFER HEADER FILE
+
+	This file contains the interface to interact with and use textbuffer.c.
+
+	The text framebuffer holds the 21x8 characters wanted on the OLED. Text
+	is written to the buffer with textbuffer_puts(), which only marks the
+	cells that really change as dirty (one bit per cell in a bitmask per
+	row), so printing the same text again costs no bytes on the bus.
+
+	textbuffer_refresh() is the display task. Each call sends at most one
+	chunk of a dirty run (position and glyph columns in one transaction)
+	through the TWI engine and returns without waiting for the bus, so the
+	time it takes from the main loop is bounded whatever is on screen. The
+	next call continues where the last one stopped. textbuffer_flush()
+	sends everything and waits.
+
+	Drawing on the OLED outside the buffer (pictures, lcd_clrscr()) has to
+	be told with textbuffer_clear() or textbuffer_forget().
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef TEXTBUFFER_H_
+#define TEXTBUFFER_H_
+
+#include <stdint.h>
+#include "printout.h"
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define TEXTBUFFER_COLUMNS PRINTOUT_COLUMNS
+#define TEXTBUFFER_ROWS 8
+
+//Maximum characters per chunk, 6 bytes each on the bus
+#define TEXTBUFFER_CHUNK_CHARS 4
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+void textbuffer_puts(uint8_t x, uint8_t y, const char *string);
+void textbuffer_puts_P(uint8_t x, uint8_t y, const char *progmem_string);
+uint8_t textbuffer_refresh(uint8_t max_chars);
+void textbuffer_flush(void);
+void textbuffer_clear(void);
+void textbuffer_forget(uint8_t first_row, uint8_t last_row);
+uint8_t textbuffer_is_dirty(void);
+
+
+
+#endif /* TEXTBUFFER_H_ */
@@ -0,0 +1,700 @@
+/******************************************************************************
+	WIDGET IMPLEMENTATION FILE
+
+	This file contains implementations of the telemetry widgets on the
+	OLED. See widget.h for a description.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "widget.h"
+#include "blit.h"
+#include "lcd.h"
+#include "../../Common/i2c/twi.h"
+#include "../../Common/timer2/timer2.h"
+#include <string.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Column bytes of a bar: frame ends, filled part, empty part (frame top and
+//bottom line only) and the tick in the middle of a centered bar
+#define BAR_END		0x7E
+#define BAR_FILLED	0x7E
+#define BAR_EMPTY	0x42
+#define BAR_TICK	0xFF
+
+//Least time between two content scroll commands, one display frame
+#define SCROLL_GAP_US 10000
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+//Chunk on the bus: position and column bytes of one page in one transaction
+static uint8_t chunk[LCD_DATA_HEADER_SIZE + WIDGET_CHUNK_COLUMNS];
+static twi_transaction_t chunk_transaction = {
+	.address = LCD_I2C_ADR,
+	.write_buffer = chunk,
+};
+
+//Widget the chunk belongs to, and the chart columns in it, drawn again if
+//the chunk does not reach the OLED
+static widget_bar_t *chunk_bar;
+static widget_chart_t *chunk_chart;
+static uint8_t chunk_page;
+static uint8_t chunk_column;
+static uint8_t chunk_length;
+
+#ifdef LCD_CONTENT_SCROLL
+//Content scroll command of a chart in scroll mode
+static uint8_t scroll_command[LCD_CONTENT_SCROLL_SIZE];
+static twi_transaction_t scroll_transaction = {
+	.address = LCD_I2C_ADR,
+	.write_buffer = scroll_command,
+};
+static uint32_t scroll_sent_at;		//micros
+static uint8_t scroll_sent = 0;
+#endif
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static uint8_t chunk_is_free(void);
+static uint8_t submit_chunk(uint8_t page, uint8_t column, uint8_t length);
+static uint8_t bar_fill(int16_t value, int16_t max, uint8_t columns);
+static uint8_t bar_step(uint8_t *shown, uint8_t wanted, uint8_t max_columns,
+						uint8_t *first);
+static uint8_t bar_column(const widget_bar_t *bar, uint8_t x);
+static uint8_t chart_level(const widget_chart_series_t *scale, int16_t value,
+						   uint8_t height);
+static void chart_mark_dirty(widget_chart_t *chart, uint8_t page, uint8_t x,
+							 uint8_t length);
+static uint8_t chart_scroll(widget_chart_t *chart);
+static uint8_t chart_index(const widget_chart_t *chart, uint8_t x);
+static uint8_t chart_find_run(widget_chart_t *chart, uint8_t *page, uint8_t *x,
+							  uint8_t max_length);
+static void chart_render(const widget_chart_t *chart, uint8_t page, uint8_t x,
+						 uint8_t length);
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	widget_bar_set()
+
+	This is a public function and is described in the header file, widget.h.
+******************************************************************************/
+void widget_bar_set(widget_bar_t *bar, int16_t value) {
+	uint8_t center = bar->columns / 2;
+	uint8_t half;
+	uint8_t fill;
+
+	if (bar->flags & WIDGET_BAR_CENTERED) {
+		//the same length to both sides of the tick, inside the frame
+		half = bar->columns - 2 - center;
+		if (half > center - 1) {
+			half = center - 1;
+		}
+
+		//the range always holds the tick, the ends move on their own side
+		if (value < 0) {
+			fill = bar_fill(-(int32_t)value, bar->max, half);
+			bar->wanted_low = center - fill;
+			bar->wanted_high = center + 1;
+		} else {
+			fill = bar_fill(value, bar->max, half);
+			bar->wanted_low = center;
+			bar->wanted_high = center + 1 + fill;
+		}
+	} else {
+		fill = bar_fill(value, bar->max, bar->columns - 2);
+		bar->wanted_low = 1;
+		bar->wanted_high = 1 + fill;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	widget_bar_refresh()
+
+	This is a public function and is described in the header file, widget.h.
+******************************************************************************/
+uint8_t widget_bar_refresh(widget_bar_t *bar, uint8_t max_columns) {
+	uint8_t first;
+	uint8_t count;
+
+	if (!chunk_is_free()) {
+		return 0;
+	}
+
+	if (max_columns > WIDGET_CHUNK_COLUMNS) {
+		max_columns = WIDGET_CHUNK_COLUMNS;
+	}
+
+	if (bar->redraw < bar->columns) {
+		//full redraw, with the value when it started
+		if (bar->redraw == 0) {
+			bar->shown_low = bar->wanted_low;
+			bar->shown_high = bar->wanted_high;
+		}
+		first = bar->redraw;
+		count = bar->columns - first;
+		if (count > max_columns) {
+			count = max_columns;
+		}
+		bar->redraw += count;
+	} else if (bar->shown_low != bar->wanted_low) {
+		count = bar_step(&bar->shown_low, bar->wanted_low, max_columns, &first);
+	} else if (bar->shown_high != bar->wanted_high) {
+		count = bar_step(&bar->shown_high, bar->wanted_high, max_columns, &first);
+	} else {
+		return 0;
+	}
+
+	for (uint8_t i = 0; i < count; i++) {
+		chunk[LCD_DATA_HEADER_SIZE + i] = bar_column(bar, first + i);
+	}
+
+	if (!submit_chunk(bar->page, bar->first_column + first, count)) {
+		widget_bar_invalidate(bar);			//queue full, draw it all again
+		return 0;
+	}
+
+	chunk_bar = bar;
+	chunk_chart = 0;
+
+	return 1;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	widget_bar_invalidate()
+
+	This is a public function and is described in the header file, widget.h.
+******************************************************************************/
+void widget_bar_invalidate(widget_bar_t *bar) {
+	bar->redraw = 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	widget_chart_init()
+
+	This is a public function and is described in the header file, widget.h.
+******************************************************************************/
+void widget_chart_init(widget_chart_t *chart, uint8_t first_page, uint8_t pages,
+					   uint8_t first_column, uint8_t columns) {
+	memset(chart, 0, sizeof(*chart));
+	memset(chart->levels, WIDGET_CHART_NO_SAMPLE, sizeof(chart->levels));
+	memset(chart->dropped, WIDGET_CHART_NO_SAMPLE, sizeof(chart->dropped));
+
+	chart->first_page = first_page;
+	chart->pages = pages;
+	chart->first_column = first_column;
+	chart->columns = columns;
+
+	widget_chart_set_series(chart, 0, 0, 255, WIDGET_CHART_LINE);
+	widget_chart_invalidate(chart);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	widget_chart_set_series()
+
+	This is a public function and is described in the header file, widget.h.
+******************************************************************************/
+void widget_chart_set_series(widget_chart_t *chart, uint8_t index,
+							 int16_t min, int16_t max, uint8_t style) {
+	chart->scale[index].min = min;
+	chart->scale[index].max = max;
+	chart->scale[index].style = style;
+
+	if (index >= chart->series) {
+		chart->series = index + 1;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	widget_chart_set_mode()
+
+	This is a public function and is described in the header file, widget.h.
+******************************************************************************/
+void widget_chart_set_mode(widget_chart_t *chart, uint8_t mode) {
+	chart->mode = mode;
+	widget_chart_invalidate(chart);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	widget_chart_push()
+
+	This is a public function and is described in the header file, widget.h.
+******************************************************************************/
+void widget_chart_push(widget_chart_t *chart, const int16_t *values) {
+	uint8_t height = chart->pages * 8;
+	uint8_t x = chart->cursor;
+
+	for (uint8_t s = 0; s < chart->series; s++) {
+		chart->dropped[s] = chart->levels[s][x];
+		chart->levels[s][x] = chart_level(&chart->scale[s], values[s], height);
+	}
+	chart->cursor = (x + 1) % chart->columns;
+
+	if (chart->hidden) {
+		return;								//drawn completely when shown
+	}
+
+	if (chart->mode == WIDGET_CHART_SWEEP) {
+		//the sample, the new blank column at the cursor and the column
+		//right of it, which loses its line from the left
+		for (uint8_t i = 0; i < 3; i++) {
+			for (uint8_t page = 0; page < chart->pages; page++) {
+				chart_mark_dirty(chart, page, x, 1);
+			}
+			x = (x + 1) % chart->columns;
+		}
+	} else if (chart->mode == WIDGET_CHART_SCROLL && chart_scroll(chart)) {
+		//the controller has moved the rest, the newest column is new
+		for (uint8_t page = 0; page < chart->pages; page++) {
+			chart_mark_dirty(chart, page, chart->columns - 1, 1);
+		}
+	} else {
+		widget_chart_invalidate(chart);		//every column has moved
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	widget_chart_refresh()
+
+	This is a public function and is described in the header file, widget.h.
+******************************************************************************/
+uint8_t widget_chart_refresh(widget_chart_t *chart, uint8_t max_columns) {
+	uint8_t page;
+	uint8_t x;
+	uint8_t length;
+
+	if (chart->hidden || !chunk_is_free()) {
+		return 0;
+	}
+
+	if (max_columns > WIDGET_CHUNK_COLUMNS) {
+		max_columns = WIDGET_CHUNK_COLUMNS;
+	}
+
+	length = chart_find_run(chart, &page, &x, max_columns);
+	if (length == 0) {
+		return 0;
+	}
+
+	chart_render(chart, page, x, length);
+
+	if (!submit_chunk(chart->first_page + page, chart->first_column + x, length)) {
+		chart_mark_dirty(chart, page, x, length);	//queue full, try again later
+		return 0;
+	}
+
+	chunk_bar = 0;
+	chunk_chart = chart;
+	chunk_page = page;
+	chunk_column = x;
+	chunk_length = length;
+
+	return 1;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	widget_chart_invalidate()
+
+	This is a public function and is described in the header file, widget.h.
+******************************************************************************/
+void widget_chart_invalidate(widget_chart_t *chart) {
+	for (uint8_t page = 0; page < chart->pages; page++) {
+		chart_mark_dirty(chart, page, 0, chart->columns);
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	widget_chart_hide()
+
+	This is a public function and is described in the header file, widget.h.
+******************************************************************************/
+void widget_chart_hide(widget_chart_t *chart) {
+	chart->hidden = 1;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	widget_chart_show()
+
+	This is a public function and is described in the header file, widget.h.
+******************************************************************************/
+void widget_chart_show(widget_chart_t *chart) {
+	chart->hidden = 0;
+	widget_chart_invalidate(chart);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Returns 1 if no chunk is on the bus. The widget of a chunk that did not
+	reach the OLED is marked to be drawn again.
+******************************************************************************/
+static uint8_t chunk_is_free(void) {
+	if (chunk_transaction.status == TWI_STATUS_PENDING) {
+		return 0;
+	}
+
+	if (chunk_transaction.status != TWI_STATUS_OK) {
+		if (chunk_bar) {
+			widget_bar_invalidate(chunk_bar);
+		}
+		if (chunk_chart && chunk_chart->mode == WIDGET_CHART_SWEEP) {
+			chart_mark_dirty(chunk_chart, chunk_page, chunk_column, chunk_length);
+		} else if (chunk_chart) {
+			widget_chart_invalidate(chunk_chart);	//may have scrolled since
+		}
+		chunk_transaction.status = TWI_STATUS_OK;
+	}
+
+	return 1;
+}
+
+
+
+/******************************************************************************
+	Puts the position commands in front of the column bytes in chunk[] and
+	queues the chunk.
+
+	Outputs:	uint8_t, 1 if queued, 0 if the TWI queue is full
+******************************************************************************/
+static uint8_t submit_chunk(uint8_t page, uint8_t column, uint8_t length) {
+	chunk_transaction.write_length = lcd_data_header(chunk, column, page) + length;
+
+	if (!twi_submit(&chunk_transaction)) {
+		return 0;
+	}
+
+	return 1;
+}
+
+
+
+/******************************************************************************
+	Returns the number of columns filled at a value, of columns at max.
+******************************************************************************/
+static uint8_t bar_fill(int16_t value, int16_t max, uint8_t columns) {
+	if (value <= 0 || max <= 0) {
+		return 0;
+	}
+	if (value >= max) {
+		return columns;
+	}
+
+	return (int32_t)value * columns / max;
+}
+
+
+
+/******************************************************************************
+	Moves an end of the filled part on the OLED towards the wanted end, at
+	most max_columns.
+
+	Outputs:	uint8_t, columns to send, *first the first of them
+******************************************************************************/
+static uint8_t bar_step(uint8_t *shown, uint8_t wanted, uint8_t max_columns,
+						uint8_t *first) {
+	uint8_t count;
+
+	if (*shown > wanted) {
+		count = *shown - wanted;
+		if (count > max_columns) {
+			count = max_columns;
+		}
+		*shown -= count;
+		*first = *shown;
+	} else {
+		count = wanted - *shown;
+		if (count > max_columns) {
+			count = max_columns;
+		}
+		*first = *shown;
+		*shown += count;
+	}
+
+	return count;
+}
+
+
+
+/******************************************************************************
+	Returns the byte of a bar column as on the OLED (shown_low/high).
+******************************************************************************/
+static uint8_t bar_column(const widget_bar_t *bar, uint8_t x) {
+	if (x == 0 || x == bar->columns - 1) {
+		return BAR_END;
+	}
+	if ((bar->flags & WIDGET_BAR_CENTERED) && x == bar->columns / 2) {
+		return BAR_TICK;
+	}
+	if (x >= bar->shown_low && x < bar->shown_high) {
+		return BAR_FILLED;
+	}
+
+	return BAR_EMPTY;
+}
+
+
+
+/******************************************************************************
+	Returns the level (0 at the bottom) of a value in a chart of height
+	pixels.
+******************************************************************************/
+static uint8_t chart_level(const widget_chart_series_t *scale, int16_t value,
+						   uint8_t height) {
+	if (scale->max <= scale->min || value <= scale->min) {
+		return 0;
+	}
+	if (value >= scale->max) {
+		return height - 1;
+	}
+
+	return ((int32_t)value - scale->min) * (height - 1) /
+		   ((int32_t)scale->max - scale->min);
+}
+
+
+
+/******************************************************************************
+	Marks a run of columns of a chart page to be sent.
+******************************************************************************/
+static void chart_mark_dirty(widget_chart_t *chart, uint8_t page, uint8_t x,
+							 uint8_t length) {
+	for (uint8_t i = x; i < x + length; i++) {
+		chart->dirty[page][i >> 3] |= (1 << (i & 7));
+	}
+}
+
+
+
+/******************************************************************************
+	Queues the content scroll command that moves the chart one column to
+	the left. Columns waiting to be sent move along. The controller runs
+	one scroll per display frame, a command within SCROLL_GAP_US of the
+	previous one is not sent.
+
+	Outputs:	uint8_t, 1 if queued, 0 if the controller cannot scroll,
+				the previous command is still on the bus or too recent
+******************************************************************************/
+static uint8_t chart_scroll(widget_chart_t *chart) {
+#ifdef LCD_CONTENT_SCROLL
+	uint8_t *dirty;
+	uint32_t now = timer2_get_micros();
+
+	if (scroll_transaction.status == TWI_STATUS_PENDING ||
+		(scroll_sent && now - scroll_sent_at < SCROLL_GAP_US)) {
+		return 0;
+	}
+
+	if (scroll_transaction.status != TWI_STATUS_OK) {
+		widget_chart_invalidate(chart);		//last scroll did not happen
+		scroll_transaction.status = TWI_STATUS_OK;
+	}
+
+	scroll_transaction.write_length = lcd_content_scroll_left(scroll_command,
+		chart->first_page, chart->first_page + chart->pages - 1,
+		chart->first_column, chart->first_column + chart->columns - 1);
+
+	if (!twi_submit(&scroll_transaction)) {
+		return 0;
+	}
+	scroll_sent_at = now;
+	scroll_sent = 1;
+
+	for (uint8_t page = 0; page < chart->pages; page++) {
+		dirty = chart->dirty[page];
+		for (uint8_t i = 0; i < sizeof(chart->dirty[0]); i++) {
+			dirty[i] >>= 1;
+			if (i + 1 < sizeof(chart->dirty[0])) {
+				dirty[i] |= dirty[i + 1] << 7;
+			}
+		}
+	}
+
+	return 1;
+#else
+	(void)chart;
+
+	return 0;
+#endif
+}
+
+
+
+/******************************************************************************
+	Returns the levels[] index of the sample in a chart column: the same
+	column while sweeping, the oldest sample in column 0 while scrolling.
+******************************************************************************/
+static uint8_t chart_index(const widget_chart_t *chart, uint8_t x) {
+	if (chart->mode == WIDGET_CHART_SWEEP) {
+		return x;
+	}
+
+	return (chart->cursor + x) % chart->columns;
+}
+
+
+
+/******************************************************************************
+	Finds the next run of at most max_length dirty columns in one page,
+	starting at the resume position and wrapping around the chart, and
+	marks it as sent.
+
+	Outputs:	uint8_t, run length (0 if nothing is dirty), *page and *x
+******************************************************************************/
+static uint8_t chart_find_run(widget_chart_t *chart, uint8_t *page, uint8_t *x,
+							  uint8_t max_length) {
+	uint8_t row;
+	uint8_t column;
+	uint8_t length;
+	uint8_t i;
+
+	for (i = 0; i <= chart->pages; i++) {
+		row = (chart->resume_page + i) % chart->pages;
+		column = (i == 0) ? chart->resume_column : 0;
+
+		while (column < chart->columns &&
+			   !(chart->dirty[row][column >> 3] & (1 << (column & 7)))) {
+			column++;
+		}
+
+		if (column < chart->columns) {
+			break;
+		}
+	}
+
+	if (i > chart->pages) {
+		return 0;
+	}
+
+	for (length = 0; length < max_length && column + length < chart->columns; length++) {
+		i = column + length;
+		if (!(chart->dirty[row][i >> 3] & (1 << (i & 7)))) {
+			break;
+		}
+		chart->dirty[row][i >> 3] &= ~(1 << (i & 7));
+	}
+
+	chart->resume_page = row;
+	chart->resume_column = column + length;
+	*page = row;
+	*x = column;
+
+	return length;
+}
+
+
+
+/******************************************************************************
+	Draws a run of columns of a chart page into chunk[] with the blit
+	engine. A line is drawn as a vertical span from next to the level of
+	the column on the left to the level of the column.
+******************************************************************************/
+static void chart_render(const widget_chart_t *chart, uint8_t page, uint8_t x,
+						 uint8_t length) {
+	blit_target_t target = {
+		chunk + LCD_DATA_HEADER_SIZE,
+		chart->first_page + page, 1,
+		chart->first_column + x, length
+	};
+	int16_t bottom = (chart->first_page + chart->pages) * 8 - 1;
+	int16_t y;
+	int16_t from;
+	uint8_t level;
+	uint8_t left;
+	uint8_t sweep_gap;
+
+	memset(target.buffer, 0, length);
+
+	sweep_gap = (chart->mode == WIDGET_CHART_SWEEP) ? chart->cursor : 0xFF;
+
+	for (uint8_t column = x; column < x + length; column++) {
+		if (column == sweep_gap) {
+			continue;						//blank between newest and oldest
+		}
+
+		for (uint8_t s = 0; s < chart->series; s++) {
+			level = chart->levels[s][chart_index(chart, column)];
+			if (level == WIDGET_CHART_NO_SAMPLE) {
+				continue;
+			}
+
+			y = bottom - level;
+			from = y;
+
+			//column 0 keeps its line when scrolled, from the sample that
+			//has scrolled out
+			if (column == 0) {
+				left = (chart->mode == WIDGET_CHART_SWEEP) ?
+					   WIDGET_CHART_NO_SAMPLE : chart->dropped[s];
+			} else if (column - 1 == sweep_gap) {
+				left = WIDGET_CHART_NO_SAMPLE;
+			} else {
+				left = chart->levels[s][chart_index(chart, column - 1)];
+			}
+			if (chart->scale[s].style == WIDGET_CHART_LINE &&
+				left != WIDGET_CHART_NO_SAMPLE) {
+				from = bottom - left;
+				if (from < y) {
+					from++;
+				} else if (from > y) {
+					from--;
+				}
+			}
+
+			if (from < y) {
+				blit_vspan(&target, chart->first_column + column, from, y, WHITE);
+			} else {
+				blit_vspan(&target, chart->first_column + column, y, from, WHITE);
+			}
+		}
+	}
+}
@@ -0,0 +1,261 @@
+/******************************************************************************
+	WIDGET HEADER FILE
+
+	This file contains the interface to the telemetry widgets on the OLED:
+	bar gauges and a strip chart. They draw straight to the display, next
+	to the text framebuffer (textbuffer.c), in areas the text does not use.
+
+	Widgets keep what is on the OLED and send only the columns that
+	change. The refresh functions are display tasks like
+	textbuffer_refresh(): each call sends at most one chunk (position and
+	up to max_columns column bytes of one page) through the TWI engine and
+	returns without waiting for the bus. All widgets share the chunk, so
+	only one of them has a chunk on the bus at a time.
+
+	Bar gauge (widget_bar_t), one page high:
+		- a frame with the filled part in between. The filled part ends
+		  are moved towards the value, so a new value costs the columns
+		  between the old and the new end only.
+		- WIDGET_BAR_CENTERED: signed value, filled from a tick in the
+		  middle to the left (negative) or right (positive)
+
+	Strip chart (widget_chart_t), up to WIDGET_CHART_MAX_PAGES pages high:
+		- up to WIDGET_CHART_SERIES values per sample, one column per
+		  sample, each series drawn as a line or as dots
+		- WIDGET_CHART_SWEEP: a sweep cursor runs from left to right and
+		  wraps around. The column at the cursor is blank and separates
+		  the newest sample on the left from the oldest on the right. A
+		  new sample costs three columns per page on any controller.
+		- WIDGET_CHART_SCROLL: the newest sample is in the rightmost
+		  column and the chart scrolls left. With LCD_CONTENT_SCROLL
+		  (lcd.h) the controller moves the chart by one column and a new
+		  sample costs one column per page and a 9 byte command, at most
+		  one command per display frame (about 10 ms). Without it, and
+		  for a sample within a frame of the previous command, the whole
+		  chart is sent again (software scroll).
+		- WIDGET_CHART_SCROLL_SOFTWARE: always the software scroll, to
+		  compare with the controller scroll
+		- a hidden chart (widget_chart_hide()), e.g. under a warning,
+		  keeps its samples but sends nothing, a content scroll would move
+		  what is drawn over it. widget_chart_show() draws it completely.
+
+	Example:
+		static widget_bar_t speed = WIDGET_BAR(4, 8, 120, 255, WIDGET_BAR_CENTERED);
+		static widget_chart_t chart;
+
+		widget_chart_init(&chart, 0, 4, 0, 126);
+		widget_chart_set_series(&chart, 0, 0, 200, WIDGET_CHART_LINE);
+
+		widget_bar_set(&speed, -100);
+		widget_chart_push(&chart, values);
+		...
+		if (!widget_bar_refresh(&speed, WIDGET_CHUNK_COLUMNS)) {
+			widget_chart_refresh(&chart, WIDGET_CHUNK_COLUMNS);
+		}
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef WIDGET_H_
+#define WIDGET_H_
+
+#include <stdint.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Maximum columns per chunk, one byte each on the bus
+#ifndef WIDGET_CHUNK_COLUMNS
+#define WIDGET_CHUNK_COLUMNS 16
+#endif
+
+//Bar flags
+#define WIDGET_BAR_CENTERED (1 << 0)
+
+//Chart size, a chart takes about (WIDGET_CHART_SERIES + 0.5) bytes of
+//SRAM per column
+#define WIDGET_CHART_MAX_COLUMNS 128
+#define WIDGET_CHART_MAX_PAGES 4
+#define WIDGET_CHART_SERIES 2
+
+//Chart series styles
+#define WIDGET_CHART_LINE 0
+#define WIDGET_CHART_DOTS 1
+
+//Chart modes
+#define WIDGET_CHART_SWEEP 0
+#define WIDGET_CHART_SCROLL 1
+#define WIDGET_CHART_SCROLL_SOFTWARE 2
+
+//Level of a chart column without a sample
+#define WIDGET_CHART_NO_SAMPLE 0xFF
+
+//Bar gauge at a page, columns wide (at least 5) including the frame,
+//filled completely at value max
+#define WIDGET_BAR(page, first_column, columns, max, flags) \
+	{ (page), (first_column), (columns), (flags), (max), 0, 0, 0, 0, 0 }
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	uint8_t page;
+	uint8_t first_column;
+	uint8_t columns;
+	uint8_t flags;
+	int16_t max;
+	uint8_t wanted_low;			//filled columns low..high - 1, relative
+	uint8_t wanted_high;
+	uint8_t shown_low;			//the same on the OLED
+	uint8_t shown_high;
+	uint8_t redraw;				//next column of a full redraw, done at columns
+} widget_bar_t;
+
+typedef struct {
+	int16_t min;				//value at the bottom of the chart
+	int16_t max;				//value at the top of the chart
+	uint8_t style;				//WIDGET_CHART_LINE or WIDGET_CHART_DOTS
+} widget_chart_series_t;
+
+typedef struct {
+	uint8_t first_page;
+	uint8_t pages;
+	uint8_t first_column;
+	uint8_t columns;
+	uint8_t series;				//series in use
+	uint8_t mode;				//WIDGET_CHART_xxx
+	widget_chart_series_t scale[WIDGET_CHART_SERIES];
+	uint8_t cursor;				//levels[] index of the next sample
+	uint8_t levels[WIDGET_CHART_SERIES][WIDGET_CHART_MAX_COLUMNS];
+	uint8_t dropped[WIDGET_CHART_SERIES];	//scrolled out, left of column 0
+	uint8_t dirty[WIDGET_CHART_MAX_PAGES][WIDGET_CHART_MAX_COLUMNS / 8];
+	uint8_t resume_page;		//where the search for dirty columns continues
+	uint8_t resume_column;
+	uint8_t hidden;				//see widget_chart_hide()
+} widget_chart_t;
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Function name:	widget_bar_set()
+
+	Sets the value of a bar gauge. Values outside 0..max (-max..max for a
+	centered bar) are shown as the nearest end.
+
+	Inputs:		widget_bar_t *bar
+				int16_t value
+******************************************************************************/
+void widget_bar_set(widget_bar_t *bar, int16_t value);
+
+/******************************************************************************
+	Function name:	widget_bar_refresh()
+
+	Sends the next chunk of columns that differ from the value, see the
+	description above. Nothing is done while the previous chunk of any
+	widget is still on the bus.
+
+	Inputs:		widget_bar_t *bar
+				uint8_t max_columns, 1..WIDGET_CHUNK_COLUMNS
+	Outputs:	uint8_t, 1 if a chunk was started
+******************************************************************************/
+uint8_t widget_bar_refresh(widget_bar_t *bar, uint8_t max_columns);
+
+/******************************************************************************
+	Function name:	widget_bar_invalidate()
+
+	Tells the bar that it is not on the OLED any more, e.g. after
+	lcd_clrscr(). It is redrawn completely.
+******************************************************************************/
+void widget_bar_invalidate(widget_bar_t *bar);
+
+/******************************************************************************
+	Function name:	widget_chart_init()
+
+	Sets up an empty chart with one series (0..255, line) in sweep mode and
+	marks all of it to be drawn.
+
+	Inputs:		widget_chart_t *chart
+				uint8_t first_page, uint8_t pages, 1..WIDGET_CHART_MAX_PAGES
+				uint8_t first_column, uint8_t columns, 3..WIDGET_CHART_MAX_COLUMNS
+******************************************************************************/
+void widget_chart_init(widget_chart_t *chart, uint8_t first_page, uint8_t pages,
+					   uint8_t first_column, uint8_t columns);
+
+/******************************************************************************
+	Function name:	widget_chart_set_series()
+
+	Sets the scale and style of a series, the series in use are 0..index.
+
+	Inputs:		widget_chart_t *chart
+				uint8_t index, 0..WIDGET_CHART_SERIES - 1
+				int16_t min, int16_t max, values at the bottom and top
+				uint8_t style, WIDGET_CHART_LINE or WIDGET_CHART_DOTS
+******************************************************************************/
+void widget_chart_set_series(widget_chart_t *chart, uint8_t index,
+							 int16_t min, int16_t max, uint8_t style);
+
+/******************************************************************************
+	Function name:	widget_chart_set_mode()
+
+	Sets the mode of a chart, WIDGET_CHART_xxx. The samples are kept and
+	the chart is drawn again.
+******************************************************************************/
+void widget_chart_set_mode(widget_chart_t *chart, uint8_t mode);
+
+/******************************************************************************
+	Function name:	widget_chart_push()
+
+	Adds a sample at the cursor and moves the cursor one column, or
+	scrolls the chart one column.
+
+	Inputs:		widget_chart_t *chart
+				const int16_t *values, one per series in use
+******************************************************************************/
+void widget_chart_push(widget_chart_t *chart, const int16_t *values);
+
+/******************************************************************************
+	Function name:	widget_chart_refresh()
+
+	Sends the next chunk of changed columns, see widget_bar_refresh().
+
+	Inputs:		widget_chart_t *chart
+				uint8_t max_columns, 1..WIDGET_CHUNK_COLUMNS
+	Outputs:	uint8_t, 1 if a chunk was started
+******************************************************************************/
+uint8_t widget_chart_refresh(widget_chart_t *chart, uint8_t max_columns);
+
+/******************************************************************************
+	Function name:	widget_chart_invalidate()
+
+	Tells the chart that it is not on the OLED any more, e.g. after a
+	picture has been drawn over it. It is redrawn completely.
+******************************************************************************/
+void widget_chart_invalidate(widget_chart_t *chart);
+
+/******************************************************************************
+	Function name:	widget_chart_hide()
+
+	Tells the chart that something else is drawn over it. Samples are still
+	pushed, but nothing is sent to the OLED until widget_chart_show().
+******************************************************************************/
+void widget_chart_hide(widget_chart_t *chart);
+
+/******************************************************************************
+	Function name:	widget_chart_show()
+
+	Tells the chart that it may be drawn again. It is redrawn completely.
+******************************************************************************/
+void widget_chart_show(widget_chart_t *chart);
+
+
+
+#endif /* WIDGET_H_ */
@@ -1,113 +1,174 @@
-/******************************************************************************
-	USART0 MAIN FILE
-
-	This file contains function implementations to handle USART0.
-
-	Be aware of code blocks in this file market with header "EDIT IF
-	NECESSARY". Make sure these blocks hold the code wanted.
-
-	For more information regarding the implementation, please refer to
-	Atmel-8271J-AVR- ATmega-Datasheet_11/2015.
-
-	Author: Mattias Ahle
-			mattias.ahle@gmail.com
-	Created: 2020-09-08
-	Last update: 2020-10-27
-******************************************************************************/
-
-
-
-/******************************************************************************
-	EDIT IF NECESSARY
-******************************************************************************/
-#define F_CPU 16000000UL
-#define BAUDRATE 9600
-/*****************************************************************************/
-#define UBRR_BAUDRATE ((F_CPU / (BAUDRATE * 16L)) - 1)
-
-#include <avr/io.h>
-#include <avr/interrupt.h>
-
-
-
-/******************************************************************************
-	FUNCTION PROTOTYPES
-******************************************************************************/
-void usart_init(void);
-void usart_transmit_character(char c);
-void usart_transmit_string(char *s);
-/*****************************************************************************/
-
-
-
-/******************************************************************************
-	EDIT IF NECESSARY - INTERRUPT SERVICE ROUTINE
-******************************************************************************/
-ISR(USART_RX_vect) {
-	//Put code here
-}
-/*****************************************************************************/
-
-
-
-/******************************************************************************
-	This function initializes USART0.
-
-	Inputs:		none
-	Outputs:	none
-	Calls:		sei()
-******************************************************************************/
-void usart_init(void) {
-	UBRR0H = (UBRR_BAUDRATE >> 8);
-	UBRR0L = UBRR_BAUDRATE;
-
-	UCSR0B |= (1 << TXEN0) | (1 << RXEN0); 		//Transmit/Receive enable
-
-	UCSR0C |= (1 << UCSZ01) | (1 << UCSZ00);
-	UCSR0C &= ~(1 << UMSEL00) & ~(1 << UPM00) & ~(1 << USBS0);
-
-	sei();
-}
-
-
-
-/******************************************************************************
-	This function transmits a character via USART-TX.
-
-	Inputs:		uint8_t
-	Outputs:	none
-	Calls:		none
-******************************************************************************/
-void usart_transmit_character(char c) {
-	while (!(UCSR0A & (1 << UDRE0))) {}		//wait until sending is possible
-	UDR0 = c;
-}
-
-
-
-/******************************************************************************
-	This function transmits a string via USART-TX.
-
-	Inputs:		char *
-	Outputs:	none
-	Calls:		usart_transmit_character()
-******************************************************************************/
-void usart_transmit_string(char *s) {
-	while (*s) {							//sending char until "/0"
-		usart_transmit_character(*s);
-		s++;
-	}
-}
-
-
-
-/******************************************************************************
-	This function returns 1 (true) if a transmission is received (USART-RX).
-
-	Inputs:		none
-	Outputs:	uint8_t
-	Calls:		none
-******************************************************************************/
-uint8_t usart_receive(void) {
-	return (UCSR0A & (1<<7)) != 0;
+/******************************************************************************
+	USART0 MAIN FILE
+
+	This file contains function implementations to handle USART0.
+
+	Received characters are put in a queue by the USART Receive Complete
+	interrupt, so nothing is lost while the main loop is busy, e.g. when a
+	status message from the Robot arrives in one piece.
+
+	Be aware of code blocks in this file market with header "EDIT IF
+	NECESSARY". Make sure these blocks hold the code wanted.
+
+	For more information regarding the implementation, please refer to
+	Atmel-8271J-AVR- ATmega-Datasheet_11/2015.
+
+	Author: Mattias Ahle
+			mattias.ahle@gmail.com
+	Created: 2020-09-08
+	Last update: 2020-10-27
+******************************************************************************/
+
+
+
+/******************************************************************************
+	EDIT IF NECESSARY
+******************************************************************************/
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+#define BAUDRATE 9600
+#define RX_QUEUE_SIZE 32		//power of 2
+/*****************************************************************************/
+#define UBRR_BAUDRATE ((F_CPU / (BAUDRATE * 16L)) - 1)
+#define RX_QUEUE_MASK (RX_QUEUE_SIZE - 1)
+
+#include "../Common/hal/hal.h"
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+void usart_init(void);
+void usart_transmit_character(char c);
+void usart_transmit_string(char *s);
+void usart_transmit_buffer(const uint8_t *buffer, uint8_t length);
+uint8_t usart_receive(void);
+uint8_t usart_read(void);
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+//Characters from rx_tail up to rx_head are received and not yet read
+static volatile uint8_t rx_queue[RX_QUEUE_SIZE];
+static volatile uint8_t rx_head = 0;
+static volatile uint8_t rx_tail = 0;
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	EDIT IF NECESSARY - INTERRUPT SERVICE ROUTINE
+******************************************************************************/
+ISR(USART_RX_vect) {
+	uint8_t c = hal_usart_read();
+	uint8_t next = (rx_head + 1) & RX_QUEUE_MASK;
+
+	if (next != rx_tail) {					//dropped if the queue is full
+		rx_queue[rx_head] = c;
+		rx_head = next;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function initializes USART0.
+
+	Inputs:		none
+	Outputs:	none
+	Calls:		sei()
+******************************************************************************/
+void usart_init(void) {
+	hal_usart_init(UBRR_BAUDRATE);				//Transmit/Receive enable, 8N1
+	hal_usart_rx_interrupt_enable();			//Receive Complete Interrupt Enable
+
+	hal_interrupts_enable();
+}
+
+
+
+/******************************************************************************
+	This function transmits a character via USART-TX.
+
+	Inputs:		uint8_t
+	Outputs:	none
+	Calls:		none
+******************************************************************************/
+void usart_transmit_character(char c) {
+	while (!hal_usart_ready()) {}			//wait until sending is possible
+	hal_usart_write(c);
+}
+
+
+
+/******************************************************************************
+	This function transmits a string via USART-TX.
+
+	Inputs:		char *
+	Outputs:	none
+	Calls:		usart_transmit_character()
+******************************************************************************/
+void usart_transmit_string(char *s) {
+	while (*s) {							//sending char until "/0"
+		usart_transmit_character(*s);
+		s++;
+	}
+}
+
+
+
+/******************************************************************************
+	This function transmits a buffer via USART-TX, e.g. a link frame.
+
+	Inputs:		const uint8_t *buffer
+				uint8_t length
+	Outputs:	none
+	Calls:		usart_transmit_character()
+******************************************************************************/
+void usart_transmit_buffer(const uint8_t *buffer, uint8_t length) {
+	for (uint8_t i = 0; i < length; i++) {
+		usart_transmit_character(buffer[i]);
+	}
+}
+
+
+
+/******************************************************************************
+	This function returns 1 (true) if a transmission is received (USART-RX)
+	and waits to be read with usart_read().
+
+	Inputs:		none
+	Outputs:	uint8_t
+	Calls:		none
+******************************************************************************/
+uint8_t usart_receive(void) {
+	return rx_head != rx_tail;
+}
+
+
+
+/******************************************************************************
+	This function returns the next received character, 0 if there is none.
+
+	Inputs:		none
+	Outputs:	uint8_t
+	Calls:		none
+******************************************************************************/
+uint8_t usart_read(void) {
+	uint8_t c;
+
+	if (rx_head == rx_tail) {
+		return 0;
+	}
+
+	c = rx_queue[rx_tail];
+	rx_tail = (rx_tail + 1) & RX_QUEUE_MASK;
+
+	return c;
 }
\ No newline at end of file
@@ -1,22 +1,24 @@
-/******************************************************************************
-	USART0 HEADER FILE
-
-	This file contains the interface to interact with and use usart0.c.
-
-	Author: Mattias Ahle
-			mattias.ahle@gmail.com
-	Created: 2020-09-08
-	Last update: 2020-10-27
-******************************************************************************/
-
-#ifndef USART0_H_
-#define USART0_H_
-
-void usart_init(void);
-void usart_transmit_character(char c);
-void usart_transmit_string (char *s);
-uint8_t usart_receive(void);
-
-
-
+/******************************************************************************
+	USART0 HEADER FILE
+
+	This file contains the interface to interact with and use usart0.c.
+
+	Author: Mattias Ahle
+			mattias.ahle@gmail.com
+	Created: 2020-09-08
+	Last update: 2020-10-27
+******************************************************************************/
+
+#ifndef USART0_H_
+#define USART0_H_
+
+void usart_init(void);
+void usart_transmit_character(char c);
+void usart_transmit_string (char *s);
+void usart_transmit_buffer(const uint8_t *buffer, uint8_t length);
+uint8_t usart_receive(void);
+uint8_t usart_read(void);
+
+
+
 #endif /* USART0_H_ */
\ No newline at end of file
@@ -6,7 +6,9 @@
 	Created: 2020-10-28
 	Author: Mattias Ahle, mattias.ahle@gmail.com
 ******************************************************************************/
+#ifndef F_CPU
 #define F_CPU 16000000UL
+#endif
 #define TIME_1 240
 #define TIME_2 480
 #define TIME_4 960
@@ -24,117 +26,116 @@
 #define G3 196
 
 #include "motors/motors.h"
-#include <avr/io.h>
+#include "../Common/hal/hal.h"
 #include <stdint.h>
-#include <util/delay.h>
 
 void play_GoT(void) {
 	motors_set_left_forward();
 	motors_set_right_reverse();
 
 	motors_set_both_PWM(G3);
-	_delay_ms(TIME_6);
+	hal_delay_ms(TIME_6);
 
 	motors_set_both_PWM(C);
-	_delay_ms(TIME_6);
+	hal_delay_ms(TIME_6);
 
 	motors_set_both_PWM(Eb);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 	motors_set_both_PWM(F3);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 	motors_set_both_PWM(G3);
-	_delay_ms(TIME_4);
+	hal_delay_ms(TIME_4);
 
 	motors_set_both_PWM(C);
-	_delay_ms(TIME_4);
+	hal_delay_ms(TIME_4);
 	motors_set_both_PWM(Eb);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 	motors_set_both_PWM(F3);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 
 	motors_set_both_PWM(D);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(G2);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(Bb);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 	motors_set_both_PWM(C);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 
 	motors_set_both_PWM(D);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(G2);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(Bb);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 	motors_set_both_PWM(C);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 
 	motors_set_both_PWM(D);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(G2);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(Bb);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 	motors_set_both_PWM(C);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 
 	motors_set_both_PWM(D);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(G2);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(Bb);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 
 	motors_set_both_PWM(F3);
-	_delay_ms(TIME_6);
+	hal_delay_ms(TIME_6);
 
 	motors_set_both_PWM(Bb);
-	_delay_ms(TIME_6);
+	hal_delay_ms(TIME_6);
 
 	motors_set_both_PWM(Eb);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 	motors_set_both_PWM(D);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 	motors_set_both_PWM(F3);
-	_delay_ms(TIME_4);
+	hal_delay_ms(TIME_4);
 
 	motors_set_both_PWM(Bb);
-	_delay_ms(TIME_6);
+	hal_delay_ms(TIME_6);
 
 	motors_set_both_PWM(Eb);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 	motors_set_both_PWM(D);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 	motors_set_both_PWM(F2);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(Ab);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 	motors_set_both_PWM(Bb);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 
 	motors_set_both_PWM(C);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(F2);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(Ab);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 	motors_set_both_PWM(Bb);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 
 	motors_set_both_PWM(C);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(F2);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(Ab);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 	motors_set_both_PWM(Bb);
-	_delay_ms(TIME_1);
+	hal_delay_ms(TIME_1);
 
 	motors_set_both_PWM(C);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(F2);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 	motors_set_both_PWM(Ab);
-	_delay_ms(TIME_2);
+	hal_delay_ms(TIME_2);
 }
\ No newline at end of file
@@ -1,17 +1,17 @@
-/******************************************************************************
-	GAME OF THRONES THEME SONG
-
-	Run play_GoT() to play parts of GoT theme song on PWM controlled hardware.
-
-	Created: 2020-10-28
-	Author: Mattias Ahle, mattias.ahle@gmail.com
-******************************************************************************/
-
-#ifndef GOT_H_
-#define GOT_H_
-
-void play_GoT(void);
-
-
-
+/******************************************************************************
+	GAME OF THRONES THEME SONG
+
+	Run play_GoT() to play parts of GoT theme song on PWM controlled hardware.
+
+	Created: 2020-10-28
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef GOT_H_
+#define GOT_H_
+
+void play_GoT(void);
+
+
+
 #endif /* GOT_H_ */
\ No newline at end of file
@@ -0,0 +1,167 @@
+/******************************************************************************
+	COMMAND RECEIVER IMPLEMENTATION FILE
+
+	This file contains implementations to separate the command bytes for
+	the Robot from frames and requests on the link. See command.h.
+
+	Created: 2026-10-19
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "command.h"
+#include "../Common/profile/profile.h"
+#include "../Common/sram/sram.h"
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//What the held bytes are, see classify()
+#define HELD_UNKNOWN	0	//keep holding, not complete yet
+#define HELD_COMMAND	1	//the first byte is a command byte
+#define HELD_FRAME		2	//the first bytes are a frame
+#define HELD_REQUEST	3	//the first bytes are a request
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static uint8_t held[COMMAND_HOLD_SIZE];
+static uint8_t held_count = 0;
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static uint8_t classify(uint8_t *length);
+static uint8_t request_length(uint8_t byte);
+static void forget(uint8_t length);
+
+
+
+/******************************************************************************
+	This function feeds a received byte to the command receiver and
+	returns what it released. The bytes of a frame and of a request are
+	dropped, the request is reported in command->request.
+
+	Inputs:		uint8_t byte, received byte
+	Outputs:	command_t *command
+	Calls:		classify(), forget()
+******************************************************************************/
+void command_receive(uint8_t byte, command_t *command) {
+	uint8_t length;
+
+	command->count = 0;
+	command->request = 0;
+	command->held = 0;
+
+	held[held_count++] = byte;
+
+	while (held_count) {
+		switch (classify(&length)) {
+			case HELD_UNKNOWN:
+				command->held = held_count;
+				return;
+			case HELD_COMMAND:
+				command->bytes[command->count++] = held[0];
+				forget(1);
+				break;
+			case HELD_REQUEST:
+				command->request = held[0];
+				forget(length);
+				break;
+			default:
+				forget(length);				//frame, not for the Robot
+				break;
+		}
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function tells what the held bytes begin with. Frames are parsed
+	from the first held byte, a frame that turns out to be broken makes
+	its first byte a command byte, the bytes after it are classified
+	again.
+
+	Inputs:		none
+	Outputs:	uint8_t *length, bytes of the frame or request
+				uint8_t, HELD_xxx
+	Calls:		link_parse(), request_length()
+******************************************************************************/
+static uint8_t classify(uint8_t *length) {
+	link_parser_t parser = { 0 };
+	uint8_t run = request_length(held[0]);
+
+	if (held[0] == LINK_SYNC) {
+		for (uint8_t i = 0; i < held_count; i++) {
+			switch (link_parse(&parser, held[i])) {
+				case LINK_PARSE_FRAME:
+					*length = i + 1;
+					return HELD_FRAME;
+				case LINK_PARSE_ERROR:
+					return HELD_COMMAND;
+				default:
+					break;
+			}
+		}
+		return HELD_UNKNOWN;
+	}
+
+	if (run) {
+		for (uint8_t i = 1; i < held_count; i++) {
+			if (held[i] != held[0]) {
+				return HELD_COMMAND;
+			}
+		}
+		if (held_count < run) {
+			return HELD_UNKNOWN;
+		}
+		*length = run;
+		return HELD_REQUEST;
+	}
+
+	return HELD_COMMAND;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function returns the length of a request that begins with the
+	byte, 0 if the byte begins no request the build answers.
+******************************************************************************/
+static uint8_t request_length(uint8_t byte) {
+#ifdef PROFILE_RECORDING
+	if (byte == PROFILE_REQUEST) {
+		return PROFILE_REQUEST_LENGTH;
+	}
+#endif
+#ifdef SRAM_MONITOR
+	if (byte == SRAM_REQUEST) {
+		return SRAM_REQUEST_LENGTH;
+	}
+#endif
+	(void)byte;
+	return 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function removes the first length held bytes.
+******************************************************************************/
+static void forget(uint8_t length) {
+	held_count -= length;
+
+	for (uint8_t i = 0; i < held_count; i++) {
+		held[i] = held[i + length];
+	}
+}
+/*****************************************************************************/
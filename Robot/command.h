@@ -0,0 +1,63 @@
+/******************************************************************************
+	COMMAND RECEIVER HEADER FILE
+
+	This file contains the interface to interact with and use command.c.
+
+	The Robot receives motor bytes from the Remote and the collision
+	confirm '1', but the link carries more: frames of the link (see
+	Common/link/link.h) sent by a Remote built with the profiler or the
+	SRAM monitor, and the requests of a host for them, a run of request
+	bytes. Their bytes would drive the motors. The command receiver holds every
+	byte that may begin a frame or a request until it knows:
+		- a frame with a correct checksum is dropped
+		- a request run of the full length is dropped and reported
+		- anything else is released, in order, as command bytes
+	A motor byte LINK_SYNC (left motor, reverse, PWM 164) is thereby held
+	until the bytes after it are no frame, usually two more bytes. The
+	caller reads on while bytes are held (command_t.held) and more have
+	arrived, so holding costs no pass of the main loop.
+
+	Request bytes are held only in builds that answer the request
+	(PROFILE_RECORDING, SRAM_MONITOR). They are motor bytes with PWM 0,
+	and a stop must not wait for the next byte in the normal firmware.
+
+	Created: 2026-10-19
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef COMMAND_H_
+#define COMMAND_H_
+
+#include <stdint.h>
+#include "../Common/link/link.h"
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Bytes held at most, a whole frame
+#define COMMAND_HOLD_SIZE (LINK_MAX_PAYLOAD + LINK_FRAME_OVERHEAD)
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	uint8_t bytes[COMMAND_HOLD_SIZE];	//released command bytes, in order
+	uint8_t count;
+	uint8_t request;					//request byte of a complete request, else 0
+	uint8_t held;						//bytes still held back
+} command_t;
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+void command_receive(uint8_t byte, command_t *command);
+
+
+
+#endif /* COMMAND_H_ */
@@ -1,20 +1,20 @@
-/******************************************************************************
-	EXTERNAL INTERRUPT1 HEADER FILE
-
-	This file contains the public interface to interact with and use
-	External Interrupt 1 (INT1).
-
-	Created: 2020-09-03
-	Author: Mattias Ahle, mattias.ahle@gmail.com
-
-	Last update: 2020-10-14
-******************************************************************************/
-
-#ifndef INT1_H_
-#define INT1_H_
-
-void int1_init(void);
-
-
-
+/******************************************************************************
+	EXTERNAL INTERRUPT1 HEADER FILE
+
+	This file contains the public interface to interact with and use
+	External Interrupt 1 (INT1).
+
+	Created: 2020-09-03
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+
+	Last update: 2020-10-14
+******************************************************************************/
+
+#ifndef INT1_H_
+#define INT1_H_
+
+void int1_init(void);
+
+
+
 #endif /* INT1_H_ */
\ No newline at end of file
@@ -1,271 +1,591 @@
-/******************************************************************************
-	REDBOT ROBOT
-
-	Main execution file for RedBot.
-
-	Created: 2020-10-27
-	Author: Mattias Ahle, mattias.ahle@gmail.com
-
-	Last update: 2020-11-03
-    By: Mattias Ahle
-******************************************************************************/
-
-
-
-/******************************************************************************
-	DEFINE
-******************************************************************************/
-#define F_CPU 16000000UL
-#define GEAR_SEL_BIT 1
-#define MOTOR_SEL_BIT 0
-
-//Distance in cm from obstacle when RedBot shall halt forward motion
-#define DISTANCE_LIMIT 30
-
-//MPU6050 ZERO (output when RedBot is leveled and still)
-#define MPU6050_X_ZERO -350
-#define MPU6050_Y_ZERO -35
-#define MPU6050_Z_ZERO 1930
-
-//Incremental output from MPU6050 ZERO to signal collision
-#define COLLISION_LIMIT 10000
-
-
-
-/******************************************************************************
-	INCLUDE
-******************************************************************************/
-#include "motors/motors.h"
-#include "usart0.h"
-#include "mpu6050/i2cmaster.h"
-#include "mpu6050/mpu6050.h"
-#include "hc_sr04/hc_sr04.h"
-#include "GoT.h"
-#include <avr/io.h>
-#include <stdio.h>
-#include <util/delay.h>
-
-
-
-/******************************************************************************
-	FUNCTION PROTOTYPES
-******************************************************************************/
-void control_motors(uint16_t *p_distance);
-void set_gears(uint16_t *distance, uint8_t *p_received_byte);
-void set_PWM(uint8_t *p_received_byte);
-uint8_t is_left_motor(uint8_t *p_received_byte);
-uint8_t is_forward_gear(uint8_t *p_received_byte);
-
-uint8_t is_collision_detected(void);
-void handle_collision_detection(void);
-void print_rawAccData(void);
-
-void printout_clear_garbage_left_align(int string_length, char *buffer);
-
-
-
-/******************************************************************************
-	GLOBAL VARIABLES
-******************************************************************************/
-uint16_t distance;
-uint8_t received_byte;
-uint8_t collision_confirmed;
-int16_t ax, ay, az;
-uint8_t distance_warning_sent = 0;
-
-char buffer[50];
-
-
-
-/******************************************************************************
-	MAIN FUNCTION
-******************************************************************************/
-int main(void) {
-	usart_init();
-	motors_init();
-	hc_sr04_init();
-	mpu6050_init();
-
-    while (1)
-	{
-		distance = hc_sr04_get_distance();
-
-		if (distance < DISTANCE_LIMIT && distance != 0 && !distance_warning_sent)
-		{
-			usart_transmit_character('2'); //transmit error code 2: obstacle warning
-			distance_warning_sent = 1;
-		}
-		else if (distance >= DISTANCE_LIMIT && distance != 0 && distance_warning_sent)
-		{
-			usart_transmit_character('0'); //transmit error code 0: no errors
-			distance_warning_sent = 0;
-		}
-		else
-		{
-			//Send nothing
-		}
-
-		_delay_ms(10);
-
-		control_motors(&distance);
-
-		if (is_collision_detected())
-		{
-			handle_collision_detection();
-		}
-
-	}
-}
-
-
-
-/******************************************************************************
-	SUB FUNCTIONS
-******************************************************************************/
-
-/******************************************************************************
-	Motor control
-******************************************************************************/
-void control_motors(uint16_t *p_distance)
-{
-	if (usart_receive())
-	{
-		received_byte = UDR0;
-
-		set_gears(p_distance, &received_byte);
-		set_PWM(&received_byte);
-	}
-}
-
-void set_gears(uint16_t *p_distance, uint8_t *p_received_byte)
-{
-	if (is_forward_gear(p_received_byte))
-	{
-		if (*p_distance < DISTANCE_LIMIT && *p_distance != 0)
-		{
-			motors_set_both_neutral();
-		}
-		else
-		{
-			motors_set_both_forward();
-		}
-	}
-	else
-	{
-		motors_set_both_reverse();
-	}
-}
-
-uint8_t is_forward_gear(uint8_t *p_received_byte)
-{
-	return *p_received_byte & (1 << GEAR_SEL_BIT);
-}
-
-
-
-void set_PWM(uint8_t *p_received_byte)
-{
-	if (is_left_motor(p_received_byte))
-	{
-		motors_set_left_PWM(*p_received_byte & 0b11111100);
-	}
-	else
-	{
-		motors_set_right_PWM(*p_received_byte & 0b11111100);
-	}
-}
-
-uint8_t is_left_motor(uint8_t *p_received_byte)
-{
-	return *p_received_byte & (1 << MOTOR_SEL_BIT);
-}
-
-
-
-/******************************************************************************
-	Collision handling
-******************************************************************************/
-uint8_t is_collision_detected(void)
-{
-	mpu6050_getRawAccData(&ax, &ay, &az);
-
-	//print_rawAccData();
-
-	return ax > MPU6050_X_ZERO + COLLISION_LIMIT ||
-	       ax < MPU6050_X_ZERO - COLLISION_LIMIT ||
-	       ay > MPU6050_Y_ZERO + COLLISION_LIMIT ||
-		   ay < MPU6050_Y_ZERO - COLLISION_LIMIT ||
-	       az > MPU6050_Z_ZERO + COLLISION_LIMIT ||
-		   az < MPU6050_Z_ZERO - COLLISION_LIMIT;
-}
-
-void handle_collision_detection(void)
-{
-	motors_stop();
-	collision_confirmed = 0;
-	usart_transmit_character('1'); //transmit error code 1: collision detected
-
-	while (!collision_confirmed)
-	{
-		if (usart_receive())
-		{
-			if (UDR0 == '1')
-			{
-				collision_confirmed = 1;
-			}
-		}
-	}
-}
-
-/* Converts the raw accelerometer data into strings and
-   transmits them via USART for debugging and setup purposes.
-*/
-void print_rawAccData(void)
-{
-	usart_transmit_character('X');
-	sprintf(buffer, "%d", ax);
-	usart_transmit_string(buffer);
-	usart_transmit_character('\t');
-
-	usart_transmit_character('Y');
-	sprintf(buffer, "%d", ay);
-	usart_transmit_string(buffer);
-	usart_transmit_character('\t');
-
-	usart_transmit_character('Z');
-	sprintf(buffer, "%d", az);
-	usart_transmit_string(buffer);
-	usart_transmit_character('\n');
-}
-
-
-
-/******************************************************************************
-	Replaces garbage chars with ' ', i.e. white space,
-	beginning at '\0' and ends with putting '\0' at provided index.
-	This means that the index provided is the same as the maximum
-	number of chars that gets displayed.
-
-	Example:
-	INDEX			   0	1	 2	   3	4	 5
-	BEFORE: buffer = {'1', '2', '\0', 'g', 'g', 'g'};
-	CALL:	clearBufferGarbage(5, buffer);
-	AFTER:	buffer = {'1', '2', ' ', ' ', ' ', '\0'};
-******************************************************************************/
-void printout_clear_garbage_left_align(int string_length, char *buffer)
-{
-	int i = 0;
-
-	while (buffer[i])				//find null char
-	{
-		i++;
-	}
-
-	while (i < string_length)		//replace garbage chars with white space
-	{
-		buffer[i] = ' ';
-		i++;
-	}
-
-	buffer[string_length] = '\0';	//set last index in buffer to null
+/******************************************************************************
+	REDBOT ROBOT
+
+	Main execution file for RedBot.
+
+	Created: 2020-10-27
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+
+	Last update: 2020-11-03
+    By: Mattias Ahle
+******************************************************************************/
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+#define GEAR_SEL_BIT 1
+#define MOTOR_SEL_BIT 0
+
+//Distance in cm from obstacle when RedBot shall halt forward motion
+#define DISTANCE_LIMIT 30
+
+//MPU6050 ZERO (output when RedBot is leveled and still)
+#define MPU6050_X_ZERO -350
+#define MPU6050_Y_ZERO -35
+#define MPU6050_Z_ZERO 1930
+
+//Incremental output from MPU6050 ZERO to signal collision
+#define COLLISION_LIMIT 10000
+
+//Time between two status messages to the Remote (telemetry)
+#define STATUS_PERIOD_MS 50
+
+//The benchmarks can also be enabled from the build, see the bench_*
+//targets in CMakeLists.txt
+
+//The binary trace (Common/trace/trace.h) is recorded and transmitted
+//when TRACE_RECORDING is defined, see the robot_fw_trace target
+
+//The profiler (Common/profile/profile.h) is compiled when
+//PROFILE_RECORDING is defined, see the robot_fw_profile target
+
+//The timing statistics (Common/timing/timing.h) are transmitted when
+//TIMING_STATISTICS is defined, see the robot_fw_timing target
+
+//The SRAM usage (Common/sram/sram.h) is transmitted on request when
+//SRAM_MONITOR is defined, see the robot_fw_sram target
+
+//Set to 1 to measure the I2C bus throughput to the MPU6050 at start-up,
+//the result is transmitted via USART
+#ifndef I2C_BUS_BENCHMARK
+#define I2C_BUS_BENCHMARK 0
+#endif
+#define I2C_BUS_BENCHMARK_ITERATIONS 100
+
+
+
+/******************************************************************************
+	INCLUDE
+******************************************************************************/
+#include "motors/motors.h"
+#include "usart0.h"
+#include "../Common/i2c/i2cmaster.h"
+#include "../Common/i2c/twi.h"
+#include "../Common/i2c/i2c_bus.h"
+#include "../Common/timer2/timer2.h"
+#include "../Common/link/link.h"
+#include "../Common/bench/bench.h"
+#include "../Common/trace/trace.h"
+#include "../Common/profile/profile.h"
+#include "../Common/sram/sram.h"
+#include "../Common/timing/timing.h"
+#include "mpu6050/mpu6050.h"
+#include "hc_sr04/hc_sr04.h"
+#include "tilt.h"
+#include "command.h"
+#include "GoT.h"
+#include "../Common/hal/hal.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+void control_motors(uint16_t *p_distance);
+void set_gears(uint16_t *distance, uint8_t *p_received_byte);
+void set_PWM(uint8_t *p_received_byte);
+uint8_t is_left_motor(uint8_t *p_received_byte);
+uint8_t is_forward_gear(uint8_t *p_received_byte);
+
+uint8_t is_collision_detected(void);
+void update_accel_peak(uint16_t deviation);
+void handle_collision_detection(void);
+void print_rawAccData(void);
+
+void handle_acc_sample(const mpu6050_sample_t *sample);
+void handle_upright(void);
+void transmit_status(void);
+void transmit_trace(void);
+void print_i2c_bus_benchmark(void);
+
+void printout_clear_garbage_left_align(int string_length, char *buffer);
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+uint16_t distance;
+uint8_t received_byte;
+uint8_t collision_confirmed;
+int16_t ax, ay, az;
+mpu6050_sample_t acc_sample;
+uint32_t acc_sample_age;	//micros from data ready to collision check
+uint8_t distance_warning_sent = 0;
+
+//Set by the TWI interrupt when the robot is upright again, the main loop
+//then clears distance_warning_sent, see handle_upright()
+volatile uint8_t upright_again = 0;
+
+//Telemetry, see transmit_status()
+uint16_t accel_peak = 0;
+uint32_t status_sent_at = 0;
+
+char buffer[50];
+
+
+
+/******************************************************************************
+	MAIN FUNCTION
+******************************************************************************/
+int main(void) {
+	uint8_t collision;
+
+	sram_init();
+	usart_init();
+	timer2_init();
+	motors_init();
+	hc_sr04_init();
+	mpu6050_init();
+	mpu6050_setSampleCallback(handle_acc_sample);
+	TIMING_INIT(usart_transmit_buffer);
+
+#if I2C_BUS_BENCHMARK == 1
+	print_i2c_bus_benchmark();
+#endif
+
+    while (1)
+	{
+		BENCH_BEGIN(BENCH_ROBOT_LOOP);
+		PROFILE_BEGIN(PROFILE_ROBOT_LOOP);
+		TIMING_LOOP(TIMING_ROBOT_DISTANCE);
+
+		//Accelerometer samples are read in the background on MPU6050 data
+		//ready while the distance is measured and the motors are controlled
+
+		distance = hc_sr04_get_distance();
+		TRACE_DISTANCE(distance);
+
+		handle_upright();
+
+		if (distance < DISTANCE_LIMIT && distance != 0 && !distance_warning_sent)
+		{
+			usart_transmit_character('2'); //transmit error code 2: obstacle warning
+			TRACE_EVENT('2');
+			distance_warning_sent = 1;
+		}
+		else if (distance >= DISTANCE_LIMIT && distance != 0 && distance_warning_sent)
+		{
+			usart_transmit_character('0'); //transmit error code 0: no errors
+			TRACE_EVENT('0');
+			distance_warning_sent = 0;
+		}
+		else
+		{
+			//Send nothing
+		}
+
+		TIMING_SECTION(TIMING_ROBOT_TRANSMIT);
+		transmit_status();
+		transmit_trace();
+
+		TIMING_SECTION(TIMING_ROBOT_DELAY);
+		hal_delay_ms(10);
+
+		TIMING_SECTION(TIMING_ROBOT_MOTORS);
+		PROFILE_BEGIN(PROFILE_CONTROL_MOTORS);
+		control_motors(&distance);
+		PROFILE_END(PROFILE_CONTROL_MOTORS);
+
+		TIMING_SECTION(TIMING_ROBOT_COLLISION);
+		BENCH_BEGIN(BENCH_IS_COLLISION_DETECTED);
+		PROFILE_BEGIN(PROFILE_IS_COLLISION_DETECTED);
+		collision = is_collision_detected();
+		PROFILE_END(PROFILE_IS_COLLISION_DETECTED);
+		BENCH_END(BENCH_IS_COLLISION_DETECTED);
+
+		if (collision)
+		{
+			handle_collision_detection();
+		}
+
+		TRACE_MOTORS(motors_get_left_speed(), motors_get_right_speed());
+
+		PROFILE_END(PROFILE_ROBOT_LOOP);
+		BENCH_END(BENCH_ROBOT_LOOP);
+	}
+}
+
+
+
+/******************************************************************************
+	SUB FUNCTIONS
+******************************************************************************/
+
+/******************************************************************************
+	Motor control
+******************************************************************************/
+void control_motors(uint16_t *p_distance)
+{
+	command_t command;
+
+	while (usart_receive())
+	{
+		received_byte = hal_usart_read();
+		TRACE_COMMAND(received_byte);
+
+		//Frames and requests on the link never reach the motors
+		command_receive(received_byte, &command);
+
+		if (command.request == PROFILE_REQUEST)
+		{
+			PROFILE_DRAIN(usart_transmit_buffer);
+		}
+		else if (command.request == SRAM_REQUEST)
+		{
+			SRAM_REPORT(usart_transmit_buffer);
+		}
+
+		//A tip-over from the TWI interrupt stops the motors either before
+		//the check or after the command, never between
+		HAL_CRITICAL_SECTION
+		{
+			if (!tilt_is_tipped()) //motors stay stopped until upright
+			{
+				for (uint8_t i = 0; i < command.count; i++)
+				{
+					set_gears(p_distance, &command.bytes[i]);
+					set_PWM(&command.bytes[i]);
+				}
+			}
+		}
+
+		if (!command.held)
+		{
+			break; //else read on, held bytes wait for the next ones
+		}
+	}
+}
+
+void set_gears(uint16_t *p_distance, uint8_t *p_received_byte)
+{
+	if (is_forward_gear(p_received_byte))
+	{
+		if (*p_distance < DISTANCE_LIMIT && *p_distance != 0)
+		{
+			motors_set_both_neutral();
+		}
+		else
+		{
+			motors_set_both_forward();
+		}
+	}
+	else
+	{
+		motors_set_both_reverse();
+	}
+}
+
+uint8_t is_forward_gear(uint8_t *p_received_byte)
+{
+	return *p_received_byte & (1 << GEAR_SEL_BIT);
+}
+
+
+
+void set_PWM(uint8_t *p_received_byte)
+{
+	if (is_left_motor(p_received_byte))
+	{
+		motors_set_left_PWM(*p_received_byte & 0b11111100);
+	}
+	else
+	{
+		motors_set_right_PWM(*p_received_byte & 0b11111100);
+	}
+}
+
+uint8_t is_left_motor(uint8_t *p_received_byte)
+{
+	return *p_received_byte & (1 << MOTOR_SEL_BIT);
+}
+
+
+
+/******************************************************************************
+	Collision handling
+******************************************************************************/
+uint8_t is_collision_detected(void)
+{
+	if (!mpu6050_getSample(&acc_sample))
+	{
+		return 0; //no new sample to check
+	}
+
+	acc_sample_age = timer2_get_micros() - acc_sample.timestamp;
+	ax = acc_sample.ax;
+	ay = acc_sample.ay;
+	az = acc_sample.az;
+
+	//print_rawAccData();
+
+	update_accel_peak(labs((int32_t)ax - MPU6050_X_ZERO));
+	update_accel_peak(labs((int32_t)ay - MPU6050_Y_ZERO));
+	update_accel_peak(labs((int32_t)az - MPU6050_Z_ZERO));
+
+	return ax > MPU6050_X_ZERO + COLLISION_LIMIT ||
+	       ax < MPU6050_X_ZERO - COLLISION_LIMIT ||
+	       ay > MPU6050_Y_ZERO + COLLISION_LIMIT ||
+		   ay < MPU6050_Y_ZERO - COLLISION_LIMIT ||
+	       az > MPU6050_Z_ZERO + COLLISION_LIMIT ||
+		   az < MPU6050_Z_ZERO - COLLISION_LIMIT;
+}
+
+void update_accel_peak(uint16_t deviation)
+{
+	if (deviation > accel_peak)
+	{
+		accel_peak = deviation;
+	}
+}
+
+/******************************************************************************
+	Tip-over handling
+
+	Called from the TWI interrupt with every new accelerometer sample, so
+	the motors are stopped as soon as tilt_update() reports the tip-over.
+	The event is queued right away, the transmit queue keeps it out of the
+	bytes of a status message.
+******************************************************************************/
+void handle_acc_sample(const mpu6050_sample_t *sample)
+{
+	uint8_t event;
+
+	PROFILE_BEGIN(PROFILE_HANDLE_ACC_SAMPLE);
+	TRACE_ACCEL(sample->ax, sample->ay, sample->az);
+
+	event = tilt_update(sample->ax - MPU6050_X_ZERO,
+								sample->ay - MPU6050_Y_ZERO,
+								sample->az);
+
+	if (event == TILT_EVENT_TIPPED)
+	{
+		motors_stop();
+		usart_transmit_character('3'); //transmit error code 3: tipped over
+		TRACE_EVENT('3');
+	}
+	else if (event == TILT_EVENT_UPRIGHT)
+	{
+		usart_transmit_character('0'); //transmit error code 0: no errors
+		TRACE_EVENT('0');
+		upright_again = 1;
+	}
+
+	PROFILE_END(PROFILE_HANDLE_ACC_SAMPLE);
+}
+
+void handle_upright(void)
+{
+	uint8_t upright;
+
+	HAL_CRITICAL_SECTION
+	{
+		upright = upright_again;
+		upright_again = 0;
+	}
+
+	if (upright)
+	{
+		distance_warning_sent = 0; //warn again if the obstacle is still there
+	}
+}
+
+void handle_collision_detection(void)
+{
+	uint8_t byte;
+	command_t command;
+
+	motors_stop();
+	collision_confirmed = 0;
+	usart_transmit_character('1'); //transmit error code 1: collision detected
+	TRACE_EVENT('1');
+	TRACE_MOTORS(motors_get_left_speed(), motors_get_right_speed());
+
+	while (!collision_confirmed)
+	{
+		transmit_trace();
+
+		if (usart_receive())
+		{
+			byte = hal_usart_read();
+			TRACE_COMMAND(byte);
+			command_receive(byte, &command); //not a byte of a frame
+
+			for (uint8_t i = 0; i < command.count; i++)
+			{
+				if (command.bytes[i] == '1')
+				{
+					collision_confirmed = 1;
+				}
+			}
+		}
+	}
+}
+
+/******************************************************************************
+	Telemetry
+
+	Transmits motor speeds, distance and the accelerometer peak to the
+	Remote every STATUS_PERIOD_MS, as a status message (link.h). The
+	message is skipped rather than waited for if the transmit queue is
+	still busy.
+******************************************************************************/
+void transmit_status(void)
+{
+	uint8_t frame[LINK_STATUS_FRAME_LENGTH];
+	link_status_t status;
+	int16_t left = motors_get_left_speed();
+	int16_t right = motors_get_right_speed();
+
+	if (timer2_get_millis() - status_sent_at < STATUS_PERIOD_MS ||
+		usart_transmit_space() < LINK_STATUS_FRAME_LENGTH)
+	{
+		return;
+	}
+
+	status.left_pwm = abs(left);
+	status.right_pwm = abs(right);
+	status.flags = 0;
+	if (left < 0)
+	{
+		status.flags |= LINK_STATUS_LEFT_REVERSE;
+	}
+	if (right < 0)
+	{
+		status.flags |= LINK_STATUS_RIGHT_REVERSE;
+	}
+	if (distance_warning_sent)
+	{
+		status.flags |= LINK_STATUS_OBSTACLE;
+	}
+	if (tilt_is_tipped())
+	{
+		status.flags |= LINK_STATUS_TIPPED;
+	}
+	status.distance_cm = distance;
+	status.accel_peak = accel_peak;
+
+	usart_transmit_buffer(frame, link_encode_status(&status, frame));
+
+	status_sent_at = timer2_get_millis();
+	accel_peak = 0;
+}
+
+/******************************************************************************
+	Trace
+
+	Transmits the recorded trace records (trace.h) as trace messages
+	while the transmit queue has room for a whole message, the records
+	wait in the trace buffer otherwise. Empty without TRACE_RECORDING.
+******************************************************************************/
+void transmit_trace(void)
+{
+#ifdef TRACE_RECORDING
+	uint8_t payload[LINK_MAX_PAYLOAD];
+	uint8_t frame[LINK_MAX_PAYLOAD + LINK_FRAME_OVERHEAD];
+	uint8_t length;
+
+	while (usart_transmit_space() >= sizeof(frame) &&
+		   (length = trace_take(payload, LINK_MAX_PAYLOAD)) != 0)
+	{
+		usart_transmit_buffer(frame, link_encode(LINK_TYPE_TRACE, payload, length, frame));
+	}
+#endif
+}
+
+/* Converts the raw accelerometer data into strings and
+   transmits them via USART for debugging and setup purposes.
+*/
+void print_rawAccData(void)
+{
+	usart_transmit_character('X');
+	sprintf(buffer, "%d", ax);
+	usart_transmit_string(buffer);
+	usart_transmit_character('\t');
+
+	usart_transmit_character('Y');
+	sprintf(buffer, "%d", ay);
+	usart_transmit_string(buffer);
+	usart_transmit_character('\t');
+
+	usart_transmit_character('Z');
+	sprintf(buffer, "%d", az);
+	usart_transmit_string(buffer);
+	usart_transmit_character('\t');
+
+	usart_transmit_character('T');
+	sprintf(buffer, "%lu", (unsigned long)acc_sample_age);
+	usart_transmit_string(buffer);
+	usart_transmit_character('\n');
+}
+
+/* Reads the raw accelerometer data a number of times through the
+   transaction engine and transmits the I2C bus throughput via USART.
+*/
+void print_i2c_bus_benchmark(void)
+{
+	static uint8_t acc_data[6];
+	static twi_transaction_t acc_read = {
+		.address = MPU6050_ADDR >> 1,
+		.flags = TWI_FLAG_PREFIX,
+		.prefix = MPU6050_RA_ACCEL_XOUT_H,
+		.read_buffer = acc_data,
+		.read_length = 6,
+	};
+	i2c_bus_benchmark_t result;
+
+	i2c_bus_benchmark(&acc_read, I2C_BUS_BENCHMARK_ITERATIONS, &result);
+
+	sprintf(buffer, "I2C %u x 6 B: %lu us\n", result.iterations,
+		(unsigned long)result.micros);
+	usart_transmit_string(buffer);
+	sprintf(buffer, "%lu B/s, %u errors\n", (unsigned long)result.bytes_per_second,
+		result.errors);
+	usart_transmit_string(buffer);
+
+#ifdef HAL_HOST
+	//the USART of the host build goes to stdout only with HAL_HOST_USART_STDIO
+	printf("I2C %u x 6 B: %lu us, %lu B/s, %u errors\n", result.iterations,
+		(unsigned long)result.micros, (unsigned long)result.bytes_per_second,
+		result.errors);
+#endif
+}
+
+
+
+/******************************************************************************
+	Replaces garbage chars with ' ', i.e. white space,
+	beginning at '\0' and ends with putting '\0' at provided index.
+	This means that the index provided is the same as the maximum
+	number of chars that gets displayed.
+
+	Example:
+	INDEX			   0	1	 2	   3	4	 5
+	BEFORE: buffer = {'1', '2', '\0', 'g', 'g', 'g'};
+	CALL:	clearBufferGarbage(5, buffer);
+	AFTER:	buffer = {'1', '2', ' ', ' ', ' ', '\0'};
+******************************************************************************/
+void printout_clear_garbage_left_align(int string_length, char *buffer)
+{
+	int i = 0;
+
+	while (buffer[i])				//find null char
+	{
+		i++;
+	}
+
+	while (i < string_length)		//replace garbage chars with white space
+	{
+		buffer[i] = ' ';
+		i++;
+	}
+
+	buffer[string_length] = '\0';	//set last index in buffer to null
 }
\ No newline at end of file
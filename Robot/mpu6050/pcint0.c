@@ -0,0 +1,52 @@
+/******************************************************************************
+	PCINT0 IMPLEMENTATION FILE
+
+	This file contains function implementations to handle Pin Change
+	Interrupt 0. INT0 @ PORTD2 is taken by the left motor (L_CTRL_1), so
+	pins on PORTB are used for external interrupts instead.
+
+    Implement the interrupt service routine for PCINT0 in your
+    execution file:
+
+    ISR(PCINT0_vect) {
+        //interrupt code, read PINB to find the edge
+    }
+
+	For more information regarding the implementation, please refer to
+	Atmel-8271J-AVR- ATmega-Datasheet_11/2015.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "pcint0.h"
+#include "../../Common/hal/hal.h"
+
+
+
+/******************************************************************************
+	Function name:	pcint0_init()
+
+	This function initializes Pin Change Interrupt 0 for one pin on PORTB.
+	The pin is set as input. Any logical change on the pin generates an
+	interrupt request, the ISR has to read the pin to find the edge.
+
+	PCICR - Pin Change Interrupt Control Register
+		bit    7	  6      5      4      3      2      1      0
+			[  -  ][  -  ][  -  ][  -  ][  -  ][PCIE2][PCIE1][PCIE0]
+
+		PCIE0 enables PCINT0..7 @ PORTB0..7, the pins are selected in
+		PCMSK0 - Pin Change Mask Register 0.
+
+	Inputs:		uint8_t pin, PINB0..PINB7
+	Outputs:	void
+	Calls:		sei()
+******************************************************************************/
+void pcint0_init(uint8_t pin) {
+	hal_gpio_input(B, 1 << pin);	//pin set as input
+
+	hal_pcint0_enable(1 << pin);	//select pin, clear pending request, activate PCINT0
+
+	hal_interrupts_enable();		//Enable interrupts globally
+}
+/*****************************************************************************/
@@ -0,0 +1,20 @@
+/******************************************************************************
+	PIN CHANGE INTERRUPT 0 HEADER FILE
+
+	This file contains the public interface to interact with and use
+	Pin Change Interrupt 0 (PCINT0..7 @ PORTB).
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef PCINT0_H_
+#define PCINT0_H_
+
+#include <stdint.h>
+
+void pcint0_init(uint8_t pin);
+
+
+
+#endif /* PCINT0_H_ */
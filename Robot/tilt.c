@@ -0,0 +1,128 @@
+/******************************************************************************
+	TILT MONITOR IMPLEMENTATION FILE
+
+	This file contains implementations to detect tilt and tip-over of the
+	robot from accelerometer samples. See tilt.h for the method.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "tilt.h"
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Raw samples are scaled down before squaring, so that the sum of squares
+//times 256 fits in 32 bits: (32768 >> 4)^2 * 3 * 256 < 2^32
+#define TILT_SAMPLE_SHIFT 4
+
+//Samples with less than about 1/4 g (at +-16 g full scale) are not used,
+//the robot is in free fall or the sample is garbage
+#define TILT_MIN_MAGNITUDE2 1024UL
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static volatile uint8_t tipped = 0;
+static uint8_t persist_count = 0;		//samples in a row for a change
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static uint8_t is_tilted_beyond(int16_t az, uint32_t az2_q8, uint32_t magnitude2,
+								uint8_t cos2_q8);
+
+
+
+/******************************************************************************
+	This function updates the tilt state with a new accelerometer sample.
+	The sample shall have the leveled offsets of x and y removed, z holds
+	gravity (positive when upright).
+
+	Inputs:		int16_t ax, ay, az, raw accelerometer sample
+	Outputs:	uint8_t, TILT_EVENT_xxx
+	Calls:		is_tilted_beyond()
+******************************************************************************/
+uint8_t tilt_update(int16_t ax, int16_t ay, int16_t az) {
+	int16_t x = ax >> TILT_SAMPLE_SHIFT;
+	int16_t y = ay >> TILT_SAMPLE_SHIFT;
+	int16_t z = az >> TILT_SAMPLE_SHIFT;
+
+	uint32_t az2 = (uint32_t)((int32_t)z * z);
+	uint32_t magnitude2 = (uint32_t)((int32_t)x * x) + (uint32_t)((int32_t)y * y) + az2;
+	uint8_t change;
+
+	if (magnitude2 < TILT_MIN_MAGNITUDE2) {
+		return TILT_EVENT_NONE;
+	}
+
+	if (!tipped && (z <= 0 || (magnitude2 < TILT_STILL_MAGNITUDE2 &&
+					is_tilted_beyond(z, az2 << 8, magnitude2, TILT_HARD_COS2_Q8)))) {
+		persist_count = 0;				//unambiguous, no debounce
+		tipped = 1;
+		return TILT_EVENT_TIPPED;
+	}
+
+	if (!tipped) {
+		change = is_tilted_beyond(z, az2 << 8, magnitude2, TILT_LIMIT_COS2_Q8);
+	} else {
+		change = !is_tilted_beyond(z, az2 << 8, magnitude2, TILT_CLEAR_COS2_Q8);
+	}
+
+	if (!change) {
+		persist_count = 0;
+		return TILT_EVENT_NONE;
+	}
+
+	if (++persist_count < TILT_PERSIST_SAMPLES) {
+		return TILT_EVENT_NONE;
+	}
+
+	persist_count = 0;
+	tipped = !tipped;
+	return tipped ? TILT_EVENT_TIPPED : TILT_EVENT_UPRIGHT;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function returns 1 (true) if the robot is tipped over.
+
+	Inputs:		none
+	Outputs:	uint8_t
+	Calls:		none
+******************************************************************************/
+uint8_t tilt_is_tipped(void) {
+	return tipped;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function returns 1 (true) if the angle between gravity and the z
+	axis is larger than the angle given as cos^2 in Q8. Upside down (z
+	pointing down) is always beyond.
+
+	Inputs:		int16_t az, uint32_t az2_q8 (az^2 * 256),
+				uint32_t magnitude2, uint8_t cos2_q8
+	Outputs:	uint8_t
+	Calls:		none
+******************************************************************************/
+static uint8_t is_tilted_beyond(int16_t az, uint32_t az2_q8, uint32_t magnitude2,
+								uint8_t cos2_q8) {
+	if (az <= 0) {
+		return 1;
+	}
+
+	return az2_q8 < cos2_q8 * magnitude2;
+}
+/*****************************************************************************/
@@ -0,0 +1,72 @@
+/******************************************************************************
+	TILT MONITOR HEADER FILE
+
+	This file contains the interface to interact with and use tilt.c.
+
+	The tilt monitor compares the gravity vector measured by the MPU6050
+	with the robot z axis (up when leveled). The tilt angle is never
+	calculated, instead cos^2 of the angle is compared with thresholds in
+	Q8 (256 = 1.0):
+
+		tilted beyond angle  <=>  az^2 * 256 < cos2_q8 * (ax^2 + ay^2 + az^2)
+
+	 angle	cos2_q8			 angle	cos2_q8
+	  20	  226			  45	  128
+	  25	  210			  50	  106
+	  30	  192			  55	   84
+	  35	  172			  60	   64
+	  40	  150			  70	   30
+
+	The robot is reported tipped over beyond TILT_LIMIT_COS2_Q8 and back
+	upright below TILT_CLEAR_COS2_Q8 (hysteresis). Either change needs
+	TILT_PERSIST_SAMPLES samples in a row, so that the short swing of the
+	measured vector when the robot brakes or bumps into something is not
+	taken for a tip-over. An attitude that braking cannot fake is a
+	tip-over with the first sample: upside down (z pointing down), or
+	beyond TILT_HARD_COS2_Q8 with no more than TILT_STILL_MAGNITUDE2 of
+	acceleration, where braking hard enough to swing the vector that far
+	measures about 2 g.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef TILT_H_
+#define TILT_H_
+
+#include <stdint.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+//Tip-over at 45 degrees, upright again at 35 degrees
+#define TILT_LIMIT_COS2_Q8 128
+#define TILT_CLEAR_COS2_Q8 172
+
+//Tip-over with a single sample at 60 degrees if the robot measures less
+//than about 1.25 g (at +-16 g full scale, samples scaled as in tilt.c)
+#define TILT_HARD_COS2_Q8 64
+#define TILT_STILL_MAGNITUDE2 25600UL
+
+//Samples in a row beyond the threshold before the state changes, 100 ms
+//at the 200 Hz sample rate of the MPU6050
+#define TILT_PERSIST_SAMPLES 20
+
+//Events returned by tilt_update()
+#define TILT_EVENT_NONE		0
+#define TILT_EVENT_TIPPED	1
+#define TILT_EVENT_UPRIGHT	2
+
+
+
+/******************************************************************************
+	PUBLIC FUNCTIONS
+******************************************************************************/
+uint8_t tilt_update(int16_t ax, int16_t ay, int16_t az);
+uint8_t tilt_is_tipped(void);
+
+
+
+#endif /* TILT_H_ */
@@ -1,113 +1,205 @@
-/******************************************************************************
-	USART0 MAIN FILE
-
-	This file contains function implementations to handle USART0.
-
-	Be aware of code blocks in this file market with header "EDIT IF
-	NECESSARY". Make sure these blocks hold the code wanted.
-
-	For more information regarding the implementation, please refer to
-	Atmel-8271J-AVR- ATmega-Datasheet_11/2015.
-
-	Author: Mattias Ahle
-			mattias.ahle@gmail.com
-	Created: 2020-09-08
-	Last update: 2020-10-27
-******************************************************************************/
-
-
-
-/******************************************************************************
-	EDIT IF NECESSARY
-******************************************************************************/
-#define F_CPU 16000000UL
-#define BAUDRATE 9600
-/*****************************************************************************/
-#define UBRR_BAUDRATE ((F_CPU / (BAUDRATE * 16L)) - 1)
-
-#include <avr/io.h>
-#include <avr/interrupt.h>
-
-
-
-/******************************************************************************
-	FUNCTION PROTOTYPES
-******************************************************************************/
-void usart_init(void);
-void usart_transmit_character(char c);
-void usart_transmit_string(char *s);
-/*****************************************************************************/
-
-
-
-/******************************************************************************
-	EDIT IF NECESSARY - INTERRUPT SERVICE ROUTINE
-******************************************************************************/
-ISR(USART_RX_vect) {
-	//Put code here
-}
-/*****************************************************************************/
-
-
-
-/******************************************************************************
-	This function initializes USART0.
-
-	Inputs:		none
-	Outputs:	none
-	Calls:		sei()
-******************************************************************************/
-void usart_init(void) {
-	UBRR0H = (UBRR_BAUDRATE >> 8);
-	UBRR0L = UBRR_BAUDRATE;
-
-	UCSR0B |= (1 << TXEN0) | (1 << RXEN0); 		//Transmit/Receive enable
-
-	UCSR0C |= (1 << UCSZ01) | (1 << UCSZ00);
-	UCSR0C &= ~(1 << UMSEL00) & ~(1 << UPM00) & ~(1 << USBS0);
-
-	sei();
-}
-
-
-
-/******************************************************************************
-	This function transmits a character via USART-TX.
-
-	Inputs:		char
-	Outputs:	none
-	Calls:		none
-******************************************************************************/
-void usart_transmit_character(char c) {
-	while (!(UCSR0A & (1 << UDRE0))) {}		//wait until sending is possible
-	UDR0 = c;
-}
-
-
-
-/******************************************************************************
-	This function transmits a string via USART-TX.
-
-	Inputs:		char *
-	Outputs:	none
-	Calls:		usart_transmit_character()
-******************************************************************************/
-void usart_transmit_string(char *s) {
-	while (*s) {							//sending char until "/0"
-		usart_transmit_character(*s);
-		s++;
-	}
-}
-
-
-
-/******************************************************************************
-	This function returns 1 (true) if a transmission is received (USART-RX).
-
-	Inputs:		none
-	Outputs:	uint8_t
-	Calls:		none
-******************************************************************************/
-uint8_t usart_receive(void) {
-	return (UCSR0A & (1<<7)) != 0;
+/******************************************************************************
+	USART0 MAIN FILE
+
+	This file contains function implementations to handle USART0.
+
+	Characters are transmitted through a queue that is emptied by the
+	USART Data Register Empty interrupt, so transmitting only waits while
+	the queue is full. A buffer queued by usart_transmit_buffer() is sent
+	back to back, no character transmitted from an interrupt gets between.
+
+	Be aware of code blocks in this file market with header "EDIT IF
+	NECESSARY". Make sure these blocks hold the code wanted.
+
+	For more information regarding the implementation, please refer to
+	Atmel-8271J-AVR- ATmega-Datasheet_11/2015.
+
+	Author: Mattias Ahle
+			mattias.ahle@gmail.com
+	Created: 2020-09-08
+	Last update: 2020-10-27
+******************************************************************************/
+
+
+
+/******************************************************************************
+	EDIT IF NECESSARY
+******************************************************************************/
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+#define BAUDRATE 9600
+#define TX_QUEUE_SIZE 32		//power of 2, largest buffer to transmit
+/*****************************************************************************/
+#define UBRR_BAUDRATE ((F_CPU / (BAUDRATE * 16L)) - 1)
+#define TX_QUEUE_MASK (TX_QUEUE_SIZE - 1)
+
+#include "../Common/hal/hal.h"
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+void usart_init(void);
+void usart_transmit_character(char c);
+void usart_transmit_string(char *s);
+void usart_transmit_buffer(const uint8_t *buffer, uint8_t length);
+uint8_t usart_transmit_space(void);
+static void wait_for_space(uint8_t length);
+static void transmit_next(void);
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+//Characters from tx_tail up to tx_head wait to be transmitted
+static volatile uint8_t tx_queue[TX_QUEUE_SIZE];
+static volatile uint8_t tx_head = 0;
+static volatile uint8_t tx_tail = 0;
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	EDIT IF NECESSARY - INTERRUPT SERVICE ROUTINE
+******************************************************************************/
+ISR(USART_RX_vect) {
+	//Put code here
+}
+
+ISR(USART_UDRE_vect) {
+	transmit_next();
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function initializes USART0.
+
+	Inputs:		none
+	Outputs:	none
+	Calls:		sei()
+******************************************************************************/
+void usart_init(void) {
+	hal_usart_init(UBRR_BAUDRATE);				//Transmit/Receive enable, 8N1
+
+	hal_interrupts_enable();
+}
+
+
+
+/******************************************************************************
+	This function transmits a character via USART-TX. It waits only while
+	the transmit queue is full.
+
+	Inputs:		char
+	Outputs:	none
+	Calls:		usart_transmit_buffer()
+******************************************************************************/
+void usart_transmit_character(char c) {
+	usart_transmit_buffer((const uint8_t *)&c, 1);
+}
+
+
+
+/******************************************************************************
+	This function transmits a string via USART-TX.
+
+	Inputs:		char *
+	Outputs:	none
+	Calls:		usart_transmit_character()
+******************************************************************************/
+void usart_transmit_string(char *s) {
+	while (*s) {							//sending char until "/0"
+		usart_transmit_character(*s);
+		s++;
+	}
+}
+
+
+
+/******************************************************************************
+	This function queues a buffer for transmission via USART-TX, waiting
+	while the queue has no room for all of it. The buffer is queued in one
+	piece and can be reused on return.
+
+	Inputs:		const uint8_t *buffer
+				uint8_t length, at most TX_QUEUE_SIZE - 1
+	Outputs:	none
+	Calls:		wait_for_space()
+******************************************************************************/
+void usart_transmit_buffer(const uint8_t *buffer, uint8_t length) {
+	wait_for_space(length);
+
+	HAL_CRITICAL_SECTION {
+		for (uint8_t i = 0; i < length; i++) {
+			tx_queue[tx_head] = buffer[i];
+			tx_head = (tx_head + 1) & TX_QUEUE_MASK;
+		}
+
+		hal_usart_udre_interrupt(1);		//start, the interrupt empties the queue
+	}
+}
+
+
+
+/******************************************************************************
+	This function returns the number of characters that can be queued
+	without waiting.
+
+	Inputs:		none
+	Outputs:	uint8_t
+	Calls:		none
+******************************************************************************/
+uint8_t usart_transmit_space(void) {
+	return (tx_tail - tx_head - 1) & TX_QUEUE_MASK;
+}
+
+
+
+/******************************************************************************
+	This function returns 1 (true) if a transmission is received (USART-RX).
+
+	Inputs:		none
+	Outputs:	uint8_t
+	Calls:		none
+******************************************************************************/
+uint8_t usart_receive(void) {
+	return hal_usart_received() != 0;
+}
+
+
+
+/******************************************************************************
+	Waits until the queue has room for length characters. With interrupts
+	disabled (e.g. called from an interrupt service routine) the queue is
+	emptied by polling, since the interrupt cannot do it.
+******************************************************************************/
+static void wait_for_space(uint8_t length) {
+	while (usart_transmit_space() < length) {
+		if (!hal_interrupts_enabled()) {
+			while (!hal_usart_ready()) {}
+			transmit_next();
+		}
+	}
+}
+
+
+
+/******************************************************************************
+	Writes the next queued character to UDR0, or stops the interrupt when
+	the queue is empty.
+******************************************************************************/
+static void transmit_next(void) {
+	if (tx_head == tx_tail) {
+		hal_usart_udre_interrupt(0);
+		return;
+	}
+
+	hal_usart_write(tx_queue[tx_tail]);
+	tx_tail = (tx_tail + 1) & TX_QUEUE_MASK;
 }
\ No newline at end of file
@@ -0,0 +1,25 @@
+# Toolchain file for the ATmega328P firmware (remote_fw, robot_fw).
+#
+# The top level CMakeLists.txt uses it for its firmware sub-build when
+# avr-gcc is installed. It can also be given directly to build only the
+# firmware:
+#
+#   cmake -S . -B build-avr -DCMAKE_TOOLCHAIN_FILE=cmake/avr-gcc.cmake
+#   cmake --build build-avr
+
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR avr)
+
+find_program(AVR_GCC avr-gcc REQUIRED)
+find_program(AVR_OBJCOPY avr-objcopy REQUIRED)
+find_program(AVR_SIZE avr-size REQUIRED)
+find_program(AVR_NM avr-nm REQUIRED)
+
+set(CMAKE_C_COMPILER ${AVR_GCC})
+
+# No executable can be linked before -mmcu is known
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
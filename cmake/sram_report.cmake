@@ -0,0 +1,107 @@
+# SRAM report of a firmware, run by add_firmware() after linking.
+#
+# Sums the .data and .bss symbols of each source file from the debug
+# information of the ELF file (avr-nm -l), and the SRAM left for the
+# stack. The bytes no symbol accounts for, e.g. string literals, which
+# avr-gcc puts in .data, are reported as "other". The report is printed
+# and written to REPORT:
+#
+#   cmake -DNM=avr-nm -DELF=robot_fw.elf -DREPORT=robot_fw.sram.txt
+#         -DSOURCE_DIR=. -DSRAM_SIZE=2048 -P cmake/sram_report.cmake
+
+cmake_minimum_required(VERSION 3.13)
+
+execute_process(COMMAND ${NM} --size-sort -S -l ${ELF}
+	OUTPUT_VARIABLE symbols RESULT_VARIABLE result)
+if(result)
+	message(FATAL_ERROR "${NM} failed on ${ELF}")
+endif()
+
+# Section bounds of the linker script
+execute_process(COMMAND ${NM} ${ELF} OUTPUT_VARIABLE bounds)
+foreach(bound __data_start __data_end __bss_start __bss_end)
+	if(bounds MATCHES "([0-9a-fA-F]+) [A-Za-z] ${bound}\n")
+		math(EXPR ${bound} "0x${CMAKE_MATCH_1}")
+	endif()
+endforeach()
+
+# Width of the columns
+function(pad text width out)
+	string(LENGTH "${text}" length)
+	while(length LESS width)
+		string(APPEND text " ")
+		math(EXPR length "${length} + 1")
+	endwhile()
+	set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+function(pad_left text width out)
+	string(LENGTH "${text}" length)
+	while(length LESS width)
+		set(text " ${text}")
+		math(EXPR length "${length} + 1")
+	endwhile()
+	set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+set(modules)
+set(data_total 0)
+set(bss_total 0)
+string(REPLACE "\n" ";" lines "${symbols}")
+foreach(line IN LISTS lines)
+	if(NOT line MATCHES "^[0-9a-fA-F]+ ([0-9a-fA-F]+) ([bBdD]) [^\t]+\t?(.*)$")
+		continue()
+	endif()
+	math(EXPR size "0x${CMAKE_MATCH_1}")
+	string(TOLOWER ${CMAKE_MATCH_2} section)
+	string(REGEX REPLACE ":[0-9]+$" "" module "${CMAKE_MATCH_3}")
+	if(module STREQUAL "")
+		set(module "(no debug information)")
+	elseif(IS_ABSOLUTE "${module}")
+		file(RELATIVE_PATH module ${SOURCE_DIR} ${module})
+	endif()
+
+	if(NOT module IN_LIST modules)
+		list(APPEND modules ${module})
+		set(d_${module} 0)
+		set(b_${module} 0)
+	endif()
+	if(section STREQUAL "d")
+		math(EXPR d_${module} "${d_${module}} + ${size}")
+		math(EXPR data_total "${data_total} + ${size}")
+	else()
+		math(EXPR b_${module} "${b_${module}} + ${size}")
+		math(EXPR bss_total "${bss_total} + ${size}")
+	endif()
+endforeach()
+
+list(SORT modules)
+pad("module" 40 text)
+set(report "${text}  data   bss\n")
+foreach(module IN LISTS modules)
+	pad("${module}" 40 text)
+	pad_left(${d_${module}} 6 data)
+	pad_left(${b_${module}} 6 bss)
+	string(APPEND report "${text}${data}${bss}\n")
+endforeach()
+
+if(DEFINED __data_end AND DEFINED __bss_end)
+	math(EXPR data_other "${__data_end} - ${__data_start} - ${data_total}")
+	math(EXPR bss_other "${__bss_end} - ${__bss_start} - ${bss_total}")
+	math(EXPR data_total "${__data_end} - ${__data_start}")
+	math(EXPR bss_total "${__bss_end} - ${__bss_start}")
+	pad("other" 40 text)
+	pad_left(${data_other} 6 data)
+	pad_left(${bss_other} 6 bss)
+	string(APPEND report "${text}${data}${bss}\n")
+endif()
+
+pad("total" 40 text)
+pad_left(${data_total} 6 data)
+pad_left(${bss_total} 6 bss)
+math(EXPR stack "${SRAM_SIZE} - ${data_total} - ${bss_total}")
+string(APPEND report "${text}${data}${bss}\n"
+	"SRAM ${SRAM_SIZE} B, ${stack} B left for the stack\n")
+
+file(WRITE ${REPORT} "${report}")
+message("${report}")
@@ -0,0 +1,573 @@
+/******************************************************************************
+	CYCLE BENCHMARK
+
+	Host tool that runs a firmware built with BENCH_MARKERS (remote_fw_bench
+	or robot_fw_bench) in simavr and measures the CPU cycles of the hot
+	paths marked in the code, see Common/bench/bench.h. For each hot path
+	the number of runs and the minimum, mean and maximum cycles per run
+	are written as JSON, one hot path per line.
+
+	The peripherals outside the ATmega328P are stubs, enough for both
+	firmwares to run their main loops:
+		- USART0: the output is counted, two motor bytes (left and right,
+		  half speed forward) are received every UART_INPUT_PERIOD_US.
+		- TWI: every address is acknowledged. The MPU6050 (0x68) has a
+		  register file like the chip, WHO_AM_I = 0x68.
+		- MPU6050 INT @ PB2: a data ready pulse every
+		  MPU6050_SAMPLE_PERIOD_US.
+		- HC-SR04 echo @ PD3: after a trigger pulse on PB1, an echo for
+		  an obstacle at HC_SR04_DISTANCE_CM.
+	The joystick ADC inputs read 0.
+
+	With a baseline (the results of an earlier run) the mean cycles of
+	every hot path of the baseline are compared with this run. The exit
+	status is 1 if a hot path is slower by more than the threshold or
+	was not run, 2 if the baseline cannot be read.
+
+	Usage:
+		benchsim [-m ms] [-o results.json] [-b baseline.json] [-t percent]
+				 firmware.elf
+
+		-m ms		simulated time, default 10000 ms (the remote shows its
+					intro pictures for 6 s before the main loop)
+		-o results	output file, default stdout
+		-b baseline	results to compare with, must exist
+		-t percent	allowed regression of the mean, default 5 %
+
+	Example (from the build directory):
+		benchsim -b ../tools/benchsim/baseline_robot.json \
+			firmware/robot_fw_bench.elf
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_io.h"
+#include "sim_irq.h"
+#include "sim_time.h"
+#include "sim_cycle_timers.h"
+#include "avr_ioport.h"
+#include "avr_twi.h"
+#include "avr_uart.h"
+#include "../../Common/bench/bench.h"
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define MCU "atmega328p"
+#define F_CPU 16000000UL
+
+#define HOT_PATHS 128					//marker ids below BENCH_END_FLAG
+
+#define UART_INPUT_PERIOD_US 5000
+#define UART_MOTOR_LEFT 0x83			//PWM 32, forward, left
+#define UART_MOTOR_RIGHT 0x82			//PWM 32, forward, right
+
+#define MPU6050_ADDRESS 0x68
+#define MPU6050_REGISTERS 128
+#define MPU6050_PWR_MGMT_1 0x6B
+#define MPU6050_WHO_AM_I 0x75
+#define MPU6050_INT_PIN 2				//PB2
+#define MPU6050_SAMPLE_PERIOD_US 5000		//200 Hz, SMPLRT_DIV of mpu6050.c
+#define MPU6050_INT_PULSE_US 50
+
+#define HC_SR04_TRIG_PIN 1				//PB1
+#define HC_SR04_ECHO_PIN 3				//PD3
+#define HC_SR04_DISTANCE_CM 100
+#define HC_SR04_ECHO_DELAY_US 500
+
+#define DEFAULT_RUN_MS 10000
+#define DEFAULT_THRESHOLD 5.0
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	uint64_t started;					//cycle of the begin marker, 0 = idle
+	uint64_t runs;
+	uint64_t total;
+	uint64_t min;
+	uint64_t max;
+} hot_path_t;
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static void marker_write(avr_t *avr, avr_io_addr_t address, uint8_t value, void *param);
+static void uart_output(avr_irq_t *irq, uint32_t value, void *param);
+static avr_cycle_count_t uart_input(avr_t *avr, avr_cycle_count_t when, void *param);
+static void twi_output(avr_irq_t *irq, uint32_t value, void *param);
+static avr_cycle_count_t mpu6050_interrupt(avr_t *avr, avr_cycle_count_t when, void *param);
+static void hc_sr04_trigger(avr_irq_t *irq, uint32_t value, void *param);
+static avr_cycle_count_t hc_sr04_echo(avr_t *avr, avr_cycle_count_t when, void *param);
+static void connect_stubs(avr_t *avr);
+static void write_results(FILE *out, const char *firmware, uint32_t run_ms);
+static int check_baseline(const char *path, double threshold);
+static const char *hot_path_name(uint8_t id);
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static hot_path_t hot_paths[HOT_PATHS];
+static uint64_t marker_errors;
+
+static avr_irq_t *uart_input_irq;
+static uint64_t uart_bytes;
+static uint8_t uart_next;
+
+static avr_irq_t *twi_irqs;
+static uint8_t twi_selected;			//address of the selected device, 0 = none
+static uint8_t mpu6050_registers[MPU6050_REGISTERS];
+static uint8_t mpu6050_register;
+static uint8_t mpu6050_selecting;		//next byte written selects the register
+
+static avr_irq_t *mpu6050_int_irq;
+static uint8_t mpu6050_int_level;
+static avr_irq_t *hc_sr04_echo_irq;
+static uint8_t hc_sr04_trig_level;
+static uint8_t hc_sr04_echo_level;
+
+#define HOT_PATH_NAME(name, id, string) [id] = string,
+static const char *hot_path_names[HOT_PATHS] = {
+	BENCH_HOT_PATHS(HOT_PATH_NAME)
+};
+
+
+
+/******************************************************************************
+	MAIN
+******************************************************************************/
+int main(int argc, char *argv[]) {
+	const char *output = NULL;
+	const char *baseline = NULL;
+	const char *firmware;
+	double threshold = DEFAULT_THRESHOLD;
+	uint32_t run_ms = DEFAULT_RUN_MS;
+	elf_firmware_t elf;
+	avr_t *avr;
+	avr_cycle_count_t end;
+	int state = cpu_Running;
+	int option;
+	FILE *out = stdout;
+
+	while ((option = getopt(argc, argv, "m:o:b:t:")) != -1) {
+		switch (option) {
+			case 'm':
+				run_ms = strtoul(optarg, NULL, 10);
+				break;
+			case 'o':
+				output = optarg;
+				break;
+			case 'b':
+				baseline = optarg;
+				break;
+			case 't':
+				threshold = strtod(optarg, NULL);
+				break;
+			default:
+				optind = argc + 1;
+				break;
+		}
+	}
+
+	if (optind != argc - 1) {
+		fprintf(stderr, "usage: benchsim [-m ms] [-o results.json] [-b baseline.json] [-t percent] firmware.elf\n");
+		return 2;
+	}
+	firmware = argv[optind];
+
+	memset(&elf, 0, sizeof(elf));
+	if (elf_read_firmware(firmware, &elf) != 0) {
+		fprintf(stderr, "benchsim: cannot read %s\n", firmware);
+		return 2;
+	}
+
+	avr = avr_make_mcu_by_name(MCU);
+	if (!avr) {
+		fprintf(stderr, "benchsim: simavr has no %s core\n", MCU);
+		return 2;
+	}
+	avr_init(avr);
+	avr_load_firmware(avr, &elf);
+	avr->frequency = F_CPU;
+	avr->log = LOG_NONE;
+
+	avr_register_io_write(avr, BENCH_MARKER_ADDRESS, marker_write, NULL);
+	connect_stubs(avr);
+
+	end = avr_usec_to_cycles(avr, (uint64_t)run_ms * 1000);
+	while (avr->cycle < end && state != cpu_Done && state != cpu_Crashed) {
+		state = avr_run(avr);
+	}
+
+	if (state == cpu_Done || state == cpu_Crashed) {
+		fprintf(stderr, "benchsim: %s stopped after %llu cycles\n",
+				firmware, (unsigned long long)avr->cycle);
+		return 2;
+	}
+	if (marker_errors) {
+		fprintf(stderr, "benchsim: %llu unmatched markers\n",
+				(unsigned long long)marker_errors);
+	}
+	fprintf(stderr, "benchsim: %u ms simulated, %llu USART bytes sent\n",
+			run_ms, (unsigned long long)uart_bytes);
+
+	if (output) {
+		out = fopen(output, "w");
+		if (!out) {
+			fprintf(stderr, "benchsim: cannot write %s\n", output);
+			return 2;
+		}
+	}
+	write_results(out, firmware, run_ms);
+	if (output) {
+		fclose(out);
+	}
+
+	if (baseline) {
+		return check_baseline(baseline, threshold);
+	}
+	return 0;
+}
+
+
+
+/******************************************************************************
+	This function is called by simavr for every write to GPIOR0. A begin
+	marker takes the cycle count, the end marker of the same hot path adds
+	the cycles since then to its statistics.
+
+	Inputs:		avr_t *avr, avr_io_addr_t address, uint8_t value, void *param
+	Outputs:	void
+	Calls:		none
+******************************************************************************/
+static void marker_write(avr_t *avr, avr_io_addr_t address, uint8_t value, void *param) {
+	hot_path_t *path = &hot_paths[value & ~BENCH_END_FLAG];
+	uint64_t cycles;
+
+	(void)param;
+	avr->data[address] = value;
+
+	if (!(value & BENCH_END_FLAG)) {
+		if (path->started) {
+			marker_errors++;			//nested in itself or end missing
+		}
+		path->started = avr->cycle;
+		return;
+	}
+
+	if (!path->started) {
+		marker_errors++;
+		return;
+	}
+
+	cycles = avr->cycle - path->started;
+	path->started = 0;
+
+	if (path->runs == 0 || cycles < path->min) {
+		path->min = cycles;
+	}
+	if (cycles > path->max) {
+		path->max = cycles;
+	}
+	path->total += cycles;
+	path->runs++;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function connects the stubs of the peripherals outside the MCU,
+	see the file header.
+
+	Inputs:		avr_t *avr
+	Outputs:	void
+	Calls:		none
+******************************************************************************/
+static void connect_stubs(avr_t *avr) {
+	static const char *twi_names[] = { "8>benchsim.twi.out", "32<benchsim.twi.in" };
+	uint32_t flags = 0;
+
+	//USART0, no echo of the output to the terminal
+	avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &flags);
+	flags &= ~AVR_UART_FLAG_STDIO;
+	avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &flags);
+	avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT),
+							uart_output, NULL);
+	uart_input_irq = avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_INPUT);
+	avr_cycle_timer_register_usec(avr, UART_INPUT_PERIOD_US, uart_input, NULL);
+
+	//TWI, the devices answer on their own IRQs connected to the TWI module
+	twi_irqs = avr_alloc_irq(&avr->irq_pool, 0, 2, twi_names);
+	avr_irq_register_notify(twi_irqs + TWI_IRQ_OUTPUT, twi_output, NULL);
+	avr_connect_irq(twi_irqs + TWI_IRQ_INPUT,
+					avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT));
+	avr_connect_irq(avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT),
+					twi_irqs + TWI_IRQ_OUTPUT);
+	mpu6050_registers[MPU6050_PWR_MGMT_1] = 0x40;
+	mpu6050_registers[MPU6050_WHO_AM_I] = MPU6050_ADDRESS;
+
+	//MPU6050 data ready
+	mpu6050_int_irq = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('B'), MPU6050_INT_PIN);
+	avr_cycle_timer_register_usec(avr, MPU6050_SAMPLE_PERIOD_US, mpu6050_interrupt, NULL);
+
+	//HC-SR04
+	avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('B'), HC_SR04_TRIG_PIN),
+							hc_sr04_trigger, avr);
+	hc_sr04_echo_irq = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), HC_SR04_ECHO_PIN);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	USART0 stub.
+******************************************************************************/
+static void uart_output(avr_irq_t *irq, uint32_t value, void *param) {
+	(void)irq;
+	(void)value;
+	(void)param;
+	uart_bytes++;
+}
+
+static avr_cycle_count_t uart_input(avr_t *avr, avr_cycle_count_t when, void *param) {
+	(void)param;
+	avr_raise_irq(uart_input_irq, uart_next ? UART_MOTOR_RIGHT : UART_MOTOR_LEFT);
+	uart_next = !uart_next;
+	return when + avr_usec_to_cycles(avr, UART_INPUT_PERIOD_US);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	TWI stub. The messages of the TWI module carry the 8 bit address with
+	the R/W bit, a device answers with an ACK or with the data read.
+******************************************************************************/
+static void twi_output(avr_irq_t *irq, uint32_t value, void *param) {
+	avr_twi_msg_irq_t message;
+
+	(void)irq;
+	(void)param;
+	message.u.v = value;
+
+	if (message.u.twi.msg & TWI_COND_STOP) {
+		twi_selected = 0;
+	}
+
+	if (message.u.twi.msg & TWI_COND_START) {
+		twi_selected = message.u.twi.addr;
+		mpu6050_selecting = !(twi_selected & 1);
+		avr_raise_irq(twi_irqs + TWI_IRQ_INPUT,
+					  avr_twi_irq_msg(TWI_COND_ACK, twi_selected, 1));
+	}
+
+	if (!twi_selected) {
+		return;
+	}
+
+	if (message.u.twi.msg & TWI_COND_WRITE) {
+		avr_raise_irq(twi_irqs + TWI_IRQ_INPUT,
+					  avr_twi_irq_msg(TWI_COND_ACK, twi_selected, 1));
+
+		if ((twi_selected >> 1) == MPU6050_ADDRESS) {
+			if (mpu6050_selecting) {
+				mpu6050_register = message.u.twi.data % MPU6050_REGISTERS;
+				mpu6050_selecting = 0;
+			} else {
+				mpu6050_registers[mpu6050_register] = message.u.twi.data;
+				mpu6050_register = (mpu6050_register + 1) % MPU6050_REGISTERS;
+			}
+		}
+	}
+
+	if (message.u.twi.msg & TWI_COND_READ) {
+		uint8_t data = 0;
+
+		if ((twi_selected >> 1) == MPU6050_ADDRESS) {
+			data = mpu6050_registers[mpu6050_register];
+			mpu6050_register = (mpu6050_register + 1) % MPU6050_REGISTERS;
+		}
+		avr_raise_irq(twi_irqs + TWI_IRQ_INPUT,
+					  avr_twi_irq_msg(TWI_COND_READ, twi_selected, data));
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	MPU6050 data ready stub, a high pulse of MPU6050_INT_PULSE_US.
+******************************************************************************/
+static avr_cycle_count_t mpu6050_interrupt(avr_t *avr, avr_cycle_count_t when, void *param) {
+	(void)param;
+	mpu6050_int_level = !mpu6050_int_level;
+	avr_raise_irq(mpu6050_int_irq, mpu6050_int_level);
+
+	if (mpu6050_int_level) {
+		return when + avr_usec_to_cycles(avr, MPU6050_INT_PULSE_US);
+	}
+	return when + avr_usec_to_cycles(avr, MPU6050_SAMPLE_PERIOD_US - MPU6050_INT_PULSE_US);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	HC-SR04 stub. The end of the trigger pulse starts the echo, which is
+	58 us per cm long.
+******************************************************************************/
+static void hc_sr04_trigger(avr_irq_t *irq, uint32_t value, void *param) {
+	avr_t *avr = param;
+
+	(void)irq;
+	if (hc_sr04_trig_level && !value && !hc_sr04_echo_level) {
+		avr_cycle_timer_register_usec(avr, HC_SR04_ECHO_DELAY_US, hc_sr04_echo, NULL);
+	}
+	hc_sr04_trig_level = value != 0;
+}
+
+static avr_cycle_count_t hc_sr04_echo(avr_t *avr, avr_cycle_count_t when, void *param) {
+	(void)param;
+	hc_sr04_echo_level = !hc_sr04_echo_level;
+	avr_raise_irq(hc_sr04_echo_irq, hc_sr04_echo_level);
+
+	if (hc_sr04_echo_level) {
+		return when + avr_usec_to_cycles(avr, HC_SR04_DISTANCE_CM * 58);
+	}
+	return 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function writes the results as JSON, one hot path per line, so
+	check_baseline() can read them back line by line.
+
+	Inputs:		FILE *out, const char *firmware, uint32_t run_ms
+	Outputs:	void
+	Calls:		hot_path_name()
+******************************************************************************/
+static void write_results(FILE *out, const char *firmware, uint32_t run_ms) {
+	uint8_t first = 1;
+	int id;
+
+	fprintf(out, "{\n\t\"firmware\": \"%s\",\n\t\"f_cpu\": %lu,\n\t\"simulated_ms\": %u,\n\t\"hot_paths\": [",
+			firmware, F_CPU, run_ms);
+
+	for (id = 0; id < HOT_PATHS; id++) {
+		const hot_path_t *path = &hot_paths[id];
+
+		if (path->runs == 0) {
+			continue;
+		}
+		fprintf(out, "%s\n\t\t{\"name\": \"%s\", \"id\": %d, \"runs\": %llu, \"min\": %llu, \"mean\": %llu, \"max\": %llu}",
+				first ? "" : ",", hot_path_name(id), id,
+				(unsigned long long)path->runs,
+				(unsigned long long)path->min,
+				(unsigned long long)(path->total / path->runs),
+				(unsigned long long)path->max);
+		first = 0;
+	}
+
+	fprintf(out, "\n\t]\n}\n");
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function compares the mean cycles of every hot path in the baseline
+	with this run and prints the hot paths that are slower by more than the
+	threshold (in percent) or were not run.
+
+	Inputs:		const char *path, double threshold
+	Outputs:	int, exit status: 0 = passed, 1 = regression, 2 = no baseline
+	Calls:		hot_path_name()
+******************************************************************************/
+static int check_baseline(const char *path, double threshold) {
+	FILE *f = fopen(path, "r");
+	char line[512];
+	int regressions = 0;
+
+	if (!f) {
+		fprintf(stderr, "benchsim: no baseline %s, record it with bench_sim_baseline\n", path);
+		return 2;
+	}
+
+	while (fgets(line, sizeof(line), f)) {
+		char name[64];
+		unsigned long long baseline_mean;
+		unsigned long long mean = 0;
+		const char *name_field = strstr(line, "\"name\": \"");
+		const char *mean_field = strstr(line, "\"mean\": ");
+		int id;
+
+		if (!name_field || !mean_field ||
+			sscanf(name_field, "\"name\": \"%63[^\"]\"", name) != 1 ||
+			sscanf(mean_field, "\"mean\": %llu", &baseline_mean) != 1) {
+			continue;
+		}
+
+		for (id = 0; id < HOT_PATHS; id++) {
+			if (hot_paths[id].runs && strcmp(hot_path_name(id), name) == 0) {
+				mean = hot_paths[id].total / hot_paths[id].runs;
+				break;
+			}
+		}
+
+		if (id == HOT_PATHS) {
+			fprintf(stderr, "benchsim: REGRESSION %s: not run\n", name);
+			regressions++;
+		} else if (mean > baseline_mean * (1.0 + threshold / 100.0)) {
+			fprintf(stderr, "benchsim: REGRESSION %s: %llu -> %llu cycles (+%.1f %%)\n",
+					name, baseline_mean, mean,
+					100.0 * ((double)mean - baseline_mean) / baseline_mean);
+			regressions++;
+		} else {
+			fprintf(stderr, "benchsim: %s: %llu -> %llu cycles\n", name, baseline_mean, mean);
+		}
+	}
+	fclose(f);
+
+	return regressions ? 1 : 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	This function returns the name of a hot path, "id_<n>" for an id that
+	is not in BENCH_HOT_PATHS.
+
+	Inputs:		uint8_t id
+	Outputs:	const char *
+	Calls:		none
+******************************************************************************/
+static const char *hot_path_name(uint8_t id) {
+	static char unknown[8];
+
+	if (hot_path_names[id]) {
+		return hot_path_names[id];
+	}
+	snprintf(unknown, sizeof(unknown), "id_%u", id);
+	return unknown;
+}
+/*****************************************************************************/
@@ -0,0 +1,467 @@
+/******************************************************************************
+	IMAGE PACKER
+
+	Host tool that packs full-screen OLED bitmaps into the packed image
+	format drawn by Remote/oled/image.c.
+
+	The bitmaps are read from a C source file (tools/imgpack/bitmaps.c),
+	where each picture is an array of page-ordered column bytes, 128 per
+	page. Each picture given on the command line is packed and written to
+	<output>.c (PROGMEM arrays) and <output>.h (declarations). Every packed
+	picture is unpacked again and compared with the bitmap before it is
+	written.
+
+	Usage:
+		imgpack [-o output] bitmaps.c name[:pages] ...
+
+		-o output	output path without extension, default "images"
+		name		array in bitmaps.c, packed as image_<name>
+		:pages		pack only the first pages of the bitmap
+
+	Example (from the repository root):
+		imgpack -o Remote/oled/images tools/imgpack/bitmaps.c \
+			slak_2020 hkr_logo_two collision_one safe_distance:4
+
+	Packed format (must match Remote/oled/image.h):
+		byte 0		number of pages, drawn from page 0
+		tokens		per page, covering exactly 128 columns, a token
+					never crosses a page:
+			0x00-0x7F	literal, the next (token + 1) bytes are columns
+			0x80-0xBF	repeat, the next byte is repeated
+						((token & 0x3F) + 3) times
+			0xC0-0xFF	blank, ((token & 0x3F) + 1) zero columns, no
+						data bytes
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define PAGE_COLUMNS 128
+#define MAX_PAGES 8
+
+#define TOKEN_LITERAL 0x00
+#define TOKEN_REPEAT 0x80
+#define TOKEN_BLANK 0xC0
+#define TOKEN_TYPE_MASK 0xC0
+
+#define LITERAL_MAX 128
+#define REPEAT_MIN 3
+#define REPEAT_MAX (0x3F + REPEAT_MIN)
+#define BLANK_MIN 2					//a single zero is cheaper in a literal
+#define BLANK_MAX (0x3F + 1)
+
+#define MAX_SOURCE (512 * 1024L)
+#define MAX_PACKED (1 + MAX_PAGES * PAGE_COLUMNS * 2)
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	uint8_t bytes[MAX_PACKED];
+	size_t length;
+} packed_t;
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static char *read_file(const char *path);
+static size_t find_bitmap(const char *source, const char *name,
+						  uint8_t *bitmap, size_t max);
+static void pack(const uint8_t *bitmap, uint8_t pages, packed_t *out);
+static void pack_page(const uint8_t *page, packed_t *out);
+static size_t flush_literal(const uint8_t *literal, size_t length, packed_t *out);
+static int unpack(const packed_t *in, uint8_t *bitmap, uint8_t *pages);
+static void write_array(FILE *c, const char *name, const packed_t *packed,
+						uint8_t pages, size_t bitmap_size);
+
+
+
+/******************************************************************************
+	MAIN
+******************************************************************************/
+int main(int argc, char *argv[]) {
+	const char *output = "images";
+	const char *input;
+	char *source;
+	char path[512];
+	FILE *c;
+	FILE *h;
+	int arg = 1;
+	size_t total_bitmap = 0;
+	size_t total_packed = 0;
+
+	if (argc > 2 && strcmp(argv[1], "-o") == 0) {
+		output = argv[2];
+		arg = 3;
+	}
+
+	if (argc - arg < 2) {
+		fprintf(stderr, "usage: imgpack [-o output] bitmaps.c name[:pages] ...\n");
+		return 2;
+	}
+
+	input = argv[arg++];
+	source = read_file(input);
+	if (!source) {
+		fprintf(stderr, "imgpack: cannot read %s\n", input);
+		return 1;
+	}
+
+	snprintf(path, sizeof(path), "%s.c", output);
+	c = fopen(path, "w");
+	snprintf(path, sizeof(path), "%s.h", output);
+	h = fopen(path, "w");
+	if (!c || !h) {
+		fprintf(stderr, "imgpack: cannot write %s.c/.h\n", output);
+		return 1;
+	}
+
+	fprintf(c, "/******************************************************************************\n"
+			   "\tPACKED IMAGES\n\n"
+			   "\tGenerated by tools/imgpack from tools/imgpack/bitmaps.c, do not edit.\n"
+			   "\tThe format is described in image.h.\n"
+			   "******************************************************************************/\n\n"
+			   "#include \"images.h\"\n");
+
+	fprintf(h, "/******************************************************************************\n"
+			   "\tPACKED IMAGES HEADER FILE\n\n"
+			   "\tGenerated by tools/imgpack from tools/imgpack/bitmaps.c, do not edit.\n"
+			   "\tDraw the images with image_draw() (image.h).\n"
+			   "******************************************************************************/\n\n"
+			   "#ifndef IMAGES_H_\n"
+			   "#define IMAGES_H_\n\n"
+			   "#include <stdint.h>\n"
+			   "#include <avr/pgmspace.h>\n\n");
+
+	for (; arg < argc; arg++) {
+		char name[128];
+		char *colon;
+		uint8_t bitmap[MAX_PAGES * PAGE_COLUMNS];
+		uint8_t unpacked[MAX_PAGES * PAGE_COLUMNS];
+		uint8_t unpacked_pages;
+		packed_t packed;
+		size_t size;
+		unsigned pages;
+
+		snprintf(name, sizeof(name), "%s", argv[arg]);
+		colon = strchr(name, ':');
+		if (colon) {
+			*colon = '\0';
+		}
+
+		size = find_bitmap(source, name, bitmap, sizeof(bitmap));
+		if (size == 0 || size % PAGE_COLUMNS != 0) {
+			fprintf(stderr, "imgpack: %s not found or not whole pages\n", name);
+			return 1;
+		}
+
+		pages = size / PAGE_COLUMNS;
+		if (colon) {
+			pages = (unsigned)atoi(colon + 1);
+			if (pages == 0 || pages > size / PAGE_COLUMNS) {
+				fprintf(stderr, "imgpack: %s has no %s pages\n", name, colon + 1);
+				return 1;
+			}
+		}
+
+		pack(bitmap, (uint8_t)pages, &packed);
+
+		if (!unpack(&packed, unpacked, &unpacked_pages) || unpacked_pages != pages
+			|| memcmp(bitmap, unpacked, pages * PAGE_COLUMNS) != 0) {
+			fprintf(stderr, "imgpack: %s does not unpack to the bitmap\n", name);
+			return 1;
+		}
+
+		write_array(c, name, &packed, (uint8_t)pages, pages * PAGE_COLUMNS);
+		fprintf(h, "extern const uint8_t image_%s[] PROGMEM;\n", name);
+
+		fprintf(stderr, "%-16s %u pages %5u -> %4u bytes\n", name, pages,
+				pages * PAGE_COLUMNS, (unsigned)packed.length);
+		total_bitmap += pages * PAGE_COLUMNS;
+		total_packed += packed.length;
+	}
+
+	fprintf(h, "\n#endif /* IMAGES_H_ */\n");
+	fprintf(stderr, "%-16s         %5u -> %4u bytes\n", "total",
+			(unsigned)total_bitmap, (unsigned)total_packed);
+
+	fclose(c);
+	fclose(h);
+	free(source);
+
+	return 0;
+}
+
+
+
+/******************************************************************************
+	This function reads a whole file into a zero terminated string.
+
+	Inputs:		const char *path
+	Outputs:	char *, NULL if the file cannot be read
+	Calls:		none
+******************************************************************************/
+static char *read_file(const char *path) {
+	FILE *f = fopen(path, "rb");
+	char *text;
+	size_t length;
+
+	if (!f) {
+		return NULL;
+	}
+
+	text = malloc(MAX_SOURCE + 1);
+	length = fread(text, 1, MAX_SOURCE, f);
+	text[length] = '\0';
+	fclose(f);
+
+	return text;
+}
+
+
+
+/******************************************************************************
+	This function finds the initializer of array "name" in the source and
+	parses its numbers, nested braces are flattened.
+
+	Inputs:		const char *source, const char *name, size_t max
+	Outputs:	size_t, number of bytes in bitmap, 0 if not found
+	Calls:		none
+******************************************************************************/
+static size_t find_bitmap(const char *source, const char *name,
+						  uint8_t *bitmap, size_t max) {
+	const char *p = source;
+	size_t length = strlen(name);
+	size_t count = 0;
+	int depth = 0;
+
+	//the name followed by '[' and preceded by a space
+	while ((p = strstr(p, name)) != NULL) {
+		if (p > source && isspace((unsigned char)p[-1]) && p[length] == '[') {
+			break;
+		}
+		p += length;
+	}
+
+	if (!p || !(p = strchr(p, '{'))) {
+		return 0;
+	}
+
+	for (; *p; p++) {
+		if (*p == '{') {
+			depth++;
+		} else if (*p == '}') {
+			if (--depth == 0) {
+				break;
+			}
+		} else if (*p == '/' && p[1] == '/') {
+			p = strchr(p, '\n');
+			if (!p) {
+				break;
+			}
+		} else if (isdigit((unsigned char)*p)) {
+			char *end;
+			unsigned long value = strtoul(p, &end, 0);
+
+			if (count == max || value > 0xFF) {
+				return 0;
+			}
+			bitmap[count++] = (uint8_t)value;
+			p = end - 1;
+		}
+	}
+
+	return count;
+}
+
+
+
+/******************************************************************************
+	This function packs the first pages of a bitmap.
+
+	Inputs:		const uint8_t *bitmap, uint8_t pages
+	Outputs:	packed_t *out
+	Calls:		pack_page()
+******************************************************************************/
+static void pack(const uint8_t *bitmap, uint8_t pages, packed_t *out) {
+	uint8_t page;
+
+	out->length = 0;
+	out->bytes[out->length++] = pages;
+
+	for (page = 0; page < pages; page++) {
+		pack_page(&bitmap[page * PAGE_COLUMNS], out);
+	}
+}
+
+
+
+/******************************************************************************
+	This function packs one page. Zero runs become blank tokens, other runs
+	repeat tokens, everything in between is collected into literals.
+
+	Inputs:		const uint8_t *page
+	Outputs:	packed_t *out
+	Calls:		flush_literal()
+******************************************************************************/
+static void pack_page(const uint8_t *page, packed_t *out) {
+	uint8_t literal[LITERAL_MAX];
+	size_t literal_length = 0;
+	size_t column = 0;
+
+	while (column < PAGE_COLUMNS) {
+		size_t run = 1;
+
+		while (column + run < PAGE_COLUMNS && page[column + run] == page[column]) {
+			run++;
+		}
+
+		if (page[column] == 0 && run >= BLANK_MIN) {
+			literal_length = flush_literal(literal, literal_length, out);
+
+			while (run > 0) {
+				size_t n = run > BLANK_MAX ? BLANK_MAX : run;
+
+				out->bytes[out->length++] = (uint8_t)(TOKEN_BLANK | (n - 1));
+				column += n;
+				run -= n;
+			}
+		} else if (page[column] != 0 && run >= REPEAT_MIN) {
+			literal_length = flush_literal(literal, literal_length, out);
+
+			while (run >= REPEAT_MIN) {
+				size_t n = run > REPEAT_MAX ? REPEAT_MAX : run;
+
+				out->bytes[out->length++] = (uint8_t)(TOKEN_REPEAT | (n - REPEAT_MIN));
+				out->bytes[out->length++] = page[column];
+				column += n;
+				run -= n;
+			}
+		} else {
+			literal[literal_length++] = page[column++];
+
+			if (literal_length == LITERAL_MAX) {
+				literal_length = flush_literal(literal, literal_length, out);
+			}
+		}
+	}
+
+	flush_literal(literal, literal_length, out);
+}
+
+
+
+/******************************************************************************
+	This function writes the collected literal bytes, if any.
+
+	Inputs:		const uint8_t *literal, size_t length
+	Outputs:	packed_t *out, size_t, 0 (the new literal length)
+	Calls:		none
+******************************************************************************/
+static size_t flush_literal(const uint8_t *literal, size_t length, packed_t *out) {
+	if (length > 0) {
+		out->bytes[out->length++] = (uint8_t)(TOKEN_LITERAL | (length - 1));
+		memcpy(&out->bytes[out->length], literal, length);
+		out->length += length;
+	}
+
+	return 0;
+}
+
+
+
+/******************************************************************************
+	This function unpacks a packed image, the same way the firmware decoder
+	walks it, to check the packer.
+
+	Inputs:		const packed_t *in
+	Outputs:	uint8_t *bitmap, uint8_t *pages, int, 1 if valid
+	Calls:		none
+******************************************************************************/
+static int unpack(const packed_t *in, uint8_t *bitmap, uint8_t *pages) {
+	size_t i = 1;
+	uint8_t page;
+
+	*pages = in->bytes[0];
+
+	for (page = 0; page < *pages; page++) {
+		size_t column = 0;
+
+		while (column < PAGE_COLUMNS) {
+			uint8_t token = in->bytes[i++];
+			size_t n;
+
+			switch (token & TOKEN_TYPE_MASK) {
+				case TOKEN_BLANK:
+					n = (token & 0x3F) + 1;
+					if (column + n > PAGE_COLUMNS) {
+						return 0;
+					}
+					memset(&bitmap[page * PAGE_COLUMNS + column], 0, n);
+					break;
+
+				case TOKEN_REPEAT:
+					n = (token & 0x3F) + REPEAT_MIN;
+					if (column + n > PAGE_COLUMNS) {
+						return 0;
+					}
+					memset(&bitmap[page * PAGE_COLUMNS + column], in->bytes[i++], n);
+					break;
+
+				default:
+					n = token + 1;
+					if (column + n > PAGE_COLUMNS) {
+						return 0;
+					}
+					memcpy(&bitmap[page * PAGE_COLUMNS + column], &in->bytes[i], n);
+					i += n;
+					break;
+			}
+
+			column += n;
+		}
+	}
+
+	return i == in->length;
+}
+
+
+
+/******************************************************************************
+	This function writes one packed image as a PROGMEM array.
+
+	Inputs:		FILE *c, const char *name, const packed_t *packed,
+				uint8_t pages, size_t bitmap_size
+	Outputs:	none
+	Calls:		none
+******************************************************************************/
+static void write_array(FILE *c, const char *name, const packed_t *packed,
+						uint8_t pages, size_t bitmap_size) {
+	size_t i;
+
+	fprintf(c, "\n//%s, %u pages, %u bytes packed to %u\n", name, pages,
+			(unsigned)bitmap_size, (unsigned)packed->length);
+	fprintf(c, "const uint8_t image_%s[] PROGMEM = {", name);
+
+	for (i = 0; i < packed->length; i++) {
+		fprintf(c, "%s0x%02X%s", i % 16 == 0 ? "\n\t" : "", packed->bytes[i],
+				i + 1 < packed->length ? (i % 16 == 15 ? "," : ", ") : "");
+	}
+
+	fprintf(c, "\n};\n");
+}
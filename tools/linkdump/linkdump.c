@@ -0,0 +1,176 @@
+/******************************************************************************
+	LINK DUMP
+
+	Host tool that prints the events and messages of a capture of the link
+	(see Common/link/link.h) as text, one per line:
+
+		event character
+		status left right flags distance_cm accel_peak
+		sram data_bss painted least_free	(bytes, see Common/sram/sram.h)
+		timing iterations histogram longest_us section latency_max_us
+			latency_mean_us					(see Common/timing/timing.h)
+
+	The histogram is the share of the iterations in percent per period
+	bucket, "<256:12.5" for 12.5 % shorter than 256 us.
+
+	Trace and profile messages are counted, tools/trace/tracedump and
+	tools/profile/profiletable print them. Frames with a wrong length or
+	checksum are counted as broken. Reading the serial port of a ZigBee
+	module while the SRAM usage is requested:
+
+		stty -F /dev/ttyUSB0 9600 raw && cat /dev/ttyUSB0 | linkdump &
+		printf '\3\3\3\3' > /dev/ttyUSB0
+
+	Usage:
+		linkdump [capture]			(stdin without a capture)
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "../../Common/link/link.h"
+#include "../../Common/sram/sram.h"
+#include "../../Common/timing/timing.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static void print_frame(const link_parser_t *parser);
+static void print_timing(const uint8_t *payload);
+static const char *timing_section_name(uint8_t id);
+static unsigned read_u16(const uint8_t *bytes);
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static unsigned long traces = 0;
+static unsigned long profiles = 0;
+static unsigned long others = 0;
+
+
+
+/******************************************************************************
+	MAIN FUNCTION
+******************************************************************************/
+int main(int argc, char *argv[]) {
+	const char *path = argc > 1 ? argv[1] : "-";
+	link_parser_t parser = { 0 };
+	unsigned long broken = 0;
+	FILE *file;
+	int c;
+
+	if (argc > 2) {
+		fprintf(stderr, "usage: %s [capture]\n", argv[0]);
+		return 2;
+	}
+	file = strcmp(path, "-") ? fopen(path, "rb") : stdin;
+	if (!file) {
+		fprintf(stderr, "%s: %s: %s\n", argv[0], path, strerror(errno));
+		return 2;
+	}
+
+	setvbuf(stdout, NULL, _IOLBF, 0);
+	while ((c = getc(file)) != EOF) {
+		switch (link_parse(&parser, c)) {
+			case LINK_PARSE_IDLE:
+				if (c >= '0' && c <= '3') {
+					printf("event %c\n", c);
+				}
+				break;
+			case LINK_PARSE_FRAME:
+				print_frame(&parser);
+				break;
+			case LINK_PARSE_ERROR:
+				broken++;
+				break;
+		}
+	}
+	if (file != stdin) {
+		fclose(file);
+	}
+
+	fprintf(stderr, "%lu trace, %lu profile, %lu other messages, %lu broken\n",
+			traces, profiles, others, broken);
+	return 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+static void print_frame(const link_parser_t *parser) {
+	link_status_t status;
+
+	if (link_decode_status(parser, &status)) {
+		printf("status %u %u 0x%02X %u %u\n", status.left_pwm, status.right_pwm,
+			   status.flags, status.distance_cm, status.accel_peak);
+		return;
+	}
+
+	switch (parser->type) {
+		case LINK_TYPE_SRAM:
+			if (parser->length == SRAM_REPORT_LENGTH) {
+				printf("sram %u %u %u\n", read_u16(&parser->payload[0]),
+					   read_u16(&parser->payload[2]), read_u16(&parser->payload[4]));
+			} else {
+				others++;
+			}
+			break;
+		case LINK_TYPE_TIMING:
+			if (parser->length == TIMING_REPORT_LENGTH) {
+				print_timing(parser->payload);
+			} else {
+				others++;
+			}
+			break;
+		case LINK_TYPE_TRACE:
+			traces++;
+			break;
+		case LINK_TYPE_PROFILE:
+		case LINK_TYPE_PROFILE_END:
+			profiles++;
+			break;
+		default:
+			others++;
+			break;
+	}
+}
+/*****************************************************************************/
+
+static void print_timing(const uint8_t *payload) {
+	printf("timing %u", read_u16(&payload[0]));
+	for (int i = 0; i < TIMING_BUCKETS; i++) {
+		if (i < TIMING_BUCKETS - 1) {
+			printf(" <%d:%.1f", TIMING_BUCKET_US << i, payload[2 + i] * 100.0 / 255);
+		} else {
+			printf(" >=%d:%.1f", TIMING_BUCKET_US << (i - 1), payload[2 + i] * 100.0 / 255);
+		}
+	}
+	printf(" %lu %s %u %.2f\n", 4ul * read_u16(&payload[10]), timing_section_name(payload[12]),
+		   4u * payload[13], payload[14] * 4.0 / 16);
+}
+/*****************************************************************************/
+
+static const char *timing_section_name(uint8_t id) {
+#define TIMING_SECTION_CASE(symbol, id, string) case id: return string;
+	switch (id) {
+		TIMING_SECTIONS(TIMING_SECTION_CASE)
+		default:
+			return "-";
+	}
+}
+/*****************************************************************************/
+
+static unsigned read_u16(const uint8_t *bytes) {
+	return bytes[0] | bytes[1] << 8;
+}
+/*****************************************************************************/
@@ -0,0 +1,487 @@
+/******************************************************************************
+	LINK EMULATOR
+
+	Host tool that runs the host builds of both firmwares (remote_host and
+	robot_host) end to end, connected through an emulated ZigBee link
+	instead of the radio. Both programs run in lockstep with
+	HAL_HOST_LOCKSTEP (see hal_host.h): the simulated time of both
+	advances in slices, and the bytes between them pass the link model in
+	simulated time, so a run is deterministic for a seed.
+
+	Link model, the same for both directions:
+		- Baud rate pacing: a byte occupies the line for 10 bits (8N1),
+		  bytes sent faster wait for the line.
+		- Latency and jitter: a byte arrives latency + 0..jitter after it
+		  left the line, never before the byte ahead of it.
+		- Loss and corruption: a byte is dropped or gets one bit flipped
+		  with the given probabilities.
+
+	The joystick of the Remote is moved to a new position every step
+	interval after the warm-up (the Remote shows its intro pictures
+	first). The stick-to-PWM latency is the time from a stick step to the
+	first change of a motor PWM (OCR0A/OCR0B) of the Robot. Its
+	percentiles, steps without a response and the link statistics are
+	printed at the end. Delivered bytes are handed to the receiver of the
+	firmware, which loses them when its buffer is full (data overrun),
+	like the AVR.
+
+	Usage:
+		linkemu [-m ms] [-w ms] [-i ms] [-s us] [-b baud] [-l ms] [-j ms]
+				[-p percent] [-c percent] [-r seed] remote_host robot_host
+
+		-m ms		simulated time, default 30000 ms
+		-w ms		warm-up before the first stick step, default 7000 ms
+		-i ms		stick step interval, default 500 ms
+		-s us		lockstep slice, default 100 us
+		-b baud		link baud rate, default 9600
+		-l ms		link latency, default 0 ms
+		-j ms		link jitter, default 0 ms
+		-p percent	byte loss, default 0 %
+		-c percent	byte corruption, default 0 %
+		-r seed		seed of the stick steps and the link faults, default 1
+
+	Example (from the build directory):
+		linkemu -l 15 -j 10 -p 1 ./remote_host ./robot_host
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define F_CPU 16000000UL
+#define CYCLES_PER_US (F_CPU / 1000000)
+#define CYCLES_PER_MS (F_CPU / 1000)
+
+//Lockstep records of Common/hal/hal_host.h
+#define LOCKSTEP_RUN	'T'
+#define LOCKSTEP_USART	'U'
+#define LOCKSTEP_ADC	'A'
+#define LOCKSTEP_DONE	'D'
+#define LOCKSTEP_PWM	'P'
+
+//Joystick of the Remote: X on ADC1, Y on ADC0, 10 bit
+#define JOYSTICK_X_CHANNEL 1
+#define JOYSTICK_Y_CHANNEL 0
+#define JOYSTICK_CENTER 512
+
+//Motor PWM of the Robot, timer 0 channels A (right) and B (left)
+#define MOTOR_TIMER 0
+
+#define LINK_QUEUE_SIZE 4096
+#define MAX_STEPS 4096
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	pid_t pid;
+	FILE *in;					//records to the program
+	FILE *out;					//records from the program
+	const char *name;
+} program_t;
+
+typedef struct {
+	const char *name;
+	uint64_t line_free;			//cycles when the line is free
+	uint64_t last_arrival;
+	uint64_t arrival[LINK_QUEUE_SIZE];
+	uint8_t data[LINK_QUEUE_SIZE];
+	uint16_t head;
+	uint16_t count;
+	uint32_t sent;
+	uint32_t lost;
+	uint32_t corrupted;
+	uint32_t overflows;
+	uint32_t delivered;
+} link_t;
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static void start_program(program_t *program, const char *path);
+static void stop_program(program_t *program);
+static void run_slice(program_t *program, uint64_t now, uint32_t cycles, link_t *link);
+static uint8_t read_bytes(program_t *program, uint8_t *data, uint8_t length);
+
+static void link_send(link_t *link, uint64_t at, uint8_t byte);
+static void link_deliver(link_t *link, program_t *program, uint64_t now);
+
+static void move_stick(program_t *remote, uint64_t now);
+static void set_adc(program_t *program, uint8_t channel, uint16_t value);
+static void pwm_changed(uint64_t at);
+
+static void print_link(const link_t *link);
+static void print_latencies(void);
+static int compare_cycles(const void *a, const void *b);
+static double random_unit(void);
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static uint64_t byte_cycles;
+static uint64_t latency;
+static uint64_t jitter;
+static double loss;
+static double corruption;
+static uint32_t seed = 1;
+
+static link_t to_robot = { "remote -> robot" };
+static link_t to_remote = { "robot -> remote" };
+
+//Stick positions, X and Y, stepped through in random order
+static const uint16_t STICK_POSITIONS[][2] = {
+	{ 512, 512 }, { 512, 1023 }, { 512, 0 }, { 0, 512 }, { 1023, 512 },
+	{ 512, 800 }, { 512, 200 }, { 200, 1023 }, { 800, 1023 }, { 1023, 0 }
+};
+#define STICK_POSITION_COUNT (sizeof(STICK_POSITIONS) / sizeof(STICK_POSITIONS[0]))
+
+static uint8_t stick_position = 0;
+static uint64_t step_at = 0;
+static uint8_t step_open = 0;			//no PWM change since the step
+static uint64_t latencies[MAX_STEPS];
+static uint32_t latency_count = 0;
+static uint32_t steps = 0;
+
+
+
+/******************************************************************************
+	MAIN FUNCTION
+******************************************************************************/
+int main(int argc, char *argv[]) {
+	uint32_t run_ms = 30000;
+	uint32_t warm_up_ms = 7000;
+	uint32_t interval_ms = 500;
+	uint32_t slice_us = 100;
+	uint32_t baud = 9600;
+	double latency_ms = 0;
+	double jitter_ms = 0;
+	program_t remote = { .name = "remote" };
+	program_t robot = { .name = "robot" };
+	uint64_t now = 0;
+	uint64_t next_step;
+	uint32_t slice;
+	int option;
+
+	while ((option = getopt(argc, argv, "m:w:i:s:b:l:j:p:c:r:")) != -1) {
+		switch (option) {
+			case 'm': run_ms = strtoul(optarg, NULL, 10); break;
+			case 'w': warm_up_ms = strtoul(optarg, NULL, 10); break;
+			case 'i': interval_ms = strtoul(optarg, NULL, 10); break;
+			case 's': slice_us = strtoul(optarg, NULL, 10); break;
+			case 'b': baud = strtoul(optarg, NULL, 10); break;
+			case 'l': latency_ms = atof(optarg); break;
+			case 'j': jitter_ms = atof(optarg); break;
+			case 'p': loss = atof(optarg) / 100; break;
+			case 'c': corruption = atof(optarg) / 100; break;
+			case 'r': seed = strtoul(optarg, NULL, 10); break;
+			default:
+				fprintf(stderr, "usage: %s [-m ms] [-w ms] [-i ms] [-s us] [-b baud] [-l ms] "
+						"[-j ms] [-p percent] [-c percent] [-r seed] remote_host robot_host\n",
+						argv[0]);
+				return 2;
+		}
+	}
+	if (argc - optind != 2 || !slice_us || !baud || !interval_ms) {
+		fprintf(stderr, "%s: give remote_host and robot_host, see the usage\n", argv[0]);
+		return 2;
+	}
+	if (!seed) {
+		seed = 1;
+	}
+
+	byte_cycles = 10 * F_CPU / baud;
+	latency = latency_ms * CYCLES_PER_MS;
+	jitter = jitter_ms * CYCLES_PER_MS;
+	slice = slice_us * CYCLES_PER_US;
+	next_step = (uint64_t)warm_up_ms * CYCLES_PER_MS;
+
+	signal(SIGPIPE, SIG_IGN);
+	start_program(&remote, argv[optind]);
+	start_program(&robot, argv[optind + 1]);
+
+	while (now < (uint64_t)run_ms * CYCLES_PER_MS) {
+		if (now >= next_step) {
+			move_stick(&remote, now);
+			next_step += (uint64_t)interval_ms * CYCLES_PER_MS;
+		}
+		link_deliver(&to_robot, &robot, now);
+		link_deliver(&to_remote, &remote, now);
+		run_slice(&remote, now, slice, &to_robot);
+		run_slice(&robot, now, slice, &to_remote);
+		now += slice;
+	}
+
+	stop_program(&remote);
+	stop_program(&robot);
+
+	printf("linkemu: %lu ms simulated, %lu baud, latency %.1f ms, jitter %.1f ms, "
+		   "loss %.1f %%, corruption %.1f %%\n", (unsigned long)run_ms, (unsigned long)baud,
+		   latency_ms, jitter_ms, loss * 100, corruption * 100);
+	print_link(&to_robot);
+	print_link(&to_remote);
+	print_latencies();
+	return 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PROGRAMS
+	A firmware runs as a child process in lockstep, the first 'D' says it
+	is ready for the first slice.
+******************************************************************************/
+static void start_program(program_t *program, const char *path) {
+	int to_program[2];
+	int from_program[2];
+	uint8_t ready;
+
+	if (pipe(to_program) || pipe(from_program)) {
+		perror("pipe");
+		exit(1);
+	}
+
+	program->pid = fork();
+	if (program->pid < 0) {
+		perror("fork");
+		exit(1);
+	}
+	if (program->pid == 0) {
+		dup2(to_program[0], STDIN_FILENO);
+		dup2(from_program[1], STDOUT_FILENO);
+		close(to_program[0]);
+		close(to_program[1]);
+		close(from_program[0]);
+		close(from_program[1]);
+		setenv("HAL_HOST_LOCKSTEP", "1", 1);
+		unsetenv("HAL_HOST_RUN_MS");
+		execl(path, path, (char *)NULL);
+		perror(path);
+		_exit(127);
+	}
+
+	//the next program must not keep this one's stdin open
+	close(to_program[0]);
+	close(from_program[1]);
+	fcntl(to_program[1], F_SETFD, FD_CLOEXEC);
+	fcntl(from_program[0], F_SETFD, FD_CLOEXEC);
+	program->in = fdopen(to_program[1], "w");
+	program->out = fdopen(from_program[0], "r");
+
+	if (!read_bytes(program, &ready, 1) || ready != LOCKSTEP_DONE) {
+		fprintf(stderr, "linkemu: %s did not start in lockstep\n", program->name);
+		exit(1);
+	}
+}
+
+static void stop_program(program_t *program) {
+	fclose(program->in);		//end of stdin ends the simulation
+	fclose(program->out);
+	waitpid(program->pid, NULL, 0);
+}
+
+/******************************************************************************
+	Runs the slice from now of a program and takes what it did:
+	transmitted bytes go to link, PWM changes of the Robot end a stick
+	step. A record outside the slice means the program did not run the
+	slices it was given, the run is stopped.
+******************************************************************************/
+static void run_slice(program_t *program, uint64_t now, uint32_t cycles, link_t *link) {
+	uint8_t record[5] = { LOCKSTEP_RUN, cycles, cycles >> 8, cycles >> 16, cycles >> 24 };
+	uint8_t type;
+	uint8_t at_bytes[8];
+	uint8_t data[3];
+	uint64_t at;
+
+	fwrite(record, 1, 5, program->in);
+	fflush(program->in);
+
+	while (read_bytes(program, &type, 1) && type != LOCKSTEP_DONE) {
+		if ((type != LOCKSTEP_USART && type != LOCKSTEP_PWM) || !read_bytes(program, at_bytes, 8)) {
+			fprintf(stderr, "linkemu: bad record 0x%02X from %s\n", type, program->name);
+			exit(1);
+		}
+		at = 0;
+		for (uint8_t i = 0; i < 8; i++) {
+			at |= (uint64_t)at_bytes[i] << (8 * i);
+		}
+		if (at < now || at > now + cycles) {
+			fprintf(stderr, "linkemu: %s record at %llu cycles, slice %llu..%llu\n", program->name,
+					(unsigned long long)at, (unsigned long long)now,
+					(unsigned long long)(now + cycles));
+			exit(1);
+		}
+
+		if (type == LOCKSTEP_USART) {
+			if (read_bytes(program, data, 1)) {
+				link_send(link, at, data[0]);
+			}
+		} else if (read_bytes(program, data, 3) && data[0] == MOTOR_TIMER && link == &to_remote) {
+			pwm_changed(at);
+		}
+	}
+}
+
+static uint8_t read_bytes(program_t *program, uint8_t *data, uint8_t length) {
+	if (fread(data, 1, length, program->out) != length) {
+		fprintf(stderr, "linkemu: %s stopped\n", program->name);
+		exit(1);
+	}
+	return 1;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	LINK
+******************************************************************************/
+static void link_send(link_t *link, uint64_t at, uint8_t byte) {
+	uint64_t arrival;
+
+	link->sent++;
+	link->line_free = (at > link->line_free ? at : link->line_free) + byte_cycles;
+
+	if (random_unit() < loss) {
+		link->lost++;
+		return;
+	}
+	if (random_unit() < corruption) {
+		byte ^= 1 << (uint8_t)(random_unit() * 8);
+		link->corrupted++;
+	}
+	if (link->count == LINK_QUEUE_SIZE) {
+		link->overflows++;
+		return;
+	}
+
+	arrival = link->line_free + latency + (uint64_t)(random_unit() * jitter);
+	if (arrival < link->last_arrival) {
+		arrival = link->last_arrival;
+	}
+	link->last_arrival = arrival;
+
+	link->arrival[(link->head + link->count) % LINK_QUEUE_SIZE] = arrival;
+	link->data[(link->head + link->count) % LINK_QUEUE_SIZE] = byte;
+	link->count++;
+}
+
+/******************************************************************************
+	Hands the bytes that have arrived to the receiving program, before its
+	next slice.
+******************************************************************************/
+static void link_deliver(link_t *link, program_t *program, uint64_t now) {
+	while (link->count && link->arrival[link->head] <= now) {
+		fputc(LOCKSTEP_USART, program->in);
+		fputc(link->data[link->head], program->in);
+		link->head = (link->head + 1) % LINK_QUEUE_SIZE;
+		link->count--;
+		link->delivered++;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	JOYSTICK AND LATENCY
+******************************************************************************/
+static void move_stick(program_t *remote, uint64_t now) {
+	uint8_t next;
+
+	do {
+		next = random_unit() * STICK_POSITION_COUNT;
+	} while (next == stick_position);
+	stick_position = next;
+
+	set_adc(remote, JOYSTICK_X_CHANNEL, STICK_POSITIONS[next][0]);
+	set_adc(remote, JOYSTICK_Y_CHANNEL, STICK_POSITIONS[next][1]);
+
+	steps++;
+	step_at = now;
+	step_open = 1;
+}
+
+static void set_adc(program_t *program, uint8_t channel, uint16_t value) {
+	uint8_t record[4] = { LOCKSTEP_ADC, channel, value & 0xFF, value >> 8 };
+
+	fwrite(record, 1, 4, program->in);
+}
+
+static void pwm_changed(uint64_t at) {
+	if (step_open && at >= step_at && latency_count < MAX_STEPS) {
+		latencies[latency_count++] = at - step_at;
+		step_open = 0;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	REPORT
+******************************************************************************/
+static void print_link(const link_t *link) {
+	printf("  %s: %lu sent, %lu lost, %lu corrupted, %lu delivered, %lu queue overflows\n",
+		   link->name, (unsigned long)link->sent, (unsigned long)link->lost,
+		   (unsigned long)link->corrupted, (unsigned long)link->delivered,
+		   (unsigned long)link->overflows);
+}
+
+static void print_latencies(void) {
+	static const uint8_t PERCENTILES[] = { 50, 90, 99, 100 };
+
+	printf("  stick steps: %lu, without PWM response: %lu\n",
+		   (unsigned long)steps, (unsigned long)(steps - latency_count));
+	if (!latency_count) {
+		return;
+	}
+
+	qsort(latencies, latency_count, sizeof(latencies[0]), compare_cycles);
+	printf("  stick-to-PWM latency:");
+	for (uint8_t i = 0; i < sizeof(PERCENTILES); i++) {
+		uint32_t index = (PERCENTILES[i] * latency_count + 99) / 100;
+
+		printf(" p%u %.2f ms%s", PERCENTILES[i],
+			   (double)latencies[index ? index - 1 : 0] / CYCLES_PER_MS,
+			   i + 1 < sizeof(PERCENTILES) ? "," : "\n");
+	}
+}
+
+static int compare_cycles(const void *a, const void *b) {
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/******************************************************************************
+	Uniform in 0..1 (xorshift32), the same sequence for the same seed.
+******************************************************************************/
+static double random_unit(void) {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return (double)seed / ((double)UINT32_MAX + 1);
+}
+/*****************************************************************************/
@@ -0,0 +1,205 @@
+/******************************************************************************
+	JOYSTICK MAPPER HARNESS
+
+	Host harness of the joystick to motor byte mapping of the Remote,
+	output_byte_creator_create() with the calibration of joystick.h
+	(X_ZERO, Y_ZERO, ZERO_OFFSET, the ranges of calc_x_range() and
+	calc_y_range()). The firmware sources run unchanged on the host.
+
+	Golden vectors: every joystick input, y 0..255 (outer) and x 0..255,
+	is mapped for the left and then the right motor, 131072 calls in this
+	order from the state after output_byte_creator_init(). The order is
+	part of the vectors, the direction bit of a byte with y in the dead
+	zone is the one of the call before. One line per y:
+
+		yy ll rr ll rr ...		(hex, the left and the right byte per x)
+
+	The host computes with the double constants of the sources where
+	avr-gcc has 32-bit doubles, the vectors are the same with
+	-fsingle-precision-constant, so they are those of the firmware.
+
+	tools/mapper/golden.txt holds the vectors of the current mapping, a
+	faster mapping is bit-exact if "mapper -c" passes, a deliberate change
+	of the driving feel writes new vectors with "mapper -w" and commits
+	them with the change.
+
+	Benchmark: maps all inputs again and again for the given wall clock
+	time and prints the calls per second of the host. The cycles of the
+	ATmega328P are measured by bench_sim (BENCH_OUTPUT_BYTE_CREATOR_CREATE,
+	tools/benchsim).
+
+	Usage:
+		mapper -w golden.txt		write the golden vectors
+		mapper -c golden.txt		compare, exit status 1 if a byte differs
+		mapper -b ms				benchmark, e.g. 2000
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "../../Remote/joystick.h"
+#include "../../Remote/output_byte_creator.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define INPUTS 256
+
+//Mismatches printed by a check
+#define CHECK_PRINT_MAX 20
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static void map_all(uint8_t result[INPUTS][INPUTS][2]);
+static int write_vectors(const char *path);
+static int check_vectors(const char *path);
+static void benchmark(long ms);
+static double seconds(void);
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static uint8_t vectors[INPUTS][INPUTS][2];		//[y][x][left, right]
+
+
+
+/******************************************************************************
+	MAIN FUNCTION
+******************************************************************************/
+int main(int argc, char *argv[]) {
+	int option;
+
+	joystick_init();
+	output_byte_creator_init();
+
+	while ((option = getopt(argc, argv, "w:c:b:")) != -1) {
+		switch (option) {
+			case 'w':
+				return write_vectors(optarg);
+			case 'c':
+				return check_vectors(optarg);
+			case 'b':
+				benchmark(atol(optarg));
+				return 0;
+			default:
+				break;
+		}
+	}
+	fprintf(stderr, "usage: %s -w golden | -c golden | -b ms\n", argv[0]);
+	return 2;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+static void map_all(uint8_t result[INPUTS][INPUTS][2]) {
+	for (int y = 0; y < INPUTS; y++) {
+		for (int x = 0; x < INPUTS; x++) {
+			uint8_t joystick_x = x;
+			uint8_t joystick_y = y;
+
+			result[y][x][0] = output_byte_creator_create(&joystick_x, &joystick_y, 'L');
+			result[y][x][1] = output_byte_creator_create(&joystick_x, &joystick_y, 'R');
+		}
+	}
+}
+/*****************************************************************************/
+
+static int write_vectors(const char *path) {
+	FILE *file = fopen(path, "w");
+
+	if (!file) {
+		fprintf(stderr, "mapper: %s: %s\n", path, strerror(errno));
+		return 2;
+	}
+
+	map_all(vectors);
+	for (int y = 0; y < INPUTS; y++) {
+		fprintf(file, "%02x", y);
+		for (int x = 0; x < INPUTS; x++) {
+			fprintf(file, " %02x %02x", vectors[y][x][0], vectors[y][x][1]);
+		}
+		fprintf(file, "\n");
+	}
+	fclose(file);
+	return 0;
+}
+/*****************************************************************************/
+
+static int check_vectors(const char *path) {
+	FILE *file = fopen(path, "r");
+	unsigned golden;
+	unsigned row;
+	long differences = 0;
+
+	if (!file) {
+		fprintf(stderr, "mapper: %s: %s\n", path, strerror(errno));
+		return 2;
+	}
+
+	map_all(vectors);
+	for (int y = 0; y < INPUTS; y++) {
+		if (fscanf(file, "%x", &row) != 1 || row != (unsigned)y) {
+			fprintf(stderr, "mapper: %s: row %02x missing\n", path, y);
+			fclose(file);
+			return 2;
+		}
+		for (int x = 0; x < INPUTS; x++) {
+			for (int motor = 0; motor < 2; motor++) {
+				if (fscanf(file, "%x", &golden) != 1) {
+					fprintf(stderr, "mapper: %s: row %02x short\n", path, y);
+					fclose(file);
+					return 2;
+				}
+				if (golden != vectors[y][x][motor] && differences++ < CHECK_PRINT_MAX) {
+					printf("x %3d y %3d %c: 0x%02X, golden 0x%02X\n", x, y, motor ? 'R' : 'L',
+						   vectors[y][x][motor], golden);
+				}
+			}
+		}
+	}
+	fclose(file);
+
+	printf("%d inputs, %ld bytes differ from %s\n", INPUTS * INPUTS, differences, path);
+	return differences ? 1 : 0;
+}
+/*****************************************************************************/
+
+static void benchmark(long ms) {
+	double start = seconds();
+	double elapsed;
+	unsigned long calls = 0;
+
+	do {
+		map_all(vectors);
+		calls += 2 * INPUTS * INPUTS;
+		elapsed = seconds() - start;
+	} while (elapsed * 1000 < ms);
+
+	printf("%lu calls in %.3f s, %.0f calls/s\n", calls, elapsed, calls / elapsed);
+}
+/*****************************************************************************/
+
+static double seconds(void) {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+/*****************************************************************************/
@@ -0,0 +1,198 @@
+/******************************************************************************
+	PROFILE TABLE
+
+	Host tool that turns the profile windows of a capture into a table per
+	section of Common/profile/profile.h. A capture is the raw byte stream
+	transmitted by a firmware built with PROFILE_RECORDING, e.g. read from
+	the serial port of a ZigBee module while the drain is requested:
+
+		stty -F /dev/ttyUSB0 9600 raw && cat /dev/ttyUSB0 > drive.profile &
+		printf '\2\2\2\2' > /dev/ttyUSB0
+
+	The begin and end events of a section are paired within a window, an
+	end without a begin (the section started before the window) and a
+	begin without an end (the window was full) are not counted. The
+	durations are printed in micros:
+
+		section  count  min  mean  p50  p90  p99  max
+
+	Usage:
+		profiletable [capture]			(stdin without a capture)
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "../../Common/link/link.h"
+#include "../../Common/profile/profile.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define SECTION_IDS PROFILE_END_FLAG
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	const char *name;
+	uint32_t *durations;		//micros
+	size_t count;
+	size_t capacity;
+	uint8_t open;				//a begin is waiting for its end
+	uint16_t begin_ticks;
+} section_t;
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static void add_event(uint8_t marker, uint16_t ticks);
+static void end_window(void);
+static void add_duration(section_t *section, uint32_t micros);
+static void print_section(const section_t *section);
+static int compare_durations(const void *a, const void *b);
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static section_t sections[SECTION_IDS];
+
+
+
+/******************************************************************************
+	MAIN FUNCTION
+******************************************************************************/
+int main(int argc, char *argv[]) {
+	const char *path = argc > 1 ? argv[1] : "-";
+	link_parser_t parser = { 0 };
+	unsigned long windows = 0;
+	unsigned long dropped = 0;
+	FILE *file;
+	int c;
+
+	if (argc > 2) {
+		fprintf(stderr, "usage: %s [capture]\n", argv[0]);
+		return 2;
+	}
+	file = strcmp(path, "-") ? fopen(path, "rb") : stdin;
+	if (!file) {
+		fprintf(stderr, "%s: %s: %s\n", argv[0], path, strerror(errno));
+		return 2;
+	}
+
+#define PROFILE_SECTION_NAME(symbol, id, string) sections[id].name = string;
+	PROFILE_SECTIONS(PROFILE_SECTION_NAME)
+
+	while ((c = getc(file)) != EOF) {
+		if (link_parse(&parser, c) != LINK_PARSE_FRAME) {
+			continue;
+		}
+		if (parser.type == LINK_TYPE_PROFILE) {
+			for (uint8_t i = 0; i + PROFILE_EVENT_LENGTH <= parser.length; i += PROFILE_EVENT_LENGTH) {
+				add_event(parser.payload[i], parser.payload[i + 1] | parser.payload[i + 2] << 8);
+			}
+		} else if (parser.type == LINK_TYPE_PROFILE_END && parser.length == 2) {
+			end_window();
+			windows++;
+			dropped += parser.payload[0] | parser.payload[1] << 8;
+		}
+	}
+	if (file != stdin) {
+		fclose(file);
+	}
+
+	printf("%-28s %7s %7s %9s %7s %7s %7s %7s\n",
+		   "section", "count", "min", "mean", "p50", "p90", "p99", "max");
+	for (int id = 0; id < SECTION_IDS; id++) {
+		if (sections[id].count) {
+			print_section(&sections[id]);
+		}
+	}
+	printf("%lu windows, %lu events dropped\n", windows, dropped);
+	return 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+static void add_event(uint8_t marker, uint16_t ticks) {
+	section_t *section = &sections[marker & ~PROFILE_END_FLAG];
+
+	if (!(marker & PROFILE_END_FLAG)) {
+		section->open = 1;
+		section->begin_ticks = ticks;
+	} else if (section->open) {
+		section->open = 0;
+		add_duration(section, (uint32_t)(uint16_t)(ticks - section->begin_ticks) * PROFILE_TICK_US);
+	}
+}
+/*****************************************************************************/
+
+static void end_window(void) {
+	for (int id = 0; id < SECTION_IDS; id++) {
+		sections[id].open = 0;
+	}
+}
+/*****************************************************************************/
+
+static void add_duration(section_t *section, uint32_t micros) {
+	if (section->count == section->capacity) {
+		section->capacity = section->capacity ? 2 * section->capacity : 256;
+		section->durations = realloc(section->durations, section->capacity * sizeof(uint32_t));
+		if (!section->durations) {
+			fprintf(stderr, "profiletable: out of memory\n");
+			exit(2);
+		}
+	}
+	section->durations[section->count++] = micros;
+}
+/*****************************************************************************/
+
+static void print_section(const section_t *section) {
+	const uint32_t *durations = section->durations;
+	size_t count = section->count;
+	uint64_t sum = 0;
+	char unnamed[16];
+	const char *name = section->name;
+
+	qsort(section->durations, count, sizeof(uint32_t), compare_durations);
+	for (size_t i = 0; i < count; i++) {
+		sum += durations[i];
+	}
+	if (!name) {
+		snprintf(unnamed, sizeof(unnamed), "id %d", (int)(section - sections));
+		name = unnamed;
+	}
+
+	//Percentiles by nearest rank
+	printf("%-28s %7zu %7lu %9.1f %7lu %7lu %7lu %7lu\n", name, count,
+		   (unsigned long)durations[0], (double)sum / count,
+		   (unsigned long)durations[(count * 50 + 99) / 100 - 1],
+		   (unsigned long)durations[(count * 90 + 99) / 100 - 1],
+		   (unsigned long)durations[(count * 99 + 99) / 100 - 1],
+		   (unsigned long)durations[count - 1]);
+}
+/*****************************************************************************/
+
+static int compare_durations(const void *a, const void *b) {
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+/*****************************************************************************/
@@ -0,0 +1,793 @@
+/******************************************************************************
+	ROBOT SIMULATOR
+
+	Closed-loop simulation of the RedBot for obstacle and collision
+	scenarios. The robot firmware runs unchanged on the simulated
+	peripherals of the host backend (Common/hal/hal_host.c), this file
+	models the hardware around it:
+		- Motors: differential drive from the PWM of OCR0B (left) and OCR0A
+		  (right) and the direction pins of motors.c. The wheel speeds
+		  follow the PWM with the time constant of the motors.
+		- HC-SR04: after a trigger pulse on PB1 an echo on PD3 of 58 us per
+		  cm to the nearest wall in the sound cone, walls seen at a
+		  flat angle reflect the sound away and are not seen.
+		- MPU6050: accelerometer samples at the configured sample rate
+		  with a data ready pulse on PB2. The samples have the robot's
+		  acceleration with an impact pulse when the robot hits a wall,
+		  through the configured DLPF, and the vibration of the scenario.
+		- Remote: the motor bytes of the scenario every COMMAND_PERIOD_MS,
+		  a collision is confirmed ('1') after the confirm time.
+
+	A scenario is a text file, one directive per line, # starts a comment.
+	Lengths in cm, angles in degrees, times in ms:
+		duration ms				simulated time, default 5000
+		seed n					seed of the vibration noise
+		start x y heading		pose at start, default 0 0 0 (along x)
+		wall x1 y1 x2 y2		wall from (x1, y1) to (x2, y2)
+		box x1 y1 x2 y2			four walls around a rectangle
+		max_speed cm/s			wheel speed at PWM 255, default 50
+		motor_tau ms			time constant of the motors, default 100
+		vibration raw			accelerometer noise amplitude, default 0
+		impact_ms ms			stopping time at an impact, default 5
+		confirm_ms ms			delay of the collision confirm, default 500
+		at ms drive left right	PWM from then on, -252..252, a negative
+								PWM drives backwards (both motors have the
+								same gear on the link)
+		expect metric min max	the run fails if metric is outside
+								min..max
+
+	The run ends after the duration with the metrics on stdout, exit
+	status 1 if an expectation failed:
+		travelled_cm			distance driven
+		min_clearance_cm		smallest gap between robot and walls
+		warnings				obstacle warnings ('2') sent
+		false_warnings			warnings without a wall within
+								WARNING_DISTANCE_CM + FALSE_MARGIN_CM
+		detect_latency_ms		longest time from a wall coming within
+								WARNING_DISTANCE_CM ahead to the warning
+		stop_distance_cm		longest distance driven from a warning to
+								standstill
+		impacts					times the robot hit a wall
+		collision_reports		collisions ('1') sent
+		false_collisions		collisions sent without an impact
+		missed_collisions		impacts without a collision sent
+		collision_latency_ms	longest time from an impact to '1'
+		tip_overs				tip-over events ('3') sent
+	Latencies and distances that were not measured are n/a, they fail an
+	expectation.
+
+	Usage (the scenario is given in the environment, since main() is the
+	firmware's):
+		ROBOTSIM_SCENARIO=tools/robotsim/scenarios/wall_ahead.txt robotsim
+
+	The robotsim_scenarios target of CMakeLists.txt runs all scenarios in
+	tools/robotsim/scenarios.
+
+	ROBOTSIM_CAPTURE saves what the robot transmits to a file. Built with
+	TRACE_RECORDING (the robotsim_trace target) that is a trace capture,
+	which tools/trace/tracereplay replays.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "../../Common/hal/hal.h"
+#include "../../Common/link/link.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define CYCLES_PER_US (F_CPU / 1000000)
+#define CYCLES_PER_MS (F_CPU / 1000)
+
+//Simulation step of the robot's motion
+#define PHYSICS_PERIOD_US 1000
+
+//RedBot geometry, the body is a circle around the middle of the axle
+#define TRACK_CM 15.0
+#define BODY_RADIUS_CM 10.0
+#define SONAR_OFFSET_CM 8.0			//HC-SR04 ahead of the middle
+
+//Motor driver pins of motors.c
+#define L_CTRL_1 (1 << PD2)
+#define L_CTRL_2 (1 << PD4)
+#define R_CTRL_1 (1 << PD7)
+#define R_CTRL_2 (1 << PB0)
+
+//HC-SR04: trigger PB1, echo PD3
+#define SONAR_TRIG (1 << PB1)
+#define SONAR_ECHO (1 << PD3)
+#define SONAR_ECHO_DELAY_US 460		//trigger to echo start
+#define SONAR_US_PER_CM 58			//echo length
+#define SONAR_NO_ECHO_US 38000		//echo length without an obstacle
+#define SONAR_RANGE_CM 400.0
+#define SONAR_HALF_ANGLE 15.0		//sound cone
+#define SONAR_RAYS 7				//rays cast over the cone
+#define SONAR_MAX_INCIDENCE 45.0	//flatter walls are not seen
+
+//MPU6050: data ready PB2, 50 us pulse
+#define MPU6050_INT (1 << PB2)
+#define MPU6050_INT_PULSE_US 50
+#define MPU6050_SMPLRT_DIV 0x19
+#define MPU6050_CONFIG 0x1A
+#define MPU6050_ACCEL_CONFIG 0x1C
+#define MPU6050_INT_ENABLE 0x38
+#define MPU6050_ACCEL_XOUT_H 0x3B
+
+//Accelerometer output of the leveled, still robot (MPU6050_x_ZERO of
+//Robot/main.c), z includes gravity
+#define MPU6050_X_BIAS -350
+#define MPU6050_Y_BIAS -35
+#define MPU6050_Z_BIAS 1930
+
+#define GRAVITY_CM_S2 981.0
+
+//Remote
+#define COMMAND_PERIOD_MS 20
+#define GEAR_SEL_BIT 1
+#define MOTOR_SEL_BIT 0
+
+//DISTANCE_LIMIT of Robot/main.c
+#define WARNING_DISTANCE_CM 30.0
+#define FALSE_MARGIN_CM 10.0
+
+//An impact slower than this is a touch, an impact ends the collision
+//window for the report after COLLISION_WINDOW_MS
+#define IMPACT_MIN_SPEED 2.0
+#define COLLISION_WINDOW_MS 200
+
+#define MAX_WALLS 64
+#define MAX_COMMANDS 64
+#define MAX_EXPECTS 32
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	double x1, y1, x2, y2;
+} wall_t;
+
+typedef struct {
+	uint32_t at_ms;
+	int16_t left;
+	int16_t right;
+} command_t;
+
+typedef struct {
+	char metric[32];
+	double min;
+	double max;
+} expect_t;
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static void start(void) __attribute__((constructor));
+static void load_scenario(const char *path);
+static void add_wall(double x1, double y1, double x2, double y2);
+
+static void physics(void);
+static double wall_distance(double x, double y, double *nx, double *ny);
+static double cast_ray(double x, double y, double angle, uint8_t reflecting);
+static double cone_range(uint8_t reflecting);
+
+static void gpio_changed(uint8_t port);
+static void echo_rise(void);
+static void echo_fall(void);
+
+static void mpu6050_sample(void);
+static void mpu6050_int_end(void);
+static int16_t accel_raw(double bias, double acceleration, double lsb_per_g);
+static double noise(void);
+
+static void send_commands(void);
+static uint8_t command_byte(int16_t pwm, uint8_t left);
+static void robot_transmitted(uint8_t c);
+static void confirm_collision(void);
+
+static void finish(void);
+static uint32_t now_ms(void);
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static const char *scenario_path;
+static uint32_t duration_ms = 5000;
+static uint32_t seed = 1;
+static double max_speed = 50.0;
+static double motor_tau = 0.1;
+static double vibration = 0.0;
+static double impact_time = 0.005;
+static uint32_t confirm_ms = 500;
+
+//Accelerometer bandwidth of the MPU6050 DLPF settings in Hz, 0 = off
+static const uint16_t DLPF_BANDWIDTH[8] = { 260, 184, 94, 44, 21, 10, 5, 0 };
+
+static wall_t walls[MAX_WALLS];
+static uint8_t wall_count = 0;
+static command_t commands[MAX_COMMANDS];
+static uint8_t command_count = 0;
+static expect_t expects[MAX_EXPECTS];
+static uint8_t expect_count = 0;
+
+static struct {
+	double x, y, heading;		//cm, rad
+	double left, right;			//wheel speeds, cm/s
+	double accel;				//along the robot, cm/s^2, through the DLPF
+	double lateral;				//to the left, cm/s^2, through the DLPF
+	uint8_t contact;			//against a wall
+	double impact_x, impact_y;	//impact acceleration, cm/s^2
+	uint64_t impact_until;		//cycles
+} robot;
+
+static struct {
+	uint8_t trig;				//last trigger level
+	uint8_t busy;				//echo pending
+	uint32_t echo_us;
+} sonar;
+
+static link_parser_t parser;
+static FILE *capture;
+
+static struct {
+	double travelled;
+	double min_clearance;
+	uint32_t warnings;
+	uint32_t false_warnings;
+	uint8_t approaching;		//wall within WARNING_DISTANCE_CM ahead
+	uint8_t warned;
+	uint32_t approach_at;
+	double detect_latency;
+	uint8_t stopping;
+	double stop_from;
+	double stop_distance;
+	uint32_t impacts;
+	uint32_t collision_reports;
+	uint32_t false_collisions;
+	uint32_t missed_collisions;
+	uint8_t impact_reported;
+	uint32_t impact_at;
+	double collision_latency;
+	uint32_t tip_overs;
+} metrics;
+
+
+
+/******************************************************************************
+	SET-UP
+	Runs before the firmware's main(), like the simulation's start-up.
+******************************************************************************/
+static void start(void) {
+	scenario_path = getenv("ROBOTSIM_SCENARIO");
+	if (!scenario_path) {
+		fprintf(stderr, "robotsim: set ROBOTSIM_SCENARIO to a scenario file\n");
+		exit(2);
+	}
+	load_scenario(scenario_path);
+	if (getenv("ROBOTSIM_CAPTURE") && !(capture = fopen(getenv("ROBOTSIM_CAPTURE"), "wb"))) {
+		fprintf(stderr, "robotsim: cannot write %s\n", getenv("ROBOTSIM_CAPTURE"));
+		exit(2);
+	}
+
+	metrics.min_clearance = INFINITY;
+	metrics.detect_latency = NAN;
+	metrics.stop_distance = NAN;
+	metrics.collision_latency = NAN;
+
+	hal_host_gpio_set_hook(gpio_changed);
+	hal_host_usart_set_hook(robot_transmitted);
+	hal_host_schedule(PHYSICS_PERIOD_US * CYCLES_PER_US, physics);
+	hal_host_schedule(CYCLES_PER_MS, mpu6050_sample);
+	hal_host_schedule(0, send_commands);
+	hal_host_schedule((uint64_t)duration_ms * CYCLES_PER_MS, finish);
+}
+
+static void load_scenario(const char *path) {
+	FILE *file = fopen(path, "r");
+	char line[256];
+	char word[32];
+	double a, b, c, d;
+	int line_number = 0;
+	int n;
+
+	if (!file) {
+		perror(path);
+		exit(2);
+	}
+
+	while (fgets(line, sizeof(line), file)) {
+		line_number++;
+		if (strchr(line, '#')) {
+			*strchr(line, '#') = '\0';
+		}
+		if (sscanf(line, "%31s%n", word, &n) != 1) {
+			continue;
+		}
+
+		if (!strcmp(word, "duration") && sscanf(line + n, "%lf", &a) == 1) {
+			duration_ms = a;
+		} else if (!strcmp(word, "seed") && sscanf(line + n, "%lf", &a) == 1) {
+			seed = a ? a : 1;
+		} else if (!strcmp(word, "start") && sscanf(line + n, "%lf %lf %lf", &a, &b, &c) == 3) {
+			robot.x = a;
+			robot.y = b;
+			robot.heading = c * M_PI / 180.0;
+		} else if (!strcmp(word, "wall") && sscanf(line + n, "%lf %lf %lf %lf", &a, &b, &c, &d) == 4) {
+			add_wall(a, b, c, d);
+		} else if (!strcmp(word, "box") && sscanf(line + n, "%lf %lf %lf %lf", &a, &b, &c, &d) == 4) {
+			add_wall(a, b, c, b);
+			add_wall(c, b, c, d);
+			add_wall(c, d, a, d);
+			add_wall(a, d, a, b);
+		} else if (!strcmp(word, "max_speed") && sscanf(line + n, "%lf", &a) == 1) {
+			max_speed = a;
+		} else if (!strcmp(word, "motor_tau") && sscanf(line + n, "%lf", &a) == 1 && a > 0) {
+			motor_tau = a / 1000.0;
+		} else if (!strcmp(word, "vibration") && sscanf(line + n, "%lf", &a) == 1) {
+			vibration = a;
+		} else if (!strcmp(word, "impact_ms") && sscanf(line + n, "%lf", &a) == 1 && a > 0) {
+			impact_time = a / 1000.0;
+		} else if (!strcmp(word, "confirm_ms") && sscanf(line + n, "%lf", &a) == 1) {
+			confirm_ms = a;
+		} else if (!strcmp(word, "at") && command_count < MAX_COMMANDS &&
+				   sscanf(line + n, "%lf drive %lf %lf", &a, &b, &c) == 3) {
+			commands[command_count].at_ms = a;
+			commands[command_count].left = b;
+			commands[command_count].right = c;
+			command_count++;
+		} else if (!strcmp(word, "expect") && expect_count < MAX_EXPECTS &&
+				   sscanf(line + n, "%31s %lf %lf", expects[expect_count].metric, &a, &b) == 3) {
+			expects[expect_count].min = a;
+			expects[expect_count].max = b;
+			expect_count++;
+		} else {
+			fprintf(stderr, "robotsim: %s:%d: bad line\n", path, line_number);
+			exit(2);
+		}
+	}
+	fclose(file);
+}
+
+static void add_wall(double x1, double y1, double x2, double y2) {
+	if (wall_count == MAX_WALLS) {
+		fprintf(stderr, "robotsim: more than %d walls\n", MAX_WALLS);
+		exit(2);
+	}
+	walls[wall_count++] = (wall_t){ x1, y1, x2, y2 };
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	MOTION
+	Every PHYSICS_PERIOD_US the wheel speeds approach the speeds set by the
+	motor driver and the robot moves. A move into a wall is not made, the
+	wheels stop and a fast impact gives an impact pulse for the
+	accelerometer, pointing away from the wall. The acceleration is
+	filtered like by the DLPF of the MPU6050 (first order).
+******************************************************************************/
+static void physics(void) {
+	const double dt = PHYSICS_PERIOD_US / 1000000.0;
+	uint8_t port_b = hal_host_gpio_levels(HAL_HOST_PORT_B);
+	uint8_t port_d = hal_host_gpio_levels(HAL_HOST_PORT_D);
+	int8_t left_gear = (port_d & L_CTRL_2 ? 1 : 0) - (port_d & L_CTRL_1 ? 1 : 0);
+	int8_t right_gear = (port_d & R_CTRL_1 ? 1 : 0) - (port_b & R_CTRL_2 ? 1 : 0);
+	double left_target = left_gear * hal_host_timer_duty(0, HAL_HOST_CHANNEL_B) / 255.0 * max_speed;
+	double right_target = right_gear * hal_host_timer_duty(0, HAL_HOST_CHANNEL_A) / 255.0 * max_speed;
+	double speed_before = (robot.left + robot.right) / 2;
+	double speed, turn, x, y, heading;
+	double nx, ny, into_wall, gap;
+	double forward, left, tau;
+	uint16_t bandwidth = DLPF_BANDWIDTH[hal_host_mpu6050_registers()[MPU6050_CONFIG] & 0x07];
+
+	robot.left += (left_target - robot.left) * dt / motor_tau;
+	robot.right += (right_target - robot.right) * dt / motor_tau;
+	speed = (robot.left + robot.right) / 2;
+	turn = (robot.right - robot.left) / TRACK_CM;
+
+	heading = robot.heading + turn * dt;
+	x = robot.x + speed * cos(heading) * dt;
+	y = robot.y + speed * sin(heading) * dt;
+
+	if (wall_distance(x, y, &nx, &ny) < BODY_RADIUS_CM) {
+		into_wall = -(speed * cos(heading) * nx + speed * sin(heading) * ny);
+		if (!robot.contact && into_wall > IMPACT_MIN_SPEED) {
+			robot.impact_x = nx * into_wall / impact_time;
+			robot.impact_y = ny * into_wall / impact_time;
+			robot.impact_until = hal_host_cycles() + (uint64_t)(impact_time * F_CPU);
+			metrics.impacts++;
+			if (metrics.impact_at && !metrics.impact_reported) {
+				metrics.missed_collisions++;
+			}
+			metrics.impact_at = now_ms();
+			metrics.impact_reported = 0;
+		}
+		robot.contact = 1;
+		robot.left = 0;
+		robot.right = 0;
+		speed = 0;
+		turn = 0;
+	} else {
+		robot.contact = 0;
+		robot.x = x;
+		robot.y = y;
+		robot.heading = heading;
+	}
+
+	forward = (speed - speed_before) / dt;
+	left = speed * turn;
+	if (hal_host_cycles() < robot.impact_until) {
+		forward += robot.impact_x * cos(robot.heading) + robot.impact_y * sin(robot.heading);
+		left += -robot.impact_x * sin(robot.heading) + robot.impact_y * cos(robot.heading);
+	}
+	tau = bandwidth ? 1 / (2 * M_PI * bandwidth) : 0;
+	robot.accel += (forward - robot.accel) * dt / (tau + dt);
+	robot.lateral += (left - robot.lateral) * dt / (tau + dt);
+	metrics.travelled += fabs(speed) * dt;
+
+	gap = wall_distance(robot.x, robot.y, &nx, &ny) - BODY_RADIUS_CM;
+	if (gap < metrics.min_clearance) {
+		metrics.min_clearance = gap;
+	}
+
+	//Obstacle ahead: from the wall coming within the warning distance to
+	//the warning, and from the warning to standstill
+	gap = cast_ray(robot.x + SONAR_OFFSET_CM * cos(robot.heading),
+				   robot.y + SONAR_OFFSET_CM * sin(robot.heading), robot.heading, 0);
+	if (speed > 0 && gap < WARNING_DISTANCE_CM && !metrics.approaching) {
+		metrics.approaching = 1;
+		metrics.warned = 0;
+		metrics.approach_at = now_ms();
+	} else if (gap >= WARNING_DISTANCE_CM + FALSE_MARGIN_CM) {
+		metrics.approaching = 0;
+	}
+	if (metrics.stopping && fabs(speed) < 0.5) {
+		metrics.stopping = 0;
+		if (isnan(metrics.stop_distance) || metrics.travelled - metrics.stop_from > metrics.stop_distance) {
+			metrics.stop_distance = metrics.travelled - metrics.stop_from;
+		}
+	}
+	if (metrics.impact_at && !metrics.impact_reported &&
+		now_ms() - metrics.impact_at > COLLISION_WINDOW_MS) {
+		metrics.missed_collisions++;
+		metrics.impact_at = 0;
+	}
+
+	hal_host_schedule(PHYSICS_PERIOD_US * CYCLES_PER_US, physics);
+}
+
+/******************************************************************************
+	Distance from a point to the nearest wall and the normal of that wall
+	towards the point.
+******************************************************************************/
+static double wall_distance(double x, double y, double *nx, double *ny) {
+	double nearest = INFINITY;
+	double dx, dy, length2, t, px, py, d;
+
+	*nx = 0;
+	*ny = 0;
+	for (uint8_t i = 0; i < wall_count; i++) {
+		dx = walls[i].x2 - walls[i].x1;
+		dy = walls[i].y2 - walls[i].y1;
+		length2 = dx * dx + dy * dy;
+		t = length2 ? ((x - walls[i].x1) * dx + (y - walls[i].y1) * dy) / length2 : 0;
+		t = t < 0 ? 0 : t > 1 ? 1 : t;
+		px = x - (walls[i].x1 + t * dx);
+		py = y - (walls[i].y1 + t * dy);
+		d = sqrt(px * px + py * py);
+		if (d < nearest) {
+			nearest = d;
+			*nx = d ? px / d : 0;
+			*ny = d ? py / d : 0;
+		}
+	}
+	return nearest;
+}
+
+/******************************************************************************
+	Distance along a ray to the nearest wall, INFINITY if none. With
+	reflecting set, walls hit flatter than SONAR_MAX_INCIDENCE are skipped.
+******************************************************************************/
+static double cast_ray(double x, double y, double angle, uint8_t reflecting) {
+	const double min_cos = cos(SONAR_MAX_INCIDENCE * M_PI / 180.0);
+	double rx = cos(angle);
+	double ry = sin(angle);
+	double nearest = INFINITY;
+	double dx, dy, denominator, t, s, length;
+
+	for (uint8_t i = 0; i < wall_count; i++) {
+		dx = walls[i].x2 - walls[i].x1;
+		dy = walls[i].y2 - walls[i].y1;
+		denominator = rx * dy - ry * dx;
+		if (denominator == 0) {
+			continue;	//parallel
+		}
+		t = ((walls[i].x1 - x) * dy - (walls[i].y1 - y) * dx) / denominator;
+		s = ((walls[i].x1 - x) * ry - (walls[i].y1 - y) * rx) / denominator;
+		if (t < 0 || s < 0 || s > 1 || t >= nearest) {
+			continue;
+		}
+		length = sqrt(dx * dx + dy * dy);
+		if (reflecting && fabs(denominator) / length < min_cos) {
+			continue;	//|cos| of the incidence angle
+		}
+		nearest = t;
+	}
+	return nearest;
+}
+
+/******************************************************************************
+	Nearest wall in the sound cone of the HC-SR04.
+******************************************************************************/
+static double cone_range(uint8_t reflecting) {
+	double x = robot.x + SONAR_OFFSET_CM * cos(robot.heading);
+	double y = robot.y + SONAR_OFFSET_CM * sin(robot.heading);
+	double nearest = INFINITY;
+	double angle, range;
+
+	for (uint8_t i = 0; i < SONAR_RAYS; i++) {
+		angle = robot.heading + (2.0 * i / (SONAR_RAYS - 1) - 1) * SONAR_HALF_ANGLE * M_PI / 180.0;
+		range = cast_ray(x, y, angle, reflecting);
+		if (range < nearest) {
+			nearest = range;
+		}
+	}
+	return nearest;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	HC-SR04
+	The echo of a trigger pulse starts at its falling edge, triggers during
+	an echo are ignored like by the sensor.
+******************************************************************************/
+static void gpio_changed(uint8_t port) {
+	uint8_t trig;
+	double range;
+
+	if (port != HAL_HOST_PORT_B) {
+		return;
+	}
+	trig = hal_host_gpio_levels(HAL_HOST_PORT_B) & SONAR_TRIG;
+	if (sonar.trig && !trig && !sonar.busy) {
+		range = cone_range(1);
+		sonar.echo_us = range <= SONAR_RANGE_CM ? range * SONAR_US_PER_CM : SONAR_NO_ECHO_US;
+		sonar.busy = 1;
+		hal_host_schedule(SONAR_ECHO_DELAY_US * CYCLES_PER_US, echo_rise);
+	}
+	sonar.trig = trig;
+}
+
+static void echo_rise(void) {
+	hal_host_gpio_drive(HAL_HOST_PORT_D, SONAR_ECHO, 1);
+	hal_host_schedule((uint64_t)sonar.echo_us * CYCLES_PER_US, echo_fall);
+}
+
+static void echo_fall(void) {
+	hal_host_gpio_drive(HAL_HOST_PORT_D, SONAR_ECHO, 0);
+	sonar.busy = 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	MPU6050
+	A sample every sample period once the firmware has enabled the data
+	ready interrupt: 1 kHz with the DLPF, else 8 kHz, divided by
+	1 + SMPLRT_DIV, the accelerometer gives at most 1 kHz.
+******************************************************************************/
+static void mpu6050_sample(void) {
+	uint8_t *registers = hal_host_mpu6050_registers();
+	uint8_t dlpf = registers[MPU6050_CONFIG] & 0x07;
+	uint32_t rate = (dlpf && dlpf != 7 ? 1000 : 8000) / (1 + registers[MPU6050_SMPLRT_DIV]);
+	double lsb_per_g = 16384 >> ((registers[MPU6050_ACCEL_CONFIG] >> 3) & 0x03);
+	int16_t raw[3];
+
+	if (rate > 1000) {
+		rate = 1000;
+	}
+	if (!(registers[MPU6050_INT_ENABLE] & 0x01)) {
+		hal_host_schedule(CYCLES_PER_MS, mpu6050_sample);
+		return;
+	}
+
+	raw[0] = accel_raw(MPU6050_X_BIAS, robot.accel, lsb_per_g);
+	raw[1] = accel_raw(MPU6050_Y_BIAS, robot.lateral, lsb_per_g);
+	raw[2] = accel_raw(MPU6050_Z_BIAS, 0, lsb_per_g);
+	for (uint8_t i = 0; i < 3; i++) {
+		registers[MPU6050_ACCEL_XOUT_H + 2 * i] = (uint16_t)raw[i] >> 8;
+		registers[MPU6050_ACCEL_XOUT_H + 2 * i + 1] = (uint16_t)raw[i] & 0xFF;
+	}
+
+	hal_host_gpio_drive(HAL_HOST_PORT_B, MPU6050_INT, 1);
+	hal_host_schedule(MPU6050_INT_PULSE_US * CYCLES_PER_US, mpu6050_int_end);
+	hal_host_schedule(F_CPU / rate, mpu6050_sample);
+}
+
+static void mpu6050_int_end(void) {
+	hal_host_gpio_drive(HAL_HOST_PORT_B, MPU6050_INT, 0);
+}
+
+static int16_t accel_raw(double bias, double acceleration, double lsb_per_g) {
+	double raw = bias + acceleration / GRAVITY_CM_S2 * lsb_per_g + noise();
+
+	return raw > INT16_MAX ? INT16_MAX : raw < INT16_MIN ? INT16_MIN : (int16_t)raw;
+}
+
+/******************************************************************************
+	Vibration, uniform in -vibration..vibration raw units (xorshift32).
+******************************************************************************/
+static double noise(void) {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return vibration * ((double)seed / UINT32_MAX * 2 - 1);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	REMOTE
+	Sends the left and the right motor byte of the latest drive command
+	every COMMAND_PERIOD_MS, and reads what the robot transmits.
+******************************************************************************/
+static void send_commands(void) {
+	int16_t left = 0;
+	int16_t right = 0;
+
+	for (uint8_t i = 0; i < command_count; i++) {
+		if (commands[i].at_ms <= now_ms()) {
+			left = commands[i].left;
+			right = commands[i].right;
+		}
+	}
+	//the gear of the link is shared, the left motor's decides
+	if ((left < 0) != (right < 0)) {
+		right = -right;
+	}
+	hal_host_usart_receive(command_byte(left, 1));
+	hal_host_usart_receive(command_byte(right, 0));
+	hal_host_schedule(COMMAND_PERIOD_MS * CYCLES_PER_MS, send_commands);
+}
+
+static uint8_t command_byte(int16_t pwm, uint8_t left) {
+	uint8_t byte = (abs(pwm) > 252 ? 252 : abs(pwm)) & 0b11111100;
+
+	if (pwm >= 0) {
+		byte |= 1 << GEAR_SEL_BIT;
+	}
+	if (left) {
+		byte |= 1 << MOTOR_SEL_BIT;
+	}
+	return byte;
+}
+
+static void robot_transmitted(uint8_t c) {
+	if (capture) {
+		putc(c, capture);
+	}
+	if (link_parse(&parser, c) != LINK_PARSE_IDLE) {
+		return;	//status message
+	}
+
+	switch (c) {
+		case '1':
+			metrics.collision_reports++;
+			if (metrics.impact_at && !metrics.impact_reported) {
+				metrics.impact_reported = 1;
+				if (isnan(metrics.collision_latency) ||
+					now_ms() - metrics.impact_at > metrics.collision_latency) {
+					metrics.collision_latency = now_ms() - metrics.impact_at;
+				}
+			} else {
+				metrics.false_collisions++;
+			}
+			hal_host_schedule((uint64_t)confirm_ms * CYCLES_PER_MS, confirm_collision);
+			break;
+		case '2':
+			metrics.warnings++;
+			if (cone_range(0) >= WARNING_DISTANCE_CM + FALSE_MARGIN_CM) {
+				metrics.false_warnings++;
+			}
+			if (metrics.approaching && !metrics.warned) {
+				metrics.warned = 1;
+				if (isnan(metrics.detect_latency) ||
+					now_ms() - metrics.approach_at > metrics.detect_latency) {
+					metrics.detect_latency = now_ms() - metrics.approach_at;
+				}
+			}
+			metrics.stopping = 1;
+			metrics.stop_from = metrics.travelled;
+			break;
+		case '3':
+			metrics.tip_overs++;
+			break;
+		default:
+			break;
+	}
+}
+
+static void confirm_collision(void) {
+	hal_host_usart_receive('1');
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	REPORT
+	Ends the run after the duration of the scenario.
+******************************************************************************/
+static void finish(void) {
+	const struct {
+		const char *name;
+		double value;
+	} table[] = {
+		{ "travelled_cm", metrics.travelled },
+		{ "min_clearance_cm", metrics.min_clearance },
+		{ "warnings", metrics.warnings },
+		{ "false_warnings", metrics.false_warnings },
+		{ "detect_latency_ms", metrics.detect_latency },
+		{ "stop_distance_cm", metrics.stop_distance },
+		{ "impacts", metrics.impacts },
+		{ "collision_reports", metrics.collision_reports },
+		{ "false_collisions", metrics.false_collisions },
+		{ "missed_collisions", metrics.missed_collisions + (metrics.impact_at && !metrics.impact_reported) },
+		{ "collision_latency_ms", metrics.collision_latency },
+		{ "tip_overs", metrics.tip_overs },
+	};
+	const uint8_t count = sizeof(table) / sizeof(table[0]);
+	uint8_t failed = 0;
+	uint8_t found;
+
+	printf("robotsim: %s, %lu ms simulated\n", scenario_path, (unsigned long)duration_ms);
+	for (uint8_t i = 0; i < count; i++) {
+		if (isnan(table[i].value) || isinf(table[i].value)) {
+			printf("  %-22s n/a\n", table[i].name);
+		} else {
+			printf("  %-22s %.1f\n", table[i].name, table[i].value);
+		}
+	}
+
+	for (uint8_t i = 0; i < expect_count; i++) {
+		found = 0;
+		for (uint8_t j = 0; j < count; j++) {
+			if (!strcmp(expects[i].metric, table[j].name)) {
+				found = 1;
+				if (!(table[j].value >= expects[i].min && table[j].value <= expects[i].max)) {
+					printf("FAIL: %s is outside %g..%g\n", expects[i].metric, expects[i].min, expects[i].max);
+					failed = 1;
+				}
+			}
+		}
+		if (!found) {
+			printf("FAIL: no metric %s\n", expects[i].metric);
+			failed = 1;
+		}
+	}
+	printf("%s\n", failed ? "FAILED" : "PASSED");
+	fflush(stdout);
+	exit(failed);
+}
+
+static uint32_t now_ms(void) {
+	return hal_host_cycles() / CYCLES_PER_MS;
+}
+/*****************************************************************************/
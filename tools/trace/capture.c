@@ -0,0 +1,99 @@
+/******************************************************************************
+	TRACE CAPTURE IMPLEMENTATION FILE
+
+	This file contains the trace capture reader of the host tools, see
+	capture.h.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "capture.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static void add_record(const trace_record_t *record);
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+//Capture being decoded, trace_decode() has no context for add_record()
+static capture_t *decoding;
+
+
+
+/******************************************************************************
+	Function name:	capture_byte()
+
+	This is a public function and is described in the header file,
+	capture.h.
+******************************************************************************/
+void capture_byte(capture_t *capture, uint8_t byte) {
+	if (link_parse(&capture->parser, byte) != LINK_PARSE_FRAME ||
+		capture->parser.type != LINK_TYPE_TRACE) {
+		return;
+	}
+
+	capture->messages++;
+	decoding = capture;
+	if (!trace_decode(&capture->decoder, capture->parser.payload, capture->parser.length,
+					  add_record)) {
+		capture->broken++;
+	}
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Function name:	capture_load()
+
+	This is a public function and is described in the header file,
+	capture.h.
+******************************************************************************/
+int capture_load(capture_t *capture, const char *path) {
+	FILE *file = strcmp(path, "-") ? fopen(path, "rb") : stdin;
+	int c;
+
+	if (!file) {
+		return -1;
+	}
+	while ((c = getc(file)) != EOF) {
+		capture_byte(capture, c);
+	}
+	if (file != stdin) {
+		fclose(file);
+	}
+	return 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	PRIVATE FUNCTIONS
+******************************************************************************/
+static void add_record(const trace_record_t *record) {
+	if (record->type == TRACE_TYPE_LOST) {
+		decoding->lost += record->byte;
+	}
+	if (decoding->count == decoding->capacity) {
+		decoding->capacity = decoding->capacity ? 2 * decoding->capacity : 1024;
+		decoding->records = realloc(decoding->records,
+									decoding->capacity * sizeof(trace_record_t));
+		if (!decoding->records) {
+			fprintf(stderr, "capture: out of memory\n");
+			exit(2);
+		}
+	}
+	decoding->records[decoding->count++] = *record;
+}
+/*****************************************************************************/
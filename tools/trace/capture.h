@@ -0,0 +1,67 @@
+/******************************************************************************
+	TRACE CAPTURE HEADER FILE
+
+	This file contains the interface of the trace capture reader of the
+	host tools. A capture is the raw byte stream transmitted by the Robot
+	built with TRACE_RECORDING (events, status and trace messages), e.g.
+	read from the serial port of a ZigBee module:
+
+		stty -F /dev/ttyUSB0 9600 raw && cat /dev/ttyUSB0 > drive.trace
+
+	The trace records of the capture are collected in the order they were
+	recorded, see Common/trace/trace.h.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+#include "../../Common/link/link.h"
+#include "../../Common/trace/trace.h"
+#include <stddef.h>
+
+
+
+/******************************************************************************
+	TYPES
+******************************************************************************/
+typedef struct {
+	link_parser_t parser;
+	trace_decoder_t decoder;
+	trace_record_t *records;
+	size_t count;
+	size_t capacity;
+	uint32_t messages;			//trace messages
+	uint32_t broken;			//trace messages that were not whole records
+	uint32_t lost;				//records lost by the Robot (TRACE_TYPE_LOST)
+} capture_t;
+
+
+
+/******************************************************************************
+	Function name:	capture_byte()
+
+	Feeds one byte of a capture.
+
+	Inputs:		capture_t *capture, zero initialized before first use
+				uint8_t byte
+	Outputs:	none
+******************************************************************************/
+void capture_byte(capture_t *capture, uint8_t byte);
+
+/******************************************************************************
+	Function name:	capture_load()
+
+	Reads a capture file, "-" is stdin.
+
+	Inputs:		capture_t *capture, zero initialized
+				const char *path
+	Outputs:	int, 0 if read, else -1 with errno set
+******************************************************************************/
+int capture_load(capture_t *capture, const char *path);
+
+
+
+#endif /* CAPTURE_H_ */
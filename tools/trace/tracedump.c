@@ -0,0 +1,83 @@
+/******************************************************************************
+	TRACE DUMP
+
+	Host tool that prints the trace records of a capture of the Robot (see
+	tools/trace/capture.h) as text, one record per line:
+
+		time_ms command byte
+		time_ms distance cm
+		time_ms accel x y z
+		time_ms motors left right	(PWM, negative in reverse)
+		time_ms event character
+		time_ms lost records
+
+	The number of trace messages and of broken and lost records is printed
+	on stderr. Two dumps can be compared with diff.
+
+	Usage:
+		tracedump [capture]			(stdin without a capture)
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "capture.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+
+
+/******************************************************************************
+	MAIN FUNCTION
+******************************************************************************/
+int main(int argc, char *argv[]) {
+	const char *path = argc > 1 ? argv[1] : "-";
+	capture_t capture = { 0 };
+
+	if (argc > 2) {
+		fprintf(stderr, "usage: %s [capture]\n", argv[0]);
+		return 2;
+	}
+	if (capture_load(&capture, path)) {
+		fprintf(stderr, "%s: %s: %s\n", argv[0], path, strerror(errno));
+		return 2;
+	}
+
+	for (size_t i = 0; i < capture.count; i++) {
+		const trace_record_t *record = &capture.records[i];
+
+		printf("%lu ", (unsigned long)record->time_ms);
+		switch (record->type) {
+			case TRACE_TYPE_COMMAND:
+				printf("command 0x%02X\n", record->byte);
+				break;
+			case TRACE_TYPE_DISTANCE:
+				printf("distance %u\n", record->distance_cm);
+				break;
+			case TRACE_TYPE_ACCEL:
+				printf("accel %d %d %d\n", record->accel[0], record->accel[1], record->accel[2]);
+				break;
+			case TRACE_TYPE_MOTORS:
+				printf("motors %d %d\n",
+					   record->flags & TRACE_MOTORS_LEFT_REVERSE ? -record->left_pwm : record->left_pwm,
+					   record->flags & TRACE_MOTORS_RIGHT_REVERSE ? -record->right_pwm : record->right_pwm);
+				break;
+			case TRACE_TYPE_EVENT:
+				printf("event %c\n", record->byte);
+				break;
+			case TRACE_TYPE_LOST:
+				printf("lost %u\n", record->byte);
+				break;
+			default:
+				printf("unknown %u\n", record->type);
+				break;
+		}
+	}
+
+	fprintf(stderr, "%lu messages, %lu broken, %lu records, %lu lost\n",
+			(unsigned long)capture.messages, (unsigned long)capture.broken,
+			(unsigned long)capture.count, (unsigned long)capture.lost);
+	return 0;
+}
+/*****************************************************************************/
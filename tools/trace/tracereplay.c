@@ -0,0 +1,428 @@
+/******************************************************************************
+	TRACE REPLAY
+
+	Replays a trace capture of the Robot (tools/trace/capture.h) into the
+	robot firmware on the simulated peripherals of the host backend
+	(Common/hal/hal_host.c), so that a change of the detection or the
+	control code can be compared on the data of a real drive. The
+	firmware is built with TRACE_RECORDING and records the replay like the
+	real drive was recorded. The inputs come from the recorded trace:
+		- Remote: every recorded command byte is received
+		  COMMAND_LEAD_MS before it was read, the firmware reads the
+		  received bytes once per loop.
+		- HC-SR04: the echo of a trigger is as long as the recorded
+		  distance DISTANCE_LEAD_MS later, when the firmware reads the
+		  distance of the trigger, no echo for a distance of 0.
+		- MPU6050: samples at the configured sample rate with a data ready
+		  pulse on PB2, each the latest recorded sample. The accelerometer
+		  is recorded at a lower rate (TRACE_ACCEL_DIVIDER), the samples in
+		  between are repeated.
+
+	The replay ends FINISH_MS after the last recorded record. The motor
+	speeds and the events of the replay are compared with the recorded
+	ones in order. The counts, the largest time offset of the matching
+	records and the first difference are printed, the exit status is 1 if
+	the replay differs from the recording.
+
+	Usage (the capture is given in the environment, since main() is the
+	firmware's):
+		TRACE_REPLAY=drive.trace [TRACE_REPLAY_OUTPUT=replay.trace] tracereplay
+
+	TRACE_REPLAY_OUTPUT saves the capture of the replay, e.g. for
+	tracedump.
+
+	Created: 2026-10-18
+	Author: Mattias Ahle, mattias.ahle@gmail.com
+******************************************************************************/
+
+#include "../../Common/hal/hal.h"
+#include "capture.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+/******************************************************************************
+	DEFINE
+******************************************************************************/
+#define CYCLES_PER_US (F_CPU / 1000000)
+#define CYCLES_PER_MS (F_CPU / 1000)
+
+//Inputs ahead of their recorded time, see above
+#define COMMAND_LEAD_MS 5
+#define DISTANCE_LEAD_MS 12
+
+//Simulated time after the last record, for the last outputs
+#define FINISH_MS 500
+
+//Replayed outputs up to this long after the last record are compared
+#define COMPARE_TAIL_MS 50
+
+//HC-SR04
+#define SONAR_TRIG (1 << PB1)
+#define SONAR_ECHO (1 << PD3)
+#define SONAR_ECHO_DELAY_US 460		//trigger to echo start
+#define SONAR_CM_PER_US 0.017		//of hc_sr04.c
+
+//MPU6050
+#define MPU6050_INT (1 << PB2)
+#define MPU6050_INT_PULSE_US 50
+#define MPU6050_SMPLRT_DIV 0x19
+#define MPU6050_CONFIG 0x1A
+#define MPU6050_INT_ENABLE 0x38
+#define MPU6050_ACCEL_XOUT_H 0x3B
+
+
+
+/******************************************************************************
+	FUNCTION PROTOTYPES
+******************************************************************************/
+static void start(void) __attribute__((constructor));
+
+static void feed_command(void);
+static void schedule_command(void);
+
+static void gpio_changed(uint8_t port);
+static void echo_rise(void);
+static void echo_fall(void);
+
+static void mpu6050_sample(void);
+static void mpu6050_int_end(void);
+
+static const trace_record_t *latest(uint8_t type, size_t *cursor, uint32_t ms);
+static void robot_transmitted(uint8_t c);
+static void finish(void);
+static uint8_t compare(uint8_t type, const char *name);
+static size_t next_output(const capture_t *capture, size_t from, uint8_t type,
+						  uint32_t until_ms);
+static uint8_t same_output(const trace_record_t *a, const trace_record_t *b);
+static void print_output(const trace_record_t *record);
+static uint32_t now_ms(void);
+
+
+
+/******************************************************************************
+	GLOBAL VARIABLES
+******************************************************************************/
+static capture_t recorded;
+static capture_t replayed;
+static FILE *output;
+static uint32_t last_ms;
+
+static size_t command_index = 0;
+static size_t distance_cursor = 0;
+static size_t accel_cursor = 0;
+
+static struct {
+	uint8_t trig;				//last trigger level
+	uint8_t busy;				//echo pending
+	uint32_t echo_us;
+} sonar;
+
+
+
+/******************************************************************************
+	SET-UP
+	Runs before the firmware's main(), like the simulation's start-up.
+******************************************************************************/
+static void start(void) {
+	const char *path = getenv("TRACE_REPLAY");
+	const char *output_path = getenv("TRACE_REPLAY_OUTPUT");
+
+	if (!path) {
+		fprintf(stderr, "tracereplay: set TRACE_REPLAY to a trace capture\n");
+		exit(2);
+	}
+	if (capture_load(&recorded, path)) {
+		fprintf(stderr, "tracereplay: %s: %s\n", path, strerror(errno));
+		exit(2);
+	}
+	if (!recorded.count) {
+		fprintf(stderr, "tracereplay: %s has no trace records\n", path);
+		exit(2);
+	}
+	if (recorded.lost || recorded.broken) {
+		fprintf(stderr, "tracereplay: %lu records lost and %lu messages broken in the "
+				"recording, the replay may differ\n",
+				(unsigned long)recorded.lost, (unsigned long)recorded.broken);
+	}
+	if (output_path && !(output = fopen(output_path, "wb"))) {
+		fprintf(stderr, "tracereplay: %s: %s\n", output_path, strerror(errno));
+		exit(2);
+	}
+	last_ms = recorded.records[recorded.count - 1].time_ms;
+
+	hal_host_gpio_set_hook(gpio_changed);
+	hal_host_usart_set_hook(robot_transmitted);
+	hal_host_schedule(CYCLES_PER_MS, mpu6050_sample);
+	schedule_command();
+	hal_host_schedule((uint64_t)(last_ms + FINISH_MS) * CYCLES_PER_MS, finish);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	REMOTE
+******************************************************************************/
+static void feed_command(void) {
+	hal_host_usart_receive(recorded.records[command_index++].byte);
+	schedule_command();
+}
+
+static void schedule_command(void) {
+	uint64_t at;
+
+	while (command_index < recorded.count &&
+		   recorded.records[command_index].type != TRACE_TYPE_COMMAND) {
+		command_index++;
+	}
+	if (command_index == recorded.count) {
+		return;
+	}
+
+	at = recorded.records[command_index].time_ms;
+	at = at > COMMAND_LEAD_MS ? (at - COMMAND_LEAD_MS) * CYCLES_PER_MS : 0;
+	hal_host_schedule(at > hal_host_cycles() ? at - hal_host_cycles() : 0, feed_command);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	HC-SR04
+	The echo of a trigger pulse starts at its falling edge, triggers during
+	an echo are ignored like by the sensor.
+******************************************************************************/
+static void gpio_changed(uint8_t port) {
+	const trace_record_t *distance;
+	uint8_t trig;
+
+	if (port != HAL_HOST_PORT_B) {
+		return;
+	}
+	trig = hal_host_gpio_levels(HAL_HOST_PORT_B) & SONAR_TRIG;
+	if (sonar.trig && !trig && !sonar.busy) {
+		distance = latest(TRACE_TYPE_DISTANCE, &distance_cursor, now_ms() + DISTANCE_LEAD_MS);
+		if (distance && distance->distance_cm) {
+			sonar.echo_us = (distance->distance_cm + 0.5) / SONAR_CM_PER_US;
+			sonar.busy = 1;
+			hal_host_schedule(SONAR_ECHO_DELAY_US * CYCLES_PER_US, echo_rise);
+		}
+	}
+	sonar.trig = trig;
+}
+
+static void echo_rise(void) {
+	hal_host_gpio_drive(HAL_HOST_PORT_D, SONAR_ECHO, 1);
+	hal_host_schedule((uint64_t)sonar.echo_us * CYCLES_PER_US, echo_fall);
+}
+
+static void echo_fall(void) {
+	hal_host_gpio_drive(HAL_HOST_PORT_D, SONAR_ECHO, 0);
+	sonar.busy = 0;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	MPU6050
+	A sample every sample period once the firmware has enabled the data
+	ready interrupt, like in tools/robotsim.
+******************************************************************************/
+static void mpu6050_sample(void) {
+	uint8_t *registers = hal_host_mpu6050_registers();
+	uint8_t dlpf = registers[MPU6050_CONFIG] & 0x07;
+	uint32_t rate = (dlpf && dlpf != 7 ? 1000 : 8000) / (1 + registers[MPU6050_SMPLRT_DIV]);
+	const trace_record_t *accel = latest(TRACE_TYPE_ACCEL, &accel_cursor, now_ms());
+
+	if (rate > 1000) {
+		rate = 1000;
+	}
+	if (!(registers[MPU6050_INT_ENABLE] & 0x01) || !accel) {
+		hal_host_schedule(CYCLES_PER_MS, mpu6050_sample);
+		return;
+	}
+
+	for (uint8_t i = 0; i < 3; i++) {
+		registers[MPU6050_ACCEL_XOUT_H + 2 * i] = (uint16_t)accel->accel[i] >> 8;
+		registers[MPU6050_ACCEL_XOUT_H + 2 * i + 1] = (uint16_t)accel->accel[i] & 0xFF;
+	}
+
+	hal_host_gpio_drive(HAL_HOST_PORT_B, MPU6050_INT, 1);
+	hal_host_schedule(MPU6050_INT_PULSE_US * CYCLES_PER_US, mpu6050_int_end);
+	hal_host_schedule(F_CPU / rate, mpu6050_sample);
+}
+
+static void mpu6050_int_end(void) {
+	hal_host_gpio_drive(HAL_HOST_PORT_B, MPU6050_INT, 0);
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	Returns the latest recorded record of a type at ms, or the first one
+	before it was recorded, NULL if there is none. The cursor keeps the
+	position of the search, ms must not go back.
+******************************************************************************/
+static const trace_record_t *latest(uint8_t type, size_t *cursor, uint32_t ms) {
+	const trace_record_t *found = NULL;
+	size_t i;
+
+	for (i = *cursor; i < recorded.count; i++) {
+		if (recorded.records[i].type != type) {
+			continue;
+		}
+		if (found && recorded.records[i].time_ms > ms) {
+			break;
+		}
+		found = &recorded.records[i];
+		*cursor = i;
+	}
+	return found;
+}
+/*****************************************************************************/
+
+
+
+/******************************************************************************
+	RESULTS
+******************************************************************************/
+static void robot_transmitted(uint8_t c) {
+	capture_byte(&replayed, c);
+	if (output) {
+		putc(c, output);
+	}
+}
+
+static void finish(void) {
+	uint8_t differs = 0;
+
+	if (output) {
+		fclose(output);
+	}
+
+	printf("recorded %lu records up to %lu ms, replayed %lu records\n",
+		   (unsigned long)recorded.count, (unsigned long)last_ms,
+		   (unsigned long)replayed.count);
+	differs |= compare(TRACE_TYPE_MOTORS, "motors");
+	differs |= compare(TRACE_TYPE_EVENT, "events");
+	printf(differs ? "replay differs from the recording\n" : "replay matches the recording\n");
+
+	exit(differs);
+}
+
+/******************************************************************************
+	Compares the recorded and the replayed records of a type in order.
+	Motor records repeated after lost records are skipped. Returns 1 if
+	they differ.
+******************************************************************************/
+static uint8_t compare(uint8_t type, const char *name) {
+	uint32_t until_ms = last_ms + COMPARE_TAIL_MS;
+	size_t r = next_output(&recorded, 0, type, until_ms);
+	size_t p = next_output(&replayed, 0, type, until_ms);
+	uint32_t recorded_count = 0;
+	uint32_t replayed_count = 0;
+	uint32_t matched = 0;
+	uint32_t max_offset = 0;
+	const trace_record_t *first_recorded = NULL;
+	const trace_record_t *first_replayed = NULL;
+
+	for (size_t i = r; i < recorded.count; i = next_output(&recorded, i + 1, type, until_ms)) {
+		recorded_count++;
+	}
+	for (size_t i = p; i < replayed.count; i = next_output(&replayed, i + 1, type, until_ms)) {
+		replayed_count++;
+	}
+
+	while (r < recorded.count && p < replayed.count) {
+		uint32_t offset;
+
+		if (!same_output(&recorded.records[r], &replayed.records[p])) {
+			first_recorded = &recorded.records[r];
+			first_replayed = &replayed.records[p];
+			break;
+		}
+		offset = recorded.records[r].time_ms > replayed.records[p].time_ms ?
+				 recorded.records[r].time_ms - replayed.records[p].time_ms :
+				 replayed.records[p].time_ms - recorded.records[r].time_ms;
+		if (offset > max_offset) {
+			max_offset = offset;
+		}
+		matched++;
+		r = next_output(&recorded, r + 1, type, until_ms);
+		p = next_output(&replayed, p + 1, type, until_ms);
+	}
+
+	printf("%s: recorded %lu, replayed %lu, matching %lu, largest offset %lu ms\n", name,
+		   (unsigned long)recorded_count, (unsigned long)replayed_count,
+		   (unsigned long)matched, (unsigned long)max_offset);
+	if (first_recorded) {
+		printf("  first difference: recorded ");
+		print_output(first_recorded);
+		printf(", replayed ");
+		print_output(first_replayed);
+		printf("\n");
+	}
+
+	return first_recorded || recorded_count != replayed_count;
+}
+
+/******************************************************************************
+	Returns the index of the first output of a type from index from on up
+	to until_ms, or the count of records if there is none.
+******************************************************************************/
+static size_t next_output(const capture_t *capture, size_t from, uint8_t type,
+						  uint32_t until_ms) {
+	const trace_record_t *previous = NULL;
+
+	for (size_t i = from; i-- > 0 && !previous; ) {
+		if (capture->records[i].type == type) {
+			previous = &capture->records[i];
+		}
+	}
+
+	for (size_t i = from; i < capture->count; i++) {
+		const trace_record_t *record = &capture->records[i];
+
+		if (record->time_ms > until_ms) {
+			break;
+		}
+		if (record->type != type) {
+			continue;
+		}
+		if (type != TRACE_TYPE_MOTORS || !previous || !same_output(record, previous)) {
+			return i;
+		}
+		previous = record;
+	}
+	return capture->count;
+}
+
+static uint8_t same_output(const trace_record_t *a, const trace_record_t *b) {
+	if (a->type == TRACE_TYPE_MOTORS) {
+		return a->left_pwm == b->left_pwm && a->right_pwm == b->right_pwm &&
+			   a->flags == b->flags;
+	}
+	return a->byte == b->byte;
+}
+
+static void print_output(const trace_record_t *record) {
+	if (record->type == TRACE_TYPE_MOTORS) {
+		printf("%d %d at %lu ms",
+			   record->flags & TRACE_MOTORS_LEFT_REVERSE ? -record->left_pwm : record->left_pwm,
+			   record->flags & TRACE_MOTORS_RIGHT_REVERSE ? -record->right_pwm : record->right_pwm,
+			   (unsigned long)record->time_ms);
+	} else {
+		printf("'%c' at %lu ms", record->byte, (unsigned long)record->time_ms);
+	}
+}
+
+static uint32_t now_ms(void) {
+	return hal_host_cycles() / CYCLES_PER_MS;
+}
+/*****************************************************************************/